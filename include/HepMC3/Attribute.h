@@ -25,6 +25,8 @@
 #include <sstream>
 #include <iomanip>
 #include <map>
+#include <memory>
+#include <typeinfo>
 
 #include "HepMC3/GenParticle_fwd.h"
 #include "HepMC3/GenVertex_fwd.h"
@@ -94,6 +96,42 @@ public:
     /** @brief Fill string from class content */
     virtual bool to_string(std::string &att) const = 0;
 
+    /** @brief Make an independent copy of this attribute
+     *
+     *  Used by GenEvent::clone to copy attributes without converting
+     *  them to strings. The default implementation returns an empty
+     *  pointer, in which case the attribute is copied via to_string.
+     */
+    virtual std::shared_ptr<Attribute> clone() const {
+        return std::shared_ptr<Attribute>();
+    }
+
+    /** @brief Tag of the binary representation
+     *
+     *  Identifies the layout written by to_bytes. Attributes with
+     *  an empty tag (the default) are always stored as strings.
+     */
+    virtual std::string type_tag() const {
+        return std::string();
+    }
+
+    /** @brief Fill binary buffer from class content
+     *
+     *  Used by the binary output formats instead of to_string.
+     *  The default implementation returns false, in which case
+     *  the attribute is stored as a string.
+     */
+    virtual bool to_bytes(std::string &bytes) const {
+        (void)bytes;
+        return false;
+    }
+
+    /** @brief Fill class content from binary buffer written by to_bytes */
+    virtual bool from_bytes(const std::string &bytes) {
+        (void)bytes;
+        return false;
+    }
+
 //
 // Accessors
 //
@@ -130,6 +168,28 @@ public:
     }
 
 protected:
+    /** @brief Copy of this attribute if its dynamic type is exactly T
+     *
+     *  Returns an empty pointer for derived classes, so that they are
+     *  not sliced when they do not implement clone themselves.
+     */
+    template <class T>
+    std::shared_ptr<Attribute> clone_exact() const {
+        if ( typeid(*this) != typeid(T) ) return std::shared_ptr<Attribute>();
+        return std::make_shared<T>(static_cast<const T&>(*this));
+    }
+
+    /** @brief Tag @a tag if the dynamic type of this attribute is exactly T
+     *
+     *  Returns an empty tag for derived classes, so that they are
+     *  stored as strings when they do not implement to_bytes themselves.
+     */
+    template <class T>
+    std::string type_tag_exact(const char* tag) const {
+        if ( typeid(*this) != typeid(T) ) return std::string();
+        return tag;
+    }
+
     /** @brief Set is_parsed flag */
     void set_is_parsed(bool flag) { m_is_parsed = flag; }
 
@@ -176,6 +236,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<IntAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<IntAttribute>("IntAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     int value() const {
         return m_val;
@@ -219,6 +291,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<LongAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<LongAttribute>("LongAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     long value() const {
         return m_val;
@@ -267,6 +351,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<DoubleAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<DoubleAttribute>("DoubleAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     double value() const {
         return m_val;
@@ -314,6 +410,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<FloatAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<FloatAttribute>("FloatAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     float value() const {
         return m_val;
@@ -366,6 +474,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<StringAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<StringAttribute>("StringAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::string value() const {
         return unparsed_string();
@@ -410,6 +530,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<CharAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<CharAttribute>("CharAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     char value() const {
         return m_val;
@@ -453,6 +585,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<LongLongAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<LongLongAttribute>("LongLongAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     long long value() const {
         return m_val;
@@ -501,6 +645,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<LongDoubleAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<LongDoubleAttribute>("LongDoubleAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     long double value() const {
         return m_val;
@@ -547,6 +703,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<UIntAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<UIntAttribute>("UIntAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     unsigned int value() const {
         return m_val;
@@ -592,6 +760,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<ULongAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<ULongAttribute>("ULongAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     unsigned long value() const {
         return m_val;
@@ -636,6 +816,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<ULongLongAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<ULongLongAttribute>("ULongLongAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     unsigned long long value() const {
         return m_val;
@@ -681,6 +873,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<BoolAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<BoolAttribute>("BoolAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     bool value() const {
         return m_val;
@@ -728,6 +932,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorCharAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorCharAttribute>("VectorCharAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<char> value() const {
         return m_val;
@@ -776,6 +992,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorFloatAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorFloatAttribute>("VectorFloatAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<float> value() const {
         return m_val;
@@ -824,6 +1052,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorLongDoubleAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorLongDoubleAttribute>("VectorLongDoubleAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<long double> value() const {
         return m_val;
@@ -873,6 +1113,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorLongLongAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorLongLongAttribute>("VectorLongLongAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<long long> value() const {
         return m_val;
@@ -920,6 +1172,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorUIntAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorUIntAttribute>("VectorUIntAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<unsigned int> value() const {
         return m_val;
@@ -967,6 +1231,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorULongAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorULongAttribute>("VectorULongAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<unsigned long> value() const {
         return m_val;
@@ -1015,6 +1291,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorULongLongAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorULongLongAttribute>("VectorULongLongAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<unsigned long long> value() const {
         return m_val;
@@ -1062,6 +1350,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorIntAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorIntAttribute>("VectorIntAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<int> value() const {
         return m_val;
@@ -1110,6 +1410,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorLongIntAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorLongIntAttribute>("VectorLongIntAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<long int> value() const {
         return m_val;
@@ -1157,6 +1469,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorDoubleAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorDoubleAttribute>("VectorDoubleAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<double> value() const {
         return m_val;
@@ -1207,6 +1531,18 @@ public:
         return true;
     }
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<VectorStringAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<VectorStringAttribute>("VectorStringAttribute"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief get the value associated to this Attribute. */
     std::vector<std::string> value() const {
         return m_val;
@@ -1223,6 +1559,66 @@ private:
 };
 
 
+/**
+ *  @class HepMC3::BinaryAttribute
+ *  @brief Attribute that holds the binary representation of another attribute
+ *
+ *  Made when reading the binary attribute section of GenEventData.
+ *  Like an unparsed StringAttribute, it is converted to the requested
+ *  attribute type on first access. The conversion uses from_bytes if
+ *  the type tags match and the string representation otherwise.
+ *
+ *  @ingroup attributes
+ *
+ */
+class BinaryAttribute : public Attribute {
+public:
+
+    /** @brief Default constructor */
+    BinaryAttribute(): Attribute(std::string()) {}
+
+    /** @brief Constructor from type tag and binary content */
+    BinaryAttribute(const std::string &tag, const std::string &bytes): Attribute(std::string()), m_tag(tag), m_bytes(bytes) {}
+
+    /** @brief Implementation of Attribute::from_string
+     *
+     *  Works only for the tags of built-in attribute classes.
+     */
+    bool from_string(const std::string &att) override;
+
+    /** @brief Implementation of Attribute::to_string
+     *
+     *  Works only for the tags of built-in attribute classes.
+     */
+    bool to_string(std::string &att) const override;
+
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override { return clone_exact<BinaryAttribute>(); }
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return m_tag; }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override { bytes = m_bytes; return true; }
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override { m_bytes = bytes; return true; }
+
+    /** @brief Fill @a att from the stored content */
+    bool parse(Attribute &att) const;
+
+    /** @brief Default constructed built-in attribute with type tag @a tag
+     *
+     *  Returns an empty pointer if the tag is not known.
+     */
+    static std::shared_ptr<Attribute> make(const std::string &tag);
+
+private:
+    std::string m_tag;   ///< Type tag of the content
+    std::string m_bytes; ///< Binary content
+};
+
+
 } // namespace HepMC3
 
 #endif
@@ -0,0 +1,212 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_ATTRIBUTEBYTES_H
+#define HEPMC3_ATTRIBUTEBYTES_H
+///
+/// @file  AttributeBytes.h
+/// @brief Definition of \b class ByteWriter and \b class ByteReader
+///
+/// @class HepMC3::ByteWriter
+/// @brief Encoder for the binary representation of attributes
+///
+/// Values are written in little-endian byte order with fixed widths:
+/// 1 byte for char and bool, 4 bytes for int, unsigned int and float,
+/// 8 bytes for long, long long, their unsigned versions and double.
+/// A long double is written as the sum of two doubles. Strings, vectors
+/// and maps are prefixed with their size as 4-byte unsigned integer.
+/// The encoding does not depend on the platform.
+///
+/// @class HepMC3::ByteReader
+/// @brief Decoder for the binary representation of attributes
+///
+/// A failed read leaves the reader in failed state, which is sticky:
+/// @code
+///     ByteReader in(bytes);
+///     in >> m_a >> m_b;
+///     return in.done();
+/// @endcode
+///
+/// @ingroup attributes
+///
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace HepMC3 {
+
+class ByteWriter {
+public:
+    /// @brief Constructor, clears @a bytes
+    explicit ByteWriter(std::string& bytes): m_bytes(bytes) { m_bytes.clear(); }
+
+    /// @name Encoding of values
+    /// @{
+    ByteWriter& operator<<(const char& v)               { return put<uint8_t>(uint8_t(v)); }          ///< char
+    ByteWriter& operator<<(const bool& v)               { return put<uint8_t>(v ? 1 : 0); }           ///< bool
+    ByteWriter& operator<<(const int& v)                { return put<uint32_t>(uint32_t(v)); }        ///< int
+    ByteWriter& operator<<(const unsigned int& v)       { return put<uint32_t>(uint32_t(v)); }        ///< unsigned int
+    ByteWriter& operator<<(const long& v)               { return put<uint64_t>(uint64_t(v)); }        ///< long
+    ByteWriter& operator<<(const unsigned long& v)      { return put<uint64_t>(uint64_t(v)); }        ///< unsigned long
+    ByteWriter& operator<<(const long long& v)          { return put<uint64_t>(uint64_t(v)); }        ///< long long
+    ByteWriter& operator<<(const unsigned long long& v) { return put<uint64_t>(uint64_t(v)); }        ///< unsigned long long
+
+    /// @brief float
+    ByteWriter& operator<<(const float& v) {
+        uint32_t u;
+        std::memcpy(&u, &v, sizeof(u));
+        return put<uint32_t>(u);
+    }
+
+    /// @brief double
+    ByteWriter& operator<<(const double& v) {
+        uint64_t u;
+        std::memcpy(&u, &v, sizeof(u));
+        return put<uint64_t>(u);
+    }
+
+    /// @brief long double, as leading double and remainder
+    ByteWriter& operator<<(const long double& v) {
+        const double hi = double(v);
+        const double lo = double(v - hi);
+        return *this << hi << lo;
+    }
+
+    /// @brief string
+    ByteWriter& operator<<(const std::string& v) {
+        put<uint32_t>(uint32_t(v.size()));
+        m_bytes.append(v);
+        return *this;
+    }
+
+    /// @brief vector
+    template <class T>
+    ByteWriter& operator<<(const std::vector<T>& v) {
+        put<uint32_t>(uint32_t(v.size()));
+        for (const T& x: v) *this << x;
+        return *this;
+    }
+
+    /// @brief map
+    template <class K, class V>
+    ByteWriter& operator<<(const std::map<K, V>& v) {
+        put<uint32_t>(uint32_t(v.size()));
+        for (const auto& x: v) *this << x.first << x.second;
+        return *this;
+    }
+    /// @}
+
+private:
+    /// @brief Append @a v in little-endian order
+    template <class U>
+    ByteWriter& put(const U& v) {
+        for (size_t i = 0; i < sizeof(U); ++i) m_bytes.push_back(char((v >> (8*i)) & 0xff));
+        return *this;
+    }
+
+    std::string& m_bytes; ///< Output buffer
+};
+
+class ByteReader {
+public:
+    /// @brief Constructor
+    explicit ByteReader(const std::string& bytes): m_bytes(bytes), m_pos(0), m_ok(true) {}
+
+    /// @brief True if no read has failed so far
+    bool ok() const { return m_ok; }
+
+    /// @brief True if all reads succeeded and the whole buffer was consumed
+    bool done() const { return m_ok && m_pos == m_bytes.size(); }
+
+    /// @name Decoding of values
+    /// @{
+    ByteReader& operator>>(char& v)               { uint8_t u = 0;  get(u); v = char(u);  return *this; }           ///< char
+    ByteReader& operator>>(bool& v)               { uint8_t u = 0;  get(u); v = (u != 0); return *this; }           ///< bool
+    ByteReader& operator>>(int& v)                { uint32_t u = 0; get(u); v = int32_t(u); return *this; }         ///< int
+    ByteReader& operator>>(unsigned int& v)       { uint32_t u = 0; get(u); v = u; return *this; }                  ///< unsigned int
+    ByteReader& operator>>(long& v)               { uint64_t u = 0; get(u); v = long(int64_t(u)); return *this; }   ///< long
+    ByteReader& operator>>(unsigned long& v)      { uint64_t u = 0; get(u); v = (unsigned long)u; return *this; }   ///< unsigned long
+    ByteReader& operator>>(long long& v)          { uint64_t u = 0; get(u); v = int64_t(u); return *this; }         ///< long long
+    ByteReader& operator>>(unsigned long long& v) { uint64_t u = 0; get(u); v = u; return *this; }                  ///< unsigned long long
+
+    /// @brief float
+    ByteReader& operator>>(float& v) {
+        uint32_t u = 0;
+        if ( get(u) ) std::memcpy(&v, &u, sizeof(u));
+        return *this;
+    }
+
+    /// @brief double
+    ByteReader& operator>>(double& v) {
+        uint64_t u = 0;
+        if ( get(u) ) std::memcpy(&v, &u, sizeof(u));
+        return *this;
+    }
+
+    /// @brief long double, as leading double and remainder
+    ByteReader& operator>>(long double& v) {
+        double hi = 0.0, lo = 0.0;
+        if ( (*this >> hi >> lo).ok() ) v = (long double)hi + lo;
+        return *this;
+    }
+
+    /// @brief string
+    ByteReader& operator>>(std::string& v) {
+        uint32_t n = 0;
+        if ( !get(n) || n > m_bytes.size() - m_pos ) { m_ok = false; return *this; }
+        v.assign(m_bytes, m_pos, n);
+        m_pos += n;
+        return *this;
+    }
+
+    /// @brief vector
+    template <class T>
+    ByteReader& operator>>(std::vector<T>& v) {
+        uint32_t n = 0;
+        v.clear();
+        // Every element takes at least one byte
+        if ( !get(n) || n > m_bytes.size() - m_pos ) { m_ok = false; return *this; }
+        v.resize(n);
+        for (T& x: v) *this >> x;
+        return *this;
+    }
+
+    /// @brief map
+    template <class K, class V>
+    ByteReader& operator>>(std::map<K, V>& v) {
+        uint32_t n = 0;
+        v.clear();
+        if ( !get(n) || n > m_bytes.size() - m_pos ) { m_ok = false; return *this; }
+        for (uint32_t i = 0; i < n && m_ok; ++i) {
+            K k{};
+            V x{};
+            *this >> k >> x;
+            v[k] = x;
+        }
+        return *this;
+    }
+    /// @}
+
+private:
+    /// @brief Read a little-endian value of type U
+    template <class U>
+    bool get(U& v) {
+        if ( !m_ok || sizeof(U) > m_bytes.size() - m_pos ) { m_ok = false; return false; }
+        v = 0;
+        for (size_t i = 0; i < sizeof(U); ++i) v |= U(U((unsigned char)m_bytes[m_pos + i]) << (8*i));
+        m_pos += sizeof(U);
+        return true;
+    }
+
+    const std::string& m_bytes; ///< Input buffer
+    size_t m_pos;               ///< Read position
+    bool m_ok;                  ///< No read has failed
+};
+
+} // namespace HepMC3
+
+#endif
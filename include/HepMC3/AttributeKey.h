@@ -0,0 +1,72 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_ATTRIBUTEKEY_H
+#define HEPMC3_ATTRIBUTEKEY_H
+///
+/// @file  AttributeKey.h
+/// @brief Definition of \b class AttributeRegistry and \b class AttributeKey
+///
+/// @class HepMC3::AttributeRegistry
+/// @brief Global table of interned attribute names
+///
+/// Every attribute name used in the program is given a small integer key.
+/// The keys and the name strings stay valid until the end of the program.
+///
+/// @class HepMC3::AttributeKey
+/// @brief Precompiled handle for an attribute of type T
+///
+/// A key is meant to be created once, e.g. as a static variable, and then
+/// used for repeated attribute access:
+/// @code
+///     static const AttributeKey<DoubleAttribute> theta("theta");
+///     for (ConstGenParticlePtr p: evt.particles()) {
+///         std::shared_ptr<DoubleAttribute> a = p->attribute(theta);
+///     }
+/// @endcode
+/// Lookups with a key avoid the string comparisons of the name-based access.
+///
+/// @ingroup attributes
+///
+#include <string>
+
+namespace HepMC3 {
+
+class AttributeRegistry {
+public:
+    /// @brief Key of the attribute name @a name, registered if needed
+    static int key(const std::string& name);
+
+    /// @brief Name of the attribute with key @a key
+    static const std::string& name(const int& key);
+
+    /// @brief Number of registered names
+    static int size();
+};
+
+template <class T>
+class AttributeKey {
+public:
+    /// @brief Attribute type
+    typedef T attribute_type;
+
+    /// @brief Constructor, registers @a name
+    explicit AttributeKey(const std::string& name):
+        m_key(AttributeRegistry::key(name)), m_name(&AttributeRegistry::name(m_key)) {}
+
+    /// @brief Interned key of the name
+    int key() const { return m_key; }
+
+    /// @brief Attribute name
+    const std::string& name() const { return *m_name; }
+
+private:
+    int m_key;                 ///< Interned key
+    const std::string* m_name; ///< Name, owned by the registry
+};
+
+} // namespace HepMC3
+
+#endif
@@ -0,0 +1,92 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_DATA_COMPACTEVENTDATA_H
+#define HEPMC3_DATA_COMPACTEVENTDATA_H
+/**
+ *  @file CompactEventData.h
+ *  @brief Definition of \b struct CompactEventData
+ *
+ *  @struct HepMC3::CompactParticleData
+ *  @brief Particle information in single precision, with the indices of its vertices
+ *
+ *  @struct HepMC3::CompactVertexData
+ *  @brief Vertex information in single precision
+ *
+ *  @struct HepMC3::CompactEventData
+ *  @brief Event information in single precision, for holding many events in memory
+ *
+ *  Filled by GenEvent::write_data and read back by GenEvent::read_data.
+ *  Momenta, masses and vertex positions are stored as float and the
+ *  particle/vertex links as two vertex indices per particle, so that a
+ *  particle takes 36 bytes and a vertex 20 bytes. This is meant e.g. for
+ *  libraries of minimum-bias events used for pileup overlay, where single
+ *  precision is sufficient. Weights and the event position are kept in
+ *  double precision.
+ *
+ *  Vertices are referred to by their position in GenEvent::vertices(),
+ *  i.e. by -id-1, with -1 meaning "no vertex" (or the root vertex). When
+ *  the event is read back, the particles of each vertex are attached in
+ *  the order of the particles in the event.
+ *
+ *  @ingroup data
+ *
+ */
+#include <cmath>
+#include <string>
+#include <vector>
+#include "HepMC3/FourVector.h"
+#include "HepMC3/Units.h"
+
+namespace HepMC3 {
+
+struct CompactParticleData {
+    int   pid;               ///< PDG ID
+    int   status;            ///< Status
+    float px;                ///< Momentum x component
+    float py;                ///< Momentum y component
+    float pz;                ///< Momentum z component
+    float e;                 ///< Energy
+    float mass;              ///< Generated mass, NaN if not set
+    int   production_vertex; ///< Index of the production vertex, -1 if none
+    int   end_vertex;        ///< Index of the end vertex, -1 if none
+
+    /// @brief Momentum in double precision
+    FourVector momentum() const { return FourVector(px, py, pz, e); }
+
+    /// @brief Check if the generated mass is set
+    bool is_mass_set() const { return !std::isnan(mass); }
+};
+
+struct CompactVertexData {
+    int   status; ///< Vertex status
+    float x;      ///< Position x component
+    float y;      ///< Position y component
+    float z;      ///< Position z component
+    float t;      ///< Time
+
+    /// @brief Position in double precision
+    FourVector position() const { return FourVector(x, y, z, t); }
+};
+
+struct CompactEventData {
+    int                 event_number;  ///< Event number
+    Units::MomentumUnit momentum_unit; ///< Momentum unit
+    Units::LengthUnit   length_unit;   ///< Length unit
+
+    std::vector<CompactParticleData> particles; ///< Particles
+    std::vector<CompactVertexData>   vertices;  ///< Vertices
+    std::vector<double>              weights;   ///< Weights
+
+    FourVector event_pos;                       ///< Event position
+
+    std::vector<int>         attribute_id;     ///< Attribute owner id
+    std::vector<std::string> attribute_name;   ///< Attribute name
+    std::vector<std::string> attribute_string; ///< Attribute serialized as string
+};
+
+} // namespace HepMC
+
+#endif
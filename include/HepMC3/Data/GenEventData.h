@@ -54,6 +54,17 @@ struct GenEventData {
     std::vector<int>         attribute_id;     ///< Attribute owner id
     std::vector<std::string> attribute_name;   ///< Attribute name
     std::vector<std::string> attribute_string; ///< Attribute serialized as string
+
+    /** @brief Owner id of the attributes stored in binary form
+     *
+     *  Filled by GenEvent::write_data only if requested. The binary
+     *  content is written by Attribute::to_bytes and is identified by
+     *  the type tag of the attribute.
+     */
+    std::vector<int>         attribute_binary_id;
+    std::vector<std::string> attribute_binary_name;  ///< Name of the binary attributes
+    std::vector<std::string> attribute_binary_type;  ///< Type tag of the binary attributes
+    std::vector<std::string> attribute_binary_bytes; ///< Binary content of the attributes
 };
 
 } // namespace HepMC
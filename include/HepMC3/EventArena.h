@@ -0,0 +1,136 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_EVENTARENA_H
+#define HEPMC3_EVENTARENA_H
+///
+/// @file  EventArena.h
+/// @brief Definition of \b class EventArena and \b class ArenaAllocator
+///
+/// @class HepMC3::EventArena
+/// @brief Monotonic memory pool for the objects of a single GenEvent
+///
+/// The arena hands out memory from large blocks by bumping a cursor.
+/// Deallocation is a no-op, and the whole arena is rewound in O(1) by
+/// EventArena::reset(), keeping the blocks for the next event.
+///
+/// The arena is shared by GenEvent and by the control blocks of all
+/// objects allocated through ArenaAllocator, so the memory stays valid
+/// for as long as any GenParticlePtr/GenVertexPtr created from it is alive.
+/// The arena counts these allocations, and GenEvent::clear() only rewinds
+/// it when none of them is left, otherwise it switches to a fresh arena.
+///
+/// @note The arena is not thread-safe: an event should be filled by one thread.
+///
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace HepMC3 {
+
+class EventArena {
+public:
+
+    /// @brief Constructor
+    ///
+    /// @param block_size Size in bytes of the memory blocks requested from the system.
+    explicit EventArena(const size_t& block_size = 65536);
+
+    /// @brief Destructor, releases all blocks
+    ~EventArena();
+
+    /// @brief Deleted copy constructor
+    EventArena(const EventArena&) = delete;
+    /// @brief Deleted copy assignment operator
+    EventArena& operator=(const EventArena&) = delete;
+
+    /// @brief Get @a bytes of memory aligned to @a alignment
+    void* allocate(const size_t& bytes, const size_t& alignment);
+
+    /// @brief Mark one allocation as released, the memory is not reused before reset
+    void release() { m_live.fetch_sub(1, std::memory_order_relaxed); }
+
+    /// @brief Number of allocations not released yet
+    size_t live() const { return m_live.load(std::memory_order_relaxed); }
+
+    /// @brief Rewind the arena to the first block
+    ///
+    /// All blocks are kept for reuse. The caller must make sure that
+    /// no object allocated from the arena is alive.
+    void reset();
+
+    /// @brief Size of the memory blocks
+    size_t block_size() const { return m_block_size; }
+
+    /// @brief Total memory held by the arena in bytes
+    size_t capacity() const;
+
+    /// @brief Memory handed out since the last reset in bytes
+    size_t used() const;
+
+private:
+
+    /// @brief A chunk of memory obtained from the system
+    struct Block {
+        char*  data; ///< Start of the block
+        size_t size; ///< Size of the block
+    };
+
+    /// @brief Move to the next block able to hold @a bytes, allocating it if needed
+    void next_block(const size_t& bytes);
+
+    size_t m_block_size;         ///< Default block size
+    std::vector<Block> m_blocks; ///< All blocks
+    size_t m_current;            ///< Index of the block in use
+    size_t m_used_before;        ///< Bytes handed out from the blocks before the current one
+    char*  m_cursor;             ///< Next free byte in the current block
+    char*  m_end;                ///< End of the current block
+    std::atomic<size_t> m_live;  ///< Allocations not released yet
+};
+
+/// @brief Standard allocator handing out memory from an EventArena
+///
+/// Suitable for std::allocate_shared. Every copy of the allocator keeps
+/// the arena alive.
+template <class T>
+class ArenaAllocator {
+public:
+    /// @brief Allocated type
+    typedef T value_type;
+
+    /// @brief Constructor
+    explicit ArenaAllocator(std::shared_ptr<EventArena> arena): m_arena(arena) {}
+
+    /// @brief Rebinding constructor
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other): m_arena(other.arena()) {}
+
+    /// @brief Allocate memory for @a n objects
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(m_arena->allocate(n*sizeof(T), alignof(T)));
+    }
+
+    /// @brief Memory is released together with the arena
+    void deallocate(T*, std::size_t) { m_arena->release(); }
+
+    /// @brief The underlying arena
+    const std::shared_ptr<EventArena>& arena() const { return m_arena; }
+
+private:
+    std::shared_ptr<EventArena> m_arena; ///< The underlying arena
+};
+
+/// @brief Allocators are equal if they use the same arena
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena() == b.arena(); }
+
+/// @brief Allocators are equal if they use the same arena
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena() != b.arena(); }
+
+} // namespace HepMC3
+
+#endif
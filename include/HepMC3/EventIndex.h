@@ -0,0 +1,96 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_EVENTINDEX_H
+#define HEPMC3_EVENTINDEX_H
+///
+/// @file  EventIndex.h
+/// @brief Definition of \b class EventIndex
+///
+/// @class HepMC3::EventIndex
+/// @brief Byte offsets of the events in a HepMC3 Ascii file
+///
+/// The index holds the offset of every event record (the @c E line) and
+/// of every block of run information (@c W, @c T and @c A lines outside of
+/// events). With it, ReaderAscii can go to any event without reading the
+/// preceding ones, see ReaderAscii::load_index.
+///
+/// The index is kept in a small text file next to the event file, by
+/// default with the extra suffix ".idx", see sidecar_name. It is written
+/// by WriterAscii on the fly, see WriterAscii::set_index_file, or built
+/// for an existing file by scan:
+/// @code
+///     EventIndex::scan("events.hepmc").write(EventIndex::sidecar_name("events.hepmc"));
+/// @endcode
+/// The size of the event file is stored in the index, so that an index
+/// that does not match the file any more is detected.
+///
+/// @ingroup IO
+///
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HepMC3 {
+
+class EventIndex {
+public:
+    /// @brief Default constructor, empty index
+    EventIndex(): m_file_size(-1) {}
+
+    /// @brief Build the index of the Ascii file @a filename by reading it once
+    ///
+    /// Returns an empty index if the file cannot be read.
+    static EventIndex scan(const std::string& filename);
+
+    /// @brief Default name of the index of the file @a filename
+    static std::string sidecar_name(const std::string& filename) { return filename + ".idx"; }
+
+    /// @brief Read the index from @a filename, @return false on failure
+    bool read(const std::string& filename);
+
+    /// @brief Write the index to @a filename, @return false on failure
+    bool write(const std::string& filename) const;
+
+    /// @brief Add an event record at @a offset
+    void add_event(const int64_t& offset) { m_events.push_back(offset); }
+
+    /// @brief Add a block of run information at @a offset, in effect for the events added next
+    void add_run_info(const int64_t& offset);
+
+    /// @brief Set the size of the indexed file
+    void set_file_size(const int64_t& size) { m_file_size = size; }
+
+    /// @brief Size of the indexed file, -1 if unknown
+    int64_t file_size() const { return m_file_size; }
+
+    /// @brief Number of events
+    size_t size() const { return m_events.size(); }
+
+    /// @brief Check if there are no events
+    bool empty() const { return m_events.empty(); }
+
+    /// @brief Offset of event number @a i in the file, counting from 0
+    int64_t event_offset(const size_t& i) const { return m_events[i]; }
+
+    /// @brief Number of the first event at or after @a offset, size() if none
+    size_t event_at(const int64_t& offset) const;
+
+    /// @brief Offset of the run information in effect for event number @a i, -1 if none
+    int64_t run_info_offset(const size_t& i) const;
+
+    /// @brief Offset of the last run information before @a offset, -1 if none
+    int64_t run_info_before(const int64_t& offset) const;
+
+private:
+    std::vector<int64_t> m_events;         ///< Offsets of the events
+    std::vector<int64_t> m_run_infos;      ///< Offsets of the blocks of run information
+    std::vector<size_t>  m_run_info_first; ///< Number of the first event after each block
+    int64_t m_file_size;                   ///< Size of the indexed file
+};
+
+} // namespace HepMC3
+
+#endif
@@ -60,6 +60,18 @@ public:
 
     /** @brief Implementation of Attribute::to_string */
     bool to_string(std::string &att) const override;
+
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override;
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<GenCrossSection>("GenCrossSection"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
     /// @name Deprecated functionality
     /// @{
     /// @brief Set all fields
@@ -22,6 +22,13 @@
 #include "HepMC3/GenPdfInfo.h"
 #include "HepMC3/GenCrossSection.h"
 #include "HepMC3/GenRunInfo.h"
+#include "HepMC3/EventArena.h"
+#include "HepMC3/AttributeKey.h"
+#include "HepMC3/MemoryUsage.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
 #include <mutex>
 #endif // __CINT__
 
@@ -33,6 +40,9 @@ class TBuffer;
 namespace HepMC3 {
 
 struct GenEventData;
+struct CompactEventData;
+struct GenParticleData;
+struct GenVertexData;
 
 /// @brief Stores event-related information
 ///
@@ -40,6 +50,10 @@ struct GenEventData;
 /// Contains lists of GenParticle and GenVertex objects
 class GenEvent {
 
+    friend class GenParticle;
+    friend class GenVertex;
+    friend class GenEventGraph;
+
 public:
 
     /// @brief Event constructor without a run
@@ -56,12 +70,35 @@ public:
     /// @brief Copy constructor
     GenEvent(const GenEvent&);
 
+    /// @brief Move constructor
+    ///
+    /// Takes over the particles, vertices, attributes, run info and arena
+    /// of @a e without copying them, and whether @a e is frozen. @a e is left
+    /// empty but valid, its root vertex is only created again when needed.
+    GenEvent(GenEvent&& e) noexcept;
+
     /// @brief Destructor
     ~GenEvent();
 
     /// @brief Assignment operator
     GenEvent& operator=(const GenEvent&);
 
+    /// @brief Move assignment operator
+    ///
+    /// The current content is released as in the destructor, then the content
+    /// of @a e is taken over as in the move constructor. As the other changes,
+    /// the assignment to a frozen event is refused, see freeze.
+    GenEvent& operator=(GenEvent&& e) noexcept;
+
+    /// @brief Deep copy of the event without serialization
+    ///
+    /// Unlike the copy constructor, which goes through GenEventData and
+    /// converts all attributes to strings, the particle/vertex graph is
+    /// copied directly and attributes are copied with Attribute::clone().
+    /// Attributes that cannot be cloned fall back to the string copy.
+    /// The run info is shared with the original event.
+    GenEvent clone() const;
+
     /// @name Particle and vertex access
     /// @{
 
@@ -187,6 +224,14 @@ public:
     /// Vertex representing the overall event position
     const FourVector& event_pos() const;
 
+    /// @brief Resolve the inherited positions of all vertices
+    ///
+    /// GenVertex::position resolves the positions of all vertices without
+    /// explicit position in one pass on first use, and caches them until
+    /// the event graph or a vertex position changes. This function fills
+    /// the cache in advance, e.g. before reading the event from several threads.
+    void resolve_positions() const;
+
     /// @brief Vector of beam particles
     std::vector<ConstGenParticlePtr> beams() const;
 
@@ -207,6 +252,9 @@ public:
     }
 
     /// @brief Boost event using x,y,z components of @a delta as velocities
+    ///
+    /// Only the particle momenta are changed. Use LorentzTransform
+    /// to boost the vertex positions as well.
     bool boost( const FourVector&  delta );
     /// @brief Rotate event using x,y,z components of @a delta as rotation angles
     bool rotate( const FourVector&  delta );
@@ -250,6 +298,10 @@ public:
     template<class T>
     std::shared_ptr<T> attribute(const std::string &name,  const int& id = 0) const;
 
+    /// @brief Get attribute of type T using a precompiled key
+    template<class T>
+    std::shared_ptr<T> attribute(const AttributeKey<T> &key,  const int& id = 0) const;
+
     /// @brief Get attribute of any type as string
     std::string attribute_as_string(const std::string &name,  const int& id = 0) const;
 
@@ -258,10 +310,7 @@ public:
 
     /// @brief Get a copy of the list of attributes
     /// @note To avoid thread issues, this is returns a copy. Better solution may be needed.
-    std::map< std::string, std::map<int, std::shared_ptr<Attribute> > > attributes() const {
-        std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-        return m_attributes;
-    }
+    std::map< std::string, std::map<int, std::shared_ptr<Attribute> > > attributes() const;
 
     /// @}
 
@@ -275,6 +324,16 @@ public:
     /// @brief Add vertex
     void add_vertex( GenVertexPtr v );
 
+    /// @brief Create a vertex from @a particles_in to @a particles_out and add it
+    ///
+    /// The particles are attached with GenVertex::add_particles_in and
+    /// GenVertex::add_particles_out, so that vertices with thousands of
+    /// particles are built in linear time. The vertex is created with
+    /// make_vertex.
+    GenVertexPtr add_vertex(const std::vector<GenParticlePtr>& particles_in,
+                            const std::vector<GenParticlePtr>& particles_out,
+                            const FourVector& position = FourVector::ZERO_VECTOR());
+
     /// @brief Remove particle from the event
     ///
     /// This function  will remove whole sub-tree starting from this particle
@@ -287,6 +346,7 @@ public:
     ///
     /// This function follows rules of GenEvent::remove_particle to remove
     /// a list of particles from the event.
+    /// The removal is done in one pass with GenEvent::remove_bulk.
     void remove_particles( std::vector<GenParticlePtr> v );
 
     /// @brief Remove vertex from the event
@@ -294,6 +354,60 @@ public:
     /// This will remove all sub-trees of all outgoing particles of this vertex
     void remove_vertex( GenVertexPtr v );
 
+    /// @brief Map from old to new ids, returned by GenEvent::remove_bulk
+    struct IdMap {
+        std::vector<int> particles; ///< New id of the particle with old id i+1, 0 if removed
+        std::vector<int> vertices;  ///< New id of the vertex with old id -(i+1), 0 if removed
+
+        /// @brief New id of a particle (id>0) or vertex (id<0), 0 if it was removed
+        int operator()(const int& old_id) const {
+            if ( old_id > 0 && old_id <= int(particles.size()) ) return particles[old_id - 1];
+            if ( old_id < 0 && -old_id <= int(vertices.size()) ) return vertices[-old_id - 1];
+            return old_id;
+        }
+    };
+
+    /// @brief Remove sets of particles and vertices in a single pass
+    ///
+    /// The result is the same as calling GenEvent::remove_particle and
+    /// GenEvent::remove_vertex for each of the objects, including the removal
+    /// of the sub-trees and of the emptied vertices, but the particle and
+    /// vertex lists and the attributes are renumbered only once.
+    /// Particles and vertices that do not belong to this event are ignored.
+    ///
+    /// @return Map from the old to the new ids
+    IdMap remove_bulk( const std::vector<GenParticlePtr>& particles,
+                       const std::vector<GenVertexPtr>& vertices = std::vector<GenVertexPtr>() );
+
+    /// @brief Remove all particles failing @a keep, reconnecting the rest
+    ///
+    /// Unlike remove_bulk, the descendants of removed particles are kept.
+    /// The vertices joined by removed particles are collapsed into one
+    /// vertex, the first of them in the event, so every surviving particle
+    /// is attached to the vertex of its nearest surviving ancestors. Two
+    /// vertices are not collapsed if they are also connected in another
+    /// way, e.g. by a surviving particle, as that would close a loop: the
+    /// removed particle is only dropped, and the ancestry is kept through
+    /// the other connection. Vertices are never collapsed into the root
+    /// vertex, removed beams are only detached from the vertex they enter.
+    /// Vertices left without outgoing particles are removed, as are the
+    /// attributes of all removed particles and vertices.
+    ///
+    /// The removed particles are handled in one pass over the event. The
+    /// other connection is only searched for when the removed particle
+    /// enters a vertex with further incoming particles, by following the
+    /// descendants of its production vertex. In the worst case, e.g. many
+    /// removed particles entering one vertex from one large shower, prune
+    /// takes O(P*V) time for P particles and V vertices, otherwise about
+    /// linear time.
+    ///
+    /// @a keep has the signature of the Filter of the search library, so
+    /// filters like (Selector::STATUS == 1) || (Selector::STATUS == 2) can
+    /// be passed directly.
+    ///
+    /// @return Map from the old to the new ids
+    IdMap prune(const std::function<bool(ConstGenParticlePtr)>& keep);
+
     /// @brief Add whole tree in topological order
     ///
     /// This function will find the beam particles (particles
@@ -305,14 +419,135 @@ public:
     ///       will be ignored.
     void add_tree( const std::vector<GenParticlePtr> &parts );
 
+    /// @brief Append copies of the particles, vertices and attributes of @a other
+    ///
+    /// Meant for overlaying pileup events on a signal event. The particle
+    /// and vertex ids of @a other are offset by the numbers of particles and
+    /// vertices already in this event, and the particle and vertex
+    /// attributes are copied with these new ids. The vertices are placed at
+    /// their positions in @a other, i.e. including its event position,
+    /// shifted by @a shift, e.g. in z and time. The particles without
+    /// production vertex in @a other are attached to the root vertex.
+    ///
+    /// The event number, weights, run info and event attributes (id 0) of
+    /// this event are kept, those of @a other are ignored. Momenta and
+    /// positions are converted to the units of this event.
+    void merge(const GenEvent& other, const FourVector& shift = FourVector::ZERO_VECTOR());
+
+    /// @brief Append several events, see merge
+    ///
+    /// The memory for all particles and vertices is reserved once.
+    /// @a shifts holds the shift of each event, or is empty for no shifts.
+    void merge(const std::vector<const GenEvent*>& others, const std::vector<FourVector>& shifts = std::vector<FourVector>());
+
     /// @brief Reserve memory for particles and vertices
     ///
     /// Helps optimize event creation when size of the event is known beforehand
     void reserve(const size_t& parts, const size_t& verts = 0);
 
+    /// @brief Estimated heap memory of this event, see MemoryUsage
+    ///
+    /// The GenRunInfo of the event is not included, since it is shared
+    /// between events, see GenRunInfo::memory_usage.
+    MemoryUsage memory_usage() const;
+
+    /// @brief Digest of the content of this event
+    ///
+    /// Covers the units, the particle data with the generated mass as
+    /// returned by GenParticle::generated_mass, the vertex data including the
+    /// position of the event, the particles attached to each vertex and the
+    /// weights, and optionally the string form of all attributes. The event
+    /// number is not included, so that repeated events get the same hash.
+    /// Particles and vertices are taken in the order of the event, the
+    /// order of the particles within a vertex does not matter. The value is
+    /// the same on all platforms and can be stored.
+    std::uint64_t hash(const bool& with_attributes = false) const;
+
     /// @brief Remove contents of this event
+    ///
+    /// If an arena is set and no object allocated from it is referenced
+    /// anymore, the arena is rewound in O(1). Otherwise a fresh arena of the
+    /// same block size is used for the next event.
+    ///
+    /// In recycling mode, see set_recycling, the particles, vertices and
+    /// unparsed string attributes that are not referenced from outside the
+    /// event are kept for reuse, together with the capacity of their lists.
+    /// The attribute tables are dropped as without recycling.
+    ///
+    /// Particles and vertices still held outside the event are neither
+    /// recycled nor detached: they keep their parent event and id, only
+    /// their links to recycled objects are cut.
+    ///
+    /// A frozen event is not cleared, see freeze.
     void clear();
 
+    /// @brief Make the event read-only, for concurrent access by several threads
+    ///
+    /// The standard attributes GenCrossSection, GenHeavyIon and GenPdfInfo
+    /// are parsed and the vertex positions are resolved. Afterwards the
+    /// attribute accessors take no lock and never change the attribute
+    /// tables: other attributes that are still unparsed are parsed on each
+    /// access instead of being cached. Changes through the methods of the
+    /// event, including clear(), and through the setters of its particles
+    /// and vertices are refused with an error until thaw().
+    ///
+    /// @note Changes made through the references returned by the non-const
+    /// weights() and weight(const std::string&) are not detected.
+    void freeze();
+
+    /// @brief Make a frozen event modifiable again
+    void thaw() { m_frozen.store(false, std::memory_order_release); }
+
+    /// @brief Check if the event is read-only, see freeze
+    bool is_frozen() const { return m_frozen.load(std::memory_order_acquire); }
+
+    /// @}
+
+
+    /// @name Object creation
+    /// @{
+
+    /// @brief Allocate the particles and vertices of this event from @a arena
+    ///
+    /// The arena is used by make_particle, make_vertex and read_data.
+    /// An empty pointer switches back to the default heap allocation.
+    void set_arena(std::shared_ptr<EventArena> arena) { m_arena = arena; }
+
+    /// @brief Get the arena used by this event, if any
+    std::shared_ptr<EventArena> arena() const { return m_arena; }
+
+    /// @brief Keep the objects of the event for reuse by clear
+    ///
+    /// Meant for events that are refilled in a loop, e.g. by a reader:
+    /// make_particle, make_vertex and make_string_attribute hand out the
+    /// objects kept by clear before allocating new ones, so that reading
+    /// events of similar size does hardly any allocation. Switching the
+    /// mode off releases the kept objects.
+    void set_recycling(const bool& recycling);
+
+    /// @brief Check if clear keeps the objects for reuse
+    bool recycling() const { return m_recycling; }
+
+    /// @brief Create a particle, in the arena of this event if there is one
+    /// @note The particle is not added to the event
+    GenParticlePtr make_particle(const FourVector& momentum = FourVector::ZERO_VECTOR(), int pid = 0, int status = 0);
+
+    /// @brief Create a particle from particle data, in the arena of this event if there is one
+    /// @note The particle is not added to the event
+    GenParticlePtr make_particle(const GenParticleData& data);
+
+    /// @brief Create a vertex, in the arena of this event if there is one
+    /// @note The vertex is not added to the event
+    GenVertexPtr make_vertex(const FourVector& position = FourVector::ZERO_VECTOR());
+
+    /// @brief Create a vertex from vertex data, in the arena of this event if there is one
+    /// @note The vertex is not added to the event
+    GenVertexPtr make_vertex(const GenVertexData& data);
+
+    /// @brief Create an unparsed string attribute, as done by the readers
+    /// @note The attribute is not added to the event
+    std::shared_ptr<StringAttribute> make_string_attribute(const std::string& text);
+
     /// @}
 
     /// @name Deprecated functionality
@@ -348,11 +583,23 @@ public:
     /// @{
 
     /// @brief Fill GenEventData object
-    void write_data(GenEventData &data) const;
+    ///
+    /// If @a binary_attributes is set, the attributes that implement
+    /// Attribute::to_bytes go to the binary attribute section of @a data,
+    /// and only the others are converted to strings.
+    void write_data(GenEventData &data, const bool& binary_attributes = false) const;
 
     /// @brief Fill GenEvent based on GenEventData
     void read_data(const GenEventData &data);
 
+    /// @brief Fill single precision CompactEventData object
+    ///
+    /// Attributes are converted to strings.
+    void write_data(CompactEventData &data) const;
+
+    /// @brief Fill GenEvent based on CompactEventData
+    void read_data(const CompactEventData &data);
+
 #ifdef HEPMC3_ROOTIO
     /// @brief ROOT I/O streamer
     void Streamer(TBuffer &b);
@@ -383,71 +630,203 @@ private:
     Units::LengthUnit m_length_unit = Units::MM;
 
     /// The root vertex is stored outside the normal vertices list to block user access to it
+    /// Empty in events that were moved from, see root_vertex
     GenVertexPtr m_rootvertex;
 
     /// Global run information.
     std::shared_ptr<GenRunInfo> m_run_info;
 
-    /// @brief Map of event, particle and vertex attributes
-    ///
-    /// Keys are name and ID (0 = event, <0 = vertex, >0 = particle)
-    mutable std::map< std::string, std::map<int, std::shared_ptr<Attribute> > > m_attributes;
+    /// @brief Attribute table entry: owner ID (0 = event, <0 = vertex, >0 = particle) and attribute
+    typedef std::pair<int, std::shared_ptr<Attribute> > att_val_t;
+
+    /// @brief All attributes with the same name, sorted by owner ID
+    struct AttributeTable {
+        int key;                        ///< Interned name, see AttributeRegistry
+        const std::string* name;        ///< Name, owned by AttributeRegistry
+        std::vector<att_val_t> entries; ///< Attributes sorted by owner ID
 
-    /// @brief Attribute map key type
-    typedef std::map< std::string, std::map<int, std::shared_ptr<Attribute> > >::value_type att_key_t;
+        /// @brief Attribute of object @a id, nullptr if there is none
+        std::shared_ptr<Attribute>* find(const int& id);
+        /// @brief Set attribute of object @a id, existing one is kept unless @a replace is set
+        void set(const int& id, const std::shared_ptr<Attribute>& att, const bool& replace = true);
+        /// @brief Remove attribute of object @a id
+        void erase(const int& id);
+    };
 
-    /// @brief Attribute map value type
-    typedef std::map<int, std::shared_ptr<Attribute> >::value_type att_val_t;
+    /// @brief Event, particle and vertex attributes, one table per name sorted by name
+    mutable std::vector<AttributeTable> m_attributes;
 
     /// @brief Mutex lock for the m_attibutes map.
     mutable std::recursive_mutex m_lock_attributes;
+
+    /// @brief Optional arena for particles and vertices
+    std::shared_ptr<EventArena> m_arena;
+
+    /// @brief Keep objects for reuse in clear
+    bool m_recycling = false;
+
+    /// @brief Particles kept for reuse
+    std::vector<GenParticlePtr> m_free_particles;
+
+    /// @brief Vertices kept for reuse
+    std::vector<GenVertexPtr> m_free_vertices;
+
+    /// @brief String attributes kept for reuse
+    std::vector<std::shared_ptr<StringAttribute> > m_free_strings;
+
+    /// @brief Move the objects of the event that are not used elsewhere to the free lists
+    void recycle();
+
+    /// @brief Cut the links between vertex @a v and its particles, keeping the capacity
+    static void unlink(const GenVertexPtr& v);
+
+    /// @brief Resolved vertex positions in the order of m_vertices, see resolve_positions
+    mutable std::vector<const FourVector*> m_positions;
+
+    /// @brief Vertex indices by id, see index_vertices
+    mutable std::unordered_map<int, int> m_position_index;
+
+    /// @brief True if m_positions is up to date
+    mutable std::atomic<bool> m_positions_valid{false};
+
+    /// @brief Index of @a v in m_vertices, valid while the resolved positions are
+    ///
+    /// The number of vertices is returned if @a v is not one of them, e.g. if it
+    /// was held outside the event when the event was cleared.
+    size_t position_index(const GenVertex* v) const;
+
+    /// @brief Resolved position of @a v, found from its ancestors if it is no longer in the event
+    const FourVector& resolved_position(const GenVertex* v) const;
+
+    /// @brief True if the event is read-only, see freeze
+    std::atomic<bool> m_frozen{false};
+
+    /// @brief Root vertex, created again if the event was moved from
+    const GenVertexPtr& root_vertex();
+
+    /// @brief Report an attempt to change a frozen event, returns true if the change must be refused
+    bool refuse_change(const char* method) const;
+
+    /// @brief Lock for the attribute tables, not locked if the event is frozen
+    std::unique_lock<std::recursive_mutex> attribute_lock() const;
+
+    /// @brief Mark the resolved vertex positions as outdated
+    void invalidate_positions() { m_positions_valid.store(false, std::memory_order_relaxed); }
+
+    /// @brief Append @a other without reserving memory, see merge
+    void append(const GenEvent& other, const FourVector& shift);
+
+    /// @brief Take over the content of @a e, used by the move operations
+    void move_from(GenEvent& e);
+
+    /// @brief Attribute table with given name, nullptr if there is none
+    AttributeTable* find_attribute_table(const std::string& name) const;
+
+    /// @brief Attribute table with given interned name, nullptr if there is none
+    AttributeTable* find_attribute_table(const int& key) const;
+
+    /// @brief Attribute table with given name, created if needed
+    AttributeTable& attribute_table(const std::string& name);
+
+    /// @brief Point attribute @a att to this event and to object @a id
+    void attach_attribute(const std::shared_ptr<Attribute>& att, const int& id) const;
+
+    /// @brief Get attribute of type T from a table slot, parsing it if needed
+    template<class T>
+    std::shared_ptr<T> typed_attribute(std::shared_ptr<Attribute>& slot, const int& id) const;
+
+    /// @brief Fill @a index with the indices of the vertices in m_vertices by id
+    ///
+    /// The vertex ids follow the order of the vertices unless set explicitly,
+    /// e.g. by the readers. In the first case @a index is left empty.
+    void index_vertices(std::unordered_map<int, int>& index) const;
+
+    /// @brief Index in m_vertices of the vertex with id @a id, -1 if there is none, see index_vertices
+    int vertex_index(const int& id, const std::unordered_map<int, int>& index) const;
+
+    /// @brief Index in m_vertices of @a v, -1 if it is not one of them, e.g. the root vertex
+    int vertex_index(const GenVertex* v, const std::unordered_map<int, int>& index) const;
+
+    /// @brief Set the vertex ids to -(i+1) in the order of the vertices, e.g. after a reader set them
+    void normalize_vertex_ids();
+
+    /// @brief Drop the marked particles and vertices and renumber the rest
+    ///
+    /// The marks are indexed by id-1 and -id-1 and must already include
+    /// everything that has to go. Links to removed objects are cut.
+    IdMap compact(const std::vector<char>& particle_removed, const std::vector<char>& vertex_removed);
 #endif // __CINT__
 
     /// @}
 
 };
 
+/// @brief Check if two events have the same content
+///
+/// Compares the same quantities as GenEvent::hash, with particles and
+/// vertices matched by their position in the events. Momenta, masses,
+/// positions and weights may differ by @a tolerance relative to their
+/// magnitude, or absolutely for magnitudes below one. Attributes are
+/// compared in their string form if @a with_attributes is set.
+bool equivalent(const GenEvent& a, const GenEvent& b, const double& tolerance = 0.0, const bool& with_attributes = false);
+
 
 
 #if !defined(__CINT__)
 //
 // Template methods
 //
+template<class T>
+std::shared_ptr<T> GenEvent::typed_attribute(std::shared_ptr<Attribute>& slot, const int& id) const {
+    if ( slot->is_parsed() ) {
+        // Exact type match avoids the dynamic cast
+        if ( typeid(*slot) == typeid(T) ) return std::static_pointer_cast<T>(slot);
+        return std::dynamic_pointer_cast<T>(slot);
+    }
+
+    std::shared_ptr<T> att = std::make_shared<T>();
+    attach_attribute(att, id);
+    const bool parsed = typeid(*slot) == typeid(BinaryAttribute) ?
+                        static_cast<const BinaryAttribute&>(*slot).parse(*att) :
+                        att->from_string(slot->unparsed_string());
+    if ( parsed && att->init() ) {
+        // update table with new pointer, unless other threads may be reading it
+        if ( !is_frozen() ) slot = att;
+        return att;
+    }
+    return std::shared_ptr<T>();
+}
+
 template<class T>
 std::shared_ptr<T> GenEvent::attribute(const std::string &name,  const int& id) const {
-    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-    std::map< std::string, std::map<int, std::shared_ptr<Attribute> > >::iterator i1 = m_attributes.find(name);
-    if ( i1 == m_attributes.end() ) {
+    std::unique_lock<std::recursive_mutex> lock = attribute_lock();
+    AttributeTable* table = find_attribute_table(name);
+    if ( !table ) {
         if ( id == 0 && run_info() ) {
             return run_info()->attribute<T>(name);
         }
         return std::shared_ptr<T>();
     }
 
-    std::map<int, std::shared_ptr<Attribute> >::iterator i2 = i1->second.find(id);
-    if (i2 == i1->second.end() ) return std::shared_ptr<T>();
-
-    if (!i2->second->is_parsed() ) {
-
-        std::shared_ptr<T> att = std::make_shared<T>();
-        att->m_event = this;
+    std::shared_ptr<Attribute>* slot = table->find(id);
+    if ( !slot ) return std::shared_ptr<T>();
+    return typed_attribute<T>(*slot, id);
+}
 
-        if ( id > 0 && id <= int(particles().size()) ) {
-            att->m_particle = m_particles[id - 1];
-        }
-        if ( id < 0 && -id <= int(vertices().size()) ) {
-            att->m_vertex = m_vertices[-id - 1];
-        }
-        if ( att->from_string(i2->second->unparsed_string()) &&
-                att->init() ) {
-            // update map with new pointer
-            i2->second = att;
-            return att;
-        } else {
-            return std::shared_ptr<T>();
+template<class T>
+std::shared_ptr<T> GenEvent::attribute(const AttributeKey<T> &key,  const int& id) const {
+    std::unique_lock<std::recursive_mutex> lock = attribute_lock();
+    AttributeTable* table = find_attribute_table(key.key());
+    if ( !table ) {
+        if ( id == 0 && run_info() ) {
+            return run_info()->attribute<T>(key.name());
         }
+        return std::shared_ptr<T>();
     }
-    else return std::dynamic_pointer_cast<T>(i2->second);
+
+    std::shared_ptr<Attribute>* slot = table->find(id);
+    if ( !slot ) return std::shared_ptr<T>();
+    return typed_attribute<T>(*slot, id);
 }
 #endif // __CINT__
 
@@ -0,0 +1,84 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_GENEVENTCOLUMNS_H
+#define HEPMC3_GENEVENTCOLUMNS_H
+///
+/// @file  GenEventColumns.h
+/// @brief Definition of \b class GenEventColumns
+///
+/// @class HepMC3::GenEventColumns
+/// @brief Columnar (struct-of-arrays) read-only copy of the particles of an event
+///
+/// Each particle property is stored in its own contiguous array, indexed
+/// by the particle position in GenEvent::particles(), i.e. by id-1.
+/// Vertex references are stored as indices into GenEvent::vertices(),
+/// i.e. -id-1, with -1 meaning "no vertex" (or the root vertex).
+///
+/// The columns can be filled either from a GenEvent or directly from
+/// GenEventData without building the particle/vertex graph.
+/// The object can be refilled for each event to reuse the allocated memory.
+///
+/// @note The mass column holds GenParticle::generated_mass(), i.e. the
+///       momentum mass if no generated mass was set.
+///
+/// @ingroup data
+///
+#include <vector>
+#include "HepMC3/Units.h"
+
+namespace HepMC3 {
+
+class GenEvent;
+struct GenEventData;
+
+class GenEventColumns {
+public:
+    /// @brief Default constructor, empty columns
+    GenEventColumns(): momentum_unit(Units::GEV), length_unit(Units::MM) {}
+
+    /// @brief Construct columns from event
+    explicit GenEventColumns(const GenEvent& evt);
+
+    /// @brief Construct columns from serialized event data
+    explicit GenEventColumns(const GenEventData& data);
+
+    /// @brief Refill columns from event
+    void fill(const GenEvent& evt);
+
+    /// @brief Refill columns from serialized event data
+    void fill(const GenEventData& data);
+
+    /// @brief Remove all entries, keeping the allocated memory
+    void clear();
+
+    /// @brief Number of particles
+    size_t size() const { return pid.size(); }
+
+    /// @brief Check if there are no particles
+    bool empty() const { return pid.empty(); }
+
+    Units::MomentumUnit momentum_unit; ///< Momentum unit of the columns
+    Units::LengthUnit   length_unit;   ///< Length unit of the event
+
+    std::vector<int>    pid;    ///< PDG ID
+    std::vector<int>    status; ///< Status
+    std::vector<double> px;     ///< Momentum x component
+    std::vector<double> py;     ///< Momentum y component
+    std::vector<double> pz;     ///< Momentum z component
+    std::vector<double> e;      ///< Energy
+    std::vector<double> mass;   ///< Generated mass
+
+    std::vector<int> production_vertex_index; ///< Index of the production vertex, -1 if none
+    std::vector<int> end_vertex_index;        ///< Index of the end vertex, -1 if none
+
+private:
+    /// @brief Resize all columns to @a n entries
+    void resize(const size_t& n);
+};
+
+} // namespace HepMC3
+
+#endif
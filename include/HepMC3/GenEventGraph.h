@@ -0,0 +1,140 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_GENEVENTGRAPH_H
+#define HEPMC3_GENEVENTGRAPH_H
+///
+/// @file  GenEventGraph.h
+/// @brief Definition of \b class GenEventGraph
+///
+/// @class HepMC3::GenEventGraph
+/// @brief Read-only index copy of the particle/vertex graph of an event
+///
+/// Particles are identified by their position in GenEvent::particles(),
+/// i.e. by id-1, and vertices by their position in GenEvent::vertices(),
+/// i.e. by -id-1, with -1 meaning "no vertex" (or the root vertex), as
+/// in GenEventColumns. The incoming and outgoing particles of all vertices
+/// are stored in compressed sparse row form: one array of particle indices
+/// per direction, and one array of offsets into it per vertex. The particles
+/// of a vertex are sorted by index.
+///
+/// Walking the graph therefore touches only contiguous integer arrays, with
+/// none of the reference counting of GenParticlePtr and GenVertexPtr. The
+/// graph does not refer to the event, so it can be traversed by several
+/// threads at the same time.
+///
+/// @code
+///     GenEventGraph graph(evt);
+///     for (int parent: graph.parents(i)) { ... }
+///     std::vector<int> chain = graph.ancestors(i);
+/// @endcode
+///
+/// The graph can be filled either from a GenEvent or directly from
+/// GenEventData, and refilled for each event to reuse the allocated memory.
+///
+/// @ingroup data
+///
+#include <cstddef>
+#include <vector>
+
+namespace HepMC3 {
+
+class GenEvent;
+struct GenEventData;
+
+class GenEventGraph {
+public:
+    /// @brief Contiguous range of particle indices
+    class Range {
+    public:
+        /// @brief Constructor
+        Range(const int* first, const int* last): m_begin(first), m_end(last) {}
+        /// @brief Begin of the range
+        const int* begin() const { return m_begin; }
+        /// @brief End of the range
+        const int* end() const { return m_end; }
+        /// @brief Number of indices
+        size_t size() const { return m_end - m_begin; }
+        /// @brief Check if the range is empty
+        bool empty() const { return m_begin == m_end; }
+        /// @brief Index number @a i
+        int operator[](const size_t& i) const { return m_begin[i]; }
+    private:
+        const int* m_begin; ///< First index
+        const int* m_end;   ///< One past the last index
+    };
+
+    /// @brief Default constructor, empty graph
+    GenEventGraph() {}
+
+    /// @brief Construct graph from event
+    explicit GenEventGraph(const GenEvent& evt);
+
+    /// @brief Construct graph from serialized event data
+    explicit GenEventGraph(const GenEventData& data);
+
+    /// @brief Refill graph from event
+    void fill(const GenEvent& evt);
+
+    /// @brief Refill graph from serialized event data
+    void fill(const GenEventData& data);
+
+    /// @brief Remove all entries, keeping the allocated memory
+    void clear();
+
+    /// @brief Number of particles
+    size_t particles_size() const { return m_production_vertex.size(); }
+
+    /// @brief Number of vertices
+    size_t vertices_size() const { return m_in_offsets.empty() ? 0 : m_in_offsets.size() - 1; }
+
+    /// @brief Index of the production vertex of particle @a i, -1 if none
+    int production_vertex(const int& i) const { return m_production_vertex[i]; }
+
+    /// @brief Index of the end vertex of particle @a i, -1 if none
+    int end_vertex(const int& i) const { return m_end_vertex[i]; }
+
+    /// @brief Incoming particles of vertex @a v
+    Range particles_in(const int& v) const { return range(m_in, m_in_offsets, v); }
+
+    /// @brief Outgoing particles of vertex @a v
+    Range particles_out(const int& v) const { return range(m_out, m_out_offsets, v); }
+
+    /// @brief Parents of particle @a i, i.e. the incoming particles of its production vertex
+    Range parents(const int& i) const { return particles_in(m_production_vertex[i]); }
+
+    /// @brief Children of particle @a i, i.e. the outgoing particles of its end vertex
+    Range children(const int& i) const { return particles_out(m_end_vertex[i]); }
+
+    /// @brief All ancestors of particle @a i, nearest first
+    std::vector<int> ancestors(const int& i) const;
+
+    /// @brief All descendants of particle @a i, nearest first
+    std::vector<int> descendants(const int& i) const;
+
+    /// @brief Check if the vertices form a cycle
+    bool has_cycles() const;
+
+private:
+    /// @brief Range of @a v in CSR arrays, empty for v = -1
+    static Range range(const std::vector<int>& values, const std::vector<int>& offsets, const int& v);
+
+    /// @brief Build the CSR arrays of @a n_vertices vertices from the vertices of the particles
+    void build(const size_t& n_vertices);
+
+    /// @brief Breadth-first walk from particle @a i, towards the parents if @a up is set
+    std::vector<int> walk(const int& i, const bool up) const;
+
+    std::vector<int> m_production_vertex; ///< Production vertex of each particle
+    std::vector<int> m_end_vertex;        ///< End vertex of each particle
+    std::vector<int> m_in_offsets;        ///< Start of the incoming particles of each vertex in m_in, plus the end
+    std::vector<int> m_in;                ///< Incoming particles of all vertices
+    std::vector<int> m_out_offsets;       ///< Start of the outgoing particles of each vertex in m_out, plus the end
+    std::vector<int> m_out;               ///< Outgoing particles of all vertices
+};
+
+} // namespace HepMC3
+
+#endif
@@ -16,6 +16,7 @@
 #include <string>
 #include "HepMC3/Data/GenParticleData.h"
 #include "HepMC3/FourVector.h"
+#include "HepMC3/AttributeKey.h"
 
 #include "HepMC3/GenParticle_fwd.h"
 #include "HepMC3/GenVertex_fwd.h"
@@ -116,6 +117,10 @@ public:
     template<class T>
     std::shared_ptr<T> attribute(const std::string& name) const;
 
+    /// @brief Get attribute of type T using a precompiled key
+    template<class T>
+    std::shared_ptr<T> attribute(const AttributeKey<T>& key) const;
+
     /// @brief Get attribute of any type as string
     std::string attribute_as_string(const std::string& name) const;
 
@@ -155,5 +160,10 @@ template<class T> std::shared_ptr<T> GenParticle::attribute(const std::string& n
     return parent_event()?
            parent_event()->attribute<T>(name, id()): std::shared_ptr<T>();
 }
+/// @brief Get attribute of type T using a precompiled key
+template<class T> std::shared_ptr<T> GenParticle::attribute(const AttributeKey<T>& key) const {
+    return parent_event()?
+           parent_event()->attribute<T>(key, id()): std::shared_ptr<T>();
+}
 }
 #endif
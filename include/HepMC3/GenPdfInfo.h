@@ -51,6 +51,18 @@ public:
     /** @brief Implementation of Attribute::to_string */
     bool to_string(std::string &att) const  override;
 
+    /** @brief Implementation of Attribute::clone */
+    std::shared_ptr<Attribute> clone() const override;
+
+    /** @brief Implementation of Attribute::type_tag */
+    std::string type_tag() const override { return type_tag_exact<GenPdfInfo>("GenPdfInfo"); }
+
+    /** @brief Implementation of Attribute::to_bytes */
+    bool to_bytes(std::string &bytes) const override;
+
+    /** @brief Implementation of Attribute::from_bytes */
+    bool from_bytes(const std::string &bytes) override;
+
     /** @brief Set all fields */
     void set( const int& parton_id1, const int& parton_id2, const double& x1, const double& x2,
               const double& scale_in, const double& xf1, const double& xf2,
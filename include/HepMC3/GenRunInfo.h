@@ -13,6 +13,7 @@
 #if !defined(__CINT__)
 #include "HepMC3/Units.h"
 #include "HepMC3/Attribute.h"
+#include "HepMC3/MemoryUsage.h"
 #include <mutex>
 #endif // __CINT__
 
@@ -51,7 +52,7 @@ public:
 public:
 
     /// @brief Default constructor
-    GenRunInfo() {}
+    GenRunInfo();
     /// @brief Copy constructor
     GenRunInfo(const GenRunInfo& r);
     /// @brief Assignmet
@@ -96,6 +97,13 @@ public:
     /// the number of weights in the events in the run.
     void set_weight_names(const std::vector<std::string> & names);
 
+    /// @brief Identifier of the current weight names
+    ///
+    /// Unique among all GenRunInfo objects of the process, and changed by
+    /// every call of set_weight_names. Used by WeightHandle and WeightSet
+    /// to check that cached weight indices are still valid.
+    unsigned long weight_names_id() const { return m_weight_names_id; }
+
     /// @brief add an attribute
     /// This will overwrite existing attribute if an attribute
     /// with the same name is present
@@ -127,6 +135,12 @@ public:
         return m_attributes;
     }
 
+    /// @brief Estimated heap memory of this run info, see MemoryUsage
+    ///
+    /// Weight names and their index go to MemoryUsage::weights, tool
+    /// descriptions to MemoryUsage::strings.
+    MemoryUsage memory_usage() const;
+
 
 #endif // __CINT__
 
@@ -161,6 +175,9 @@ private:
     /// @brief A vector of weight names.
     std::vector<std::string> m_weight_names;
 
+    /// @brief Identifier of the weight names, see weight_names_id
+    unsigned long m_weight_names_id;
+
     /// @brief Map of attributes
     mutable std::map< std::string, std::shared_ptr<Attribute> > m_attributes;
 
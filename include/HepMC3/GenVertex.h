@@ -13,6 +13,8 @@
 #include "HepMC3/GenVertex_fwd.h"
 #include "HepMC3/Data/GenVertexData.h"
 #include "HepMC3/FourVector.h"
+#include "HepMC3/AttributeKey.h"
+#include "HepMC3/ParticleList.h"
 
 namespace HepMC3 {
 
@@ -63,7 +65,7 @@ public:
     /// Get vertex status code
     int status() const { return m_data.status; }
     /// Set vertex status code
-    void set_status(int stat) { m_data.status = stat; }
+    void set_status(int stat);
 
     /// Get vertex data
     const GenVertexData& data() const { return m_data; }
@@ -72,6 +74,25 @@ public:
     void add_particle_in ( GenParticlePtr p);
     /// Add outgoing particle
     void add_particle_out( GenParticlePtr p);
+    /// @brief Add incoming particles
+    ///
+    /// Same as add_particle_in for every particle, but in linear time.
+    /// Particles already attached to this vertex are recognised by their
+    /// end vertex. The list itself is searched for duplicates only if
+    /// @a check_duplicates is set, e.g. when debugging.
+    void add_particles_in(const std::vector<GenParticlePtr>& particles, const bool check_duplicates = false);
+    /// @brief Add outgoing particles
+    ///
+    /// Same as add_particle_out for every particle, see add_particles_in.
+    void add_particles_out(const std::vector<GenParticlePtr>& particles, const bool check_duplicates = false);
+    /// @brief Reserve space for @a n_in incoming and @a n_out outgoing particles
+    ///
+    /// Readers that know the number of particles of a vertex in advance
+    /// use this to fill each list with at most one allocation.
+    void reserve(const size_t& n_in, const size_t& n_out) {
+        m_particles_in.reserve(n_in);
+        m_particles_out.reserve(n_out);
+    }
     /// Remove incoming particle
     void remove_particle_in ( GenParticlePtr p);
     /// Remove outgoing particle
@@ -83,20 +104,36 @@ public:
     inline int particles_out_size() const { return m_particles_out.size(); }
 
 
-    /// Get list of incoming particles
-    const std::vector<GenParticlePtr>& particles_in() { return m_particles_in; }
-    /// Get list of incoming particles (for const access)
+    /// @brief Get list of incoming particles
+    ///
+    /// The particles are copied to a vector on the first call, which is kept
+    /// up to date afterwards. particles_in_span avoids this copy.
+    const std::vector<GenParticlePtr>& particles_in() { return m_particles_in.vector(); }
+    /// Get list of incoming particles (for const access), see particles_in
     const std::vector<ConstGenParticlePtr>& particles_in() const;
-    /// Get list of outgoing particles
-    const std::vector<GenParticlePtr>& particles_out() { return m_particles_out; }
-    /// Get list of outgoing particles (for const access)
+    /// @brief Get list of outgoing particles
+    ///
+    /// The particles are copied to a vector on the first call, which is kept
+    /// up to date afterwards. particles_out_span avoids this copy.
+    const std::vector<GenParticlePtr>& particles_out() { return m_particles_out.vector(); }
+    /// Get list of outgoing particles (for const access), see particles_out
     const std::vector<ConstGenParticlePtr>& particles_out() const;
 
+    /// @brief View of the incoming particles, valid until they change
+    ParticleSpan<GenParticlePtr> particles_in_span() { return m_particles_in.span(); }
+    /// @brief View of the incoming particles (for const access), valid until they change
+    ParticleSpan<ConstGenParticlePtr> particles_in_span() const { return m_particles_in.const_span(); }
+    /// @brief View of the outgoing particles, valid until they change
+    ParticleSpan<GenParticlePtr> particles_out_span() { return m_particles_out.span(); }
+    /// @brief View of the outgoing particles (for const access), valid until they change
+    ParticleSpan<ConstGenParticlePtr> particles_out_span() const { return m_particles_out.const_span(); }
+
     /// @brief Get vertex position
     ///
     /// Returns the position of this vertex. If a position is not set on _this_ vertex,
     /// the production vertices of ancestors are searched to find the inherited position.
     /// FourVector(0,0,0,0) is returned if no position information is found.
+    /// The inherited positions are cached by the event, see GenEvent::resolve_positions.
     ///
     const FourVector& position() const;
     /// @brief Check if position of this vertex is set
@@ -122,6 +159,10 @@ public:
     template<class T>
     std::shared_ptr<T> attribute(const std::string& name) const;
 
+    /// @brief Get attribute of type T using a precompiled key
+    template<class T>
+    std::shared_ptr<T> attribute(const AttributeKey<T>& key) const;
+
     /// @brief Get attribute of any type as string
     std::string attribute_as_string(const std::string& name) const;
 
@@ -149,9 +190,9 @@ private:
     int             m_id;     //!< Vertex id
     GenVertexData   m_data;   //!< Vertex data
 
-    std::vector<GenParticlePtr>  m_particles_in;  //!< Incoming particle list
+    ParticleList<2>  m_particles_in;  //!< Incoming particle list, two of them inline
 
-    std::vector<GenParticlePtr>  m_particles_out; //!< Outgoing particle list
+    ParticleList<4>  m_particles_out; //!< Outgoing particle list, four of them inline
     /// @}
 
 };
@@ -166,6 +207,11 @@ template<class T> std::shared_ptr<T> GenVertex::attribute(const std::string& nam
     return parent_event()?
            parent_event()->attribute<T>(name, id()): std::shared_ptr<T>();
 }
+/// @brief Get attribute of type T using a precompiled key
+template<class T> std::shared_ptr<T> GenVertex::attribute(const AttributeKey<T>& key) const {
+    return parent_event()?
+           parent_event()->attribute<T>(key, id()): std::shared_ptr<T>();
+}
 }
 
 #endif
@@ -181,11 +181,11 @@ bool GenEvent_to_HEPEVT_nonstatic(const GenEvent* evt, T* A)
     /*For a valid "Trust mothers" HEPEVT record we must  keep mothers together*/
     for (std::pair<ConstGenVertexPtr, int> it: sorted_paths)
     {
-        std::vector<ConstGenParticlePtr> Q = it.first->particles_in();
+        std::vector<ConstGenParticlePtr> Q = it.first->particles_in_span().to_vector();
         std::sort(Q.begin(), Q.end(), GenParticlePtr_greater());
         std::copy(Q.begin(), Q.end(), std::back_inserter(sorted_particles));
         /*For each vertex put all outgoing particles w/o end vertex. Ordering of particles to produces reproduceable record*/
-        for (ConstGenParticlePtr pp: it.first->particles_out())
+        for (ConstGenParticlePtr pp: it.first->particles_out_span())
             if (!(pp->end_vertex())) stable_particles.push_back(pp);
     }
     std::sort(stable_particles.begin(), stable_particles.end(), GenParticlePtr_greater());
@@ -204,14 +204,14 @@ bool GenEvent_to_HEPEVT_nonstatic(const GenEvent* evt, T* A)
         A->set_momentum(i, m.px(), m.py(), m.pz(), m.e());
         A->set_mass(i, sorted_particles[i-1]->generated_mass());
         if ( sorted_particles[i-1]->production_vertex()  &&
-                sorted_particles[i-1]->production_vertex()->particles_in().size())
+                sorted_particles[i-1]->production_vertex()->particles_in_span().size())
         {
             FourVector p = sorted_particles[i-1]->production_vertex()->position();
             A->set_position(i, p.x(), p.y(), p.z(), p.t() );
             std::vector<int> mothers;
             mothers.clear();
 
-            for (ConstGenParticlePtr it: sorted_particles[i-1]->production_vertex()->particles_in())
+            for (ConstGenParticlePtr it: sorted_particles[i-1]->production_vertex()->particles_in_span())
                 for ( int j = 1; j <= particle_counter; ++j )
                     if (sorted_particles[j-1] == (it))
                         mothers.push_back(j);
@@ -330,11 +330,11 @@ bool GenEvent_to_HEPEVT_static(const GenEvent* evt)
     /*For a valid "Trust mothers" HEPEVT record we must  keep mothers together*/
     for (std::pair<ConstGenVertexPtr, int> it: sorted_paths)
     {
-        std::vector<ConstGenParticlePtr> Q = it.first->particles_in();
+        std::vector<ConstGenParticlePtr> Q = it.first->particles_in_span().to_vector();
         std::sort(Q.begin(), Q.end(), GenParticlePtr_greater());
         std::copy(Q.begin(), Q.end(), std::back_inserter(sorted_particles));
         /*For each vertex put all outgoing particles w/o end vertex. Ordering of particles to produces reproduceable record*/
-        for (ConstGenParticlePtr pp: it.first->particles_out())
+        for (ConstGenParticlePtr pp: it.first->particles_out_span())
             if (!(pp->end_vertex())) stable_particles.push_back(pp);
     }
     std::sort(stable_particles.begin(), stable_particles.end(), GenParticlePtr_greater());
@@ -353,14 +353,14 @@ bool GenEvent_to_HEPEVT_static(const GenEvent* evt)
         T::set_momentum(i, m.px(), m.py(), m.pz(), m.e());
         T::set_mass(i, sorted_particles[i-1]->generated_mass());
         if ( sorted_particles[i-1]->production_vertex()  &&
-                sorted_particles[i-1]->production_vertex()->particles_in().size())
+                sorted_particles[i-1]->production_vertex()->particles_in_span().size())
         {
             FourVector p = sorted_particles[i-1]->production_vertex()->position();
             T::set_position(i, p.x(), p.y(), p.z(), p.t() );
             std::vector<int> mothers;
             mothers.clear();
 
-            for (ConstGenParticlePtr it: sorted_particles[i-1]->production_vertex()->particles_in())
+            for (ConstGenParticlePtr it: sorted_particles[i-1]->production_vertex()->particles_in_span())
                 for ( int j = 1; j <= particle_counter; ++j )
                     if (sorted_particles[j-1] == (it))
                         mothers.push_back(j);
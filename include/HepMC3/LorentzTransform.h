@@ -0,0 +1,101 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_LORENTZTRANSFORM_H
+#define HEPMC3_LORENTZTRANSFORM_H
+///
+/// @file  LorentzTransform.h
+/// @brief Definition of \b class LorentzTransformT
+///
+/// @class HepMC3::LorentzTransformT
+/// @brief Linear transformation of four-vectors stored as a 4x4 matrix
+///
+/// Boosts, rotations and reflections with the same conventions as
+/// GenEvent::boost, GenEvent::rotate and GenEvent::reflect are composed
+/// into a single matrix, which is then applied to all momenta and vertex
+/// positions of an event in one pass:
+/// @code
+///     LorentzTransform frame;
+///     frame.boost(FourVector(0.0, 0.0, -0.2, 0.0));
+///     frame.rotate(FourVector(0.0, crossing_angle, 0.0, 0.0));
+///     for (GenEvent& evt: events) frame.apply(evt);
+/// @endcode
+/// Every call of boost, rotate or reflect acts after the transformations
+/// already stored in the object.
+///
+/// The four-vectors are processed in contiguous batches of coordinates,
+/// so that the matrix product vectorizes. The template parameter sets
+/// the precision of the arithmetic: LorentzTransform uses double and
+/// LorentzTransformLD uses long double. The results are always stored
+/// as FourVector, i.e. in double.
+///
+/// @note Vertices without explicitly set position are not changed,
+///       since their position follows from their ancestors.
+///
+/// @ingroup events
+///
+#include <cstddef>
+#include "HepMC3/FourVector.h"
+
+namespace HepMC3 {
+
+class GenEvent;
+
+template <class T>
+class LorentzTransformT {
+public:
+    /// @brief Default constructor, identity transformation
+    LorentzTransformT();
+
+    /// @brief Boost using x,y,z components of @a delta as velocities
+    ///
+    /// Returns false and leaves the transformation unchanged if the
+    /// velocity is not below the speed of light.
+    bool boost(const FourVector& delta);
+
+    /// @brief Rotate using x,y,z components of @a delta as rotation angles
+    ///
+    /// The rotations around x, y and z are applied in this order.
+    bool rotate(const FourVector& delta);
+
+    /// @brief Change sign of @a axis
+    bool reflect(const int axis);
+
+    /// @brief Composition, @a other is applied first
+    LorentzTransformT operator*(const LorentzTransformT& other) const;
+
+    /// @brief Matrix element, indices 0-3 are x,y,z,t
+    T operator()(const int i, const int j) const { return m_matrix[i][j]; }
+
+    /// @brief Transformed copy of @a v
+    FourVector operator()(const FourVector& v) const;
+
+    /// @brief Transform @a n four-vectors given as separate coordinate arrays
+    void apply(double* x, double* y, double* z, double* t, const size_t n) const;
+
+    /// @brief Transform all particle momenta of @a evt and, if @a positions is set, the vertex positions
+    void apply(GenEvent& evt, const bool positions = true) const;
+
+private:
+    /// @brief Apply @a m after the current transformation
+    void multiply_left(const T m[4][4]);
+
+    T m_matrix[4][4]; ///< Matrix acting on (x,y,z,t) column vectors
+};
+
+/// @brief Transformation in double precision
+typedef LorentzTransformT<double> LorentzTransform;
+
+/// @brief Transformation in extended precision
+typedef LorentzTransformT<long double> LorentzTransformLD;
+
+#ifndef __CINT__
+extern template class LorentzTransformT<double>;
+extern template class LorentzTransformT<long double>;
+#endif
+
+} // namespace HepMC3
+
+#endif
@@ -0,0 +1,106 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_MEMORYUSAGE_H
+#define HEPMC3_MEMORYUSAGE_H
+///
+/// @file  MemoryUsage.h
+/// @brief Definition of \b struct MemoryUsage and \b class MemoryUsageStatistics
+///
+/// @struct HepMC3::MemoryUsage
+/// @brief Estimated heap memory of an event or a run info, in bytes
+///
+/// Returned by GenEvent::memory_usage and GenRunInfo::memory_usage.
+/// The sizes are computed from the sizes of the objects and the capacities
+/// of the containers, so they do not include the overhead of the system
+/// allocator. Objects shared with other events, e.g. the GenRunInfo of
+/// an event, are not included.
+///
+/// @class HepMC3::MemoryUsageStatistics
+/// @brief Minimum, mean and maximum memory usage of a stream of events
+///
+/// @code
+///     MemoryUsageStatistics stats;
+///     while (reader.read_event(evt) && !reader.failed()) stats.add(evt.memory_usage());
+///     stats.print();
+/// @endcode
+///
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+namespace HepMC3 {
+
+class Attribute;
+
+struct MemoryUsage {
+    size_t particles = 0;  ///< Particle objects, their control blocks and the list of particles
+    size_t vertices = 0;   ///< Vertex objects, their control blocks and the list of vertices
+    size_t links = 0;      ///< Lists of incoming and outgoing particles of the vertices, unless stored in the vertices
+    size_t attributes = 0; ///< Attribute tables or maps and the attribute objects
+    size_t strings = 0;    ///< Text of unparsed attributes and of string attributes
+    size_t weights = 0;    ///< Event weights, or weight names of a run
+    size_t arena = 0;      ///< Blocks of the event arena, holding the particle and vertex objects
+
+    /// @brief Sum of all parts
+    size_t total() const { return particles + vertices + links + attributes + strings + weights + arena; }
+
+    /// @brief Add the parts of @a other
+    MemoryUsage& operator+=(const MemoryUsage& other);
+
+    /// @brief Add an attribute object to attributes and its text to strings
+    void add_attribute(const Attribute& att);
+
+    /// @brief Characters of @a s stored outside the string object
+    static size_t string_heap(const std::string& s);
+
+    /// @brief Control block of an object created with std::make_shared
+    static const size_t shared_overhead = 2*sizeof(void*);
+};
+
+class MemoryUsageStatistics {
+public:
+    /// @brief Add the memory usage of one event
+    void add(const MemoryUsage& usage);
+
+    /// @brief Number of events added
+    size_t count() const { return m_count; }
+
+    /// @brief Smallest value of each part
+    const MemoryUsage& min() const { return m_min; }
+
+    /// @brief Largest value of each part
+    const MemoryUsage& max() const { return m_max; }
+
+    /// @brief Sum of each part over all events
+    const MemoryUsage& sum() const { return m_sum; }
+
+    /// @brief Smallest total of an event
+    size_t min_total() const { return m_min_total; }
+
+    /// @brief Largest total of an event
+    size_t max_total() const { return m_max_total; }
+
+    /// @brief Mean value of each part
+    MemoryUsage mean() const;
+
+    /// @brief Forget all events
+    void clear() { *this = MemoryUsageStatistics(); }
+
+    /// @brief Print minimum, mean and maximum of each part
+    void print(std::ostream& os = std::cout) const;
+
+private:
+    size_t m_count = 0; ///< Number of events
+    MemoryUsage m_min;  ///< Smallest values
+    MemoryUsage m_max;  ///< Largest values
+    MemoryUsage m_sum;  ///< Sums
+    size_t m_min_total = 0; ///< Smallest total
+    size_t m_max_total = 0; ///< Largest total
+};
+
+} // namespace HepMC3
+
+#endif
@@ -0,0 +1,189 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_PARTICLELIST_H
+#define HEPMC3_PARTICLELIST_H
+///
+/// @file  ParticleList.h
+/// @brief Definition of \b class ParticleSpan and \b class ParticleList
+///
+/// @class HepMC3::ParticleSpan
+/// @brief Read-only view of the particles of a ParticleList
+///
+/// Returned by GenVertex::particles_in_span and GenVertex::particles_out_span.
+/// The view is valid until the list is changed.
+///
+/// @class HepMC3::ParticleList
+/// @brief List of particles that stores up to N of them inline
+///
+/// Most vertices have one or two incoming and a few outgoing particles.
+/// These are kept in the list itself, only longer lists are moved to the
+/// heap, where they stay when they shrink again.
+///
+/// The accessors of GenVertex that return a std::vector use vector(), which
+/// makes a copy of the list on the first call and keeps it up to date when
+/// the list changes. It is made only once, also if several threads call
+/// vector() at the same time.
+///
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "HepMC3/GenParticle_fwd.h"
+
+namespace HepMC3 {
+
+template <class P>
+class ParticleSpan {
+public:
+    typedef const P* const_iterator; ///< Iterator
+    typedef const P* iterator;       ///< Iterator, the view is read-only
+
+    /// @brief Constructor from the first particle and the number of particles
+    ParticleSpan(const P* first, const size_t& size): m_first(first), m_size(size) {}
+
+    /// @brief First particle
+    const P* begin() const { return m_first; }
+    /// @brief Past the last particle
+    const P* end() const { return m_first + m_size; }
+    /// @brief Number of particles
+    size_t size() const { return m_size; }
+    /// @brief Check if there are no particles
+    bool empty() const { return m_size == 0; }
+    /// @brief Particle @a i
+    const P& operator[](const size_t& i) const { return m_first[i]; }
+    /// @brief First particle, the view must not be empty
+    const P& front() const { return m_first[0]; }
+    /// @brief Last particle, the view must not be empty
+    const P& back() const { return m_first[m_size - 1]; }
+    /// @brief Copy of the particles
+    std::vector<P> to_vector() const { return std::vector<P>(begin(), end()); }
+
+private:
+    const P* m_first; ///< First particle
+    size_t m_size;    ///< Number of particles
+};
+
+template <size_t N>
+class ParticleList {
+public:
+    /// @brief Default constructor
+    ParticleList() {}
+
+    /// @brief Copy constructor, the copy of vector() is not copied
+    ParticleList(const ParticleList& other) { *this = other; }
+
+    /// @brief Destructor
+    ~ParticleList() { delete m_vector.load(std::memory_order_relaxed); }
+
+    /// @brief Assignment operator
+    ParticleList& operator=(const ParticleList& other) {
+        if ( this == &other ) return *this;
+        clear();
+        reserve(other.size());
+        for (const GenParticlePtr& p: other) push_back(p);
+        return *this;
+    }
+
+    /// @brief First particle
+    GenParticlePtr* begin() { return on_heap() ? m_heap.data() : m_inline; }
+    /// @brief Past the last particle
+    GenParticlePtr* end() { return begin() + size(); }
+    /// @brief First particle
+    const GenParticlePtr* begin() const { return on_heap() ? m_heap.data() : m_inline; }
+    /// @brief Past the last particle
+    const GenParticlePtr* end() const { return begin() + size(); }
+    /// @brief Number of particles
+    size_t size() const { return on_heap() ? m_heap.size() : m_size; }
+    /// @brief Check if there are no particles
+    bool empty() const { return size() == 0; }
+
+    /// @brief View of the particles
+    ParticleSpan<GenParticlePtr> span() const { return ParticleSpan<GenParticlePtr>(begin(), size()); }
+
+    /// @brief View of the particles as const particles
+    ParticleSpan<ConstGenParticlePtr> const_span() const {
+        return ParticleSpan<ConstGenParticlePtr>(reinterpret_cast<const ConstGenParticlePtr*>(begin()), size());
+    }
+
+    /// @brief Copy of the particles in a vector, made on the first call
+    const std::vector<GenParticlePtr>& vector() const {
+        std::vector<GenParticlePtr>* v = m_vector.load(std::memory_order_acquire);
+        if ( v ) return *v;
+        std::vector<GenParticlePtr>* made = new std::vector<GenParticlePtr>(begin(), end());
+        if ( m_vector.compare_exchange_strong(v, made, std::memory_order_acq_rel) ) return *made;
+        delete made;
+        return *v;
+    }
+
+    /// @brief Append @a p
+    void push_back(const GenParticlePtr& p) {
+        if ( !on_heap() && m_size < N ) m_inline[m_size++] = p;
+        else {
+            if ( !on_heap() ) move_to_heap(2*N);
+            m_heap.push_back(p);
+        }
+        std::vector<GenParticlePtr>* v = m_vector.load(std::memory_order_relaxed);
+        if ( v ) v->push_back(p);
+    }
+
+    /// @brief Remove the particles from @a first to @a last
+    void erase(GenParticlePtr* first, GenParticlePtr* last) {
+        if ( on_heap() ) {
+            m_heap.erase(m_heap.begin() + (first - m_heap.data()), m_heap.begin() + (last - m_heap.data()));
+        } else {
+            GenParticlePtr* e = std::move(last, m_inline + m_size, first);
+            for (GenParticlePtr* p = e; p != m_inline + m_size; ++p) p->reset();
+            m_size = e - m_inline;
+        }
+        update_vector();
+    }
+
+    /// @brief Remove all particles, the heap memory is kept
+    void clear() {
+        if ( on_heap() ) m_heap.clear();
+        for (size_t i = 0; i < m_size; ++i) m_inline[i].reset();
+        m_size = 0;
+        update_vector();
+    }
+
+    /// @brief Make room for @a n particles
+    void reserve(const size_t& n) {
+        if ( n <= N && !on_heap() ) return;
+        if ( !on_heap() ) move_to_heap(n);
+        else m_heap.reserve(n);
+    }
+
+    /// @brief Number of particles allocated on the heap, including the copy of vector()
+    size_t heap_capacity() const {
+        const std::vector<GenParticlePtr>* v = m_vector.load(std::memory_order_acquire);
+        return m_heap.capacity() + (v ? v->capacity() : 0);
+    }
+
+private:
+    /// @brief Check if the particles are stored on the heap
+    bool on_heap() const { return m_heap.capacity() != 0; }
+
+    /// @brief Move the inline particles to the heap, with room for @a n particles
+    void move_to_heap(const size_t& n) {
+        m_heap.reserve(std::max(n, m_size + 1));
+        for (size_t i = 0; i < m_size; ++i) m_heap.push_back(std::move(m_inline[i]));
+        m_size = 0;
+    }
+
+    /// @brief Bring the copy of vector() up to date, if there is one
+    void update_vector() {
+        std::vector<GenParticlePtr>* v = m_vector.load(std::memory_order_relaxed);
+        if ( v ) v->assign(begin(), end());
+    }
+
+    GenParticlePtr m_inline[N];          ///< Particles stored inline
+    size_t m_size = 0;                   ///< Number of particles stored inline
+    std::vector<GenParticlePtr> m_heap;  ///< Particles, once more than N were stored
+    mutable std::atomic<std::vector<GenParticlePtr>*> m_vector{nullptr}; ///< Copy made by vector()
+};
+
+} // namespace HepMC3
+#endif
@@ -12,15 +12,32 @@
 /// @class HepMC3::ReaderAscii
 /// @brief GenEvent I/O parsing for structured text files
 ///
+/// Regular files opened by name are read in large blocks and the lines
+/// are parsed in place in the block buffer. Pipes and streams passed by
+/// the user, e.g. decompressing streams, are read line by line.
+///
+/// The lines of an event are first parsed into a GenEventData, which is
+/// then turned into the event at once by GenEvent::read_data.
+///
+/// Text already in memory is parsed in place in the same way.
+///
+/// With an EventIndex of the file, see load_index, skip and seek_event
+/// go to the requested event directly.
+///
 /// @ingroup IO
 ///
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <fstream>
 #include <istream>
 #include <iterator>
 #include "HepMC3/Reader.h"
+#include "HepMC3/EventIndex.h"
 #include "HepMC3/GenEvent.h"
+#include "HepMC3/Data/GenEventData.h"
 
 
 namespace HepMC3 {
@@ -35,12 +52,37 @@ public:
     ReaderAscii(std::istream &);
     /// The ctor to read from stream. Useful for temp. streams
     ReaderAscii(std::shared_ptr<std::istream> s_stream);
+    /// The ctor to read from text in memory, e.g. a part of a file split by ReaderAsciiMT
+    explicit ReaderAscii(std::vector<char> text);
     /// @brief Destructor
     ~ReaderAscii();
 
     /// @brief skip events
     bool skip(const int)  override;
 
+    /// @brief Use an index of the events of the input file
+    ///
+    /// Reads the index from @a index_file, by default from
+    /// EventIndex::sidecar_name of the input file. If there is no index
+    /// matching the input file, the file is scanned once to build it.
+    /// Afterwards skip, seek_event and size do not read the skipped events.
+    /// Only available for regular files opened by name.
+    /// @return false if no index could be used
+    bool load_index(const std::string& index_file = std::string());
+
+    /// @brief Use @a index as index of the events of the input file
+    bool set_index(const EventIndex& index);
+
+    /// @brief Go to event number @a n in the file, counting from 0, so that it is read next
+    ///
+    /// The run information in effect for the event is read as well.
+    /// Requires an index, see load_index.
+    /// @return false if there is no index or no such event
+    bool seek_event(const size_t& n);
+
+    /// @brief Number of events in the file, -1 if there is no index
+    long size() const;
+
     /// @brief Load event from file
     ///
     /// @param[out] evt Event to be filled
@@ -67,26 +109,23 @@ private:
     /// @brief Parse event
     ///
     /// Helper routine for parsing event information
-    /// @param[out] evt Event that will be filled with new data
     /// @param[in]  buf Line of text that needs to be parsed
     /// @return vertices count and particles count for verification
-    std::pair<int,int> parse_event_information(GenEvent &evt, const char *buf);
+    std::pair<int,int> parse_event_information(const char *buf);
 
     /// @brief Parse weight value lines
     ///
     /// Helper routine for parsing weight value information
-    /// @param[out] evt Event whose GenWeights will be filled with weight values
     /// @param[in]  buf Line of text that needs to be parsed
     ///
-    bool parse_weight_values(GenEvent &evt, const char *buf);
+    bool parse_weight_values(const char *buf);
 
     /// @brief Parse units
     ///
     /// Helper routine for parsing units information
-    /// @param[out] evt Event that will be filled with unit information
     /// @param[in]  buf Line of text that needs to be parsed
     ///
-    bool parse_units(GenEvent &evt, const char *buf);
+    bool parse_units(const char *buf);
 
     /// @brief Parse struct GenPdfInfo information
     ///
@@ -111,25 +150,22 @@ private:
 
     /// @brief Parse vertex
     ///
-    /// Helper routine for parsing single event information
-    /// @param[out] evt Event that will contain parsed vertex
+    /// Helper routine for parsing single vertex information
     /// @param[in] buf Line of text that needs to be parsed
     ///
-    bool parse_vertex_information(GenEvent &evt, const char *buf);
+    bool parse_vertex_information(const char *buf);
 
     /// @brief Parse particle
     ///
     /// Helper routine for parsing single particle information
-    /// @param[out] evt Event that will contain parsed particle
     /// @param[in] buf Line of text that needs to be parsed
-    bool parse_particle_information(GenEvent &evt, const char *buf);
+    bool parse_particle_information(const char *buf);
 
     /// @brief Parse attribute
     ///
     /// Helper routine for parsing single attribute information
-    /// @param[out] evt Event that will contain parsed attribute
     /// @param[in] buf Line of text that needs to be parsed
-    bool parse_attribute(GenEvent &evt, const char *buf);
+    bool parse_attribute(const char *buf);
 
     /// @brief Parse run-level attribute.
     ///
@@ -150,6 +186,35 @@ private:
     /// tools being used.
     /// @param[in] buf Line of text that needs to be parsed
     bool parse_tool(const char *buf);
+
+    /// @brief Link incoming particle @a particle to the vertex at position @a vertex
+    void link_in(const int& particle, const int& vertex);
+
+    /// @brief Build the event from the parsed data
+    ///
+    /// Resolves the forward references, assigns the ids of the vertices
+    /// not given in the file and fills @a evt through GenEvent::read_data.
+    void build_event(GenEvent &evt);
+    /// @}
+
+    /// @name Input helpers
+    /// @{
+
+    /// @brief Read the next line
+    ///
+    /// @return Line without the end of line character, valid until the next read
+    const char* next_line();
+
+    /// @brief First character of the next line, without reading it
+    int peek_char();
+
+    /// @brief Set the state of the input, as std::ios::clear
+    void set_state(std::ios::iostate state);
+
+    /// @brief Read the next block of the file behind the unread data
+    ///
+    /// @return false if nothing could be read
+    bool fill_buffer();
     /// @}
 
 
@@ -160,14 +225,32 @@ private:
     std::istream* m_stream; ///< For ctor when reading from stream
     bool m_isstream; ///< toggles usage of m_file or m_stream
 
+    std::string m_filename;     ///< Name of the input file
+    std::vector<char> m_buffer; ///< Block buffer for files, line buffer for streams
+    int64_t m_offset;           ///< Offset in the file of the block buffer
+    size_t m_begin;             ///< Start of the unread data in the block buffer
+    size_t m_end;               ///< End of the data in the block buffer
+    bool m_blocks;              ///< The file is read in blocks
+    std::ios::iostate m_state;  ///< State of the input when reading in blocks
+    EventIndex m_index;         ///< Index of the events of the file
+    bool m_indexed;             ///< An index is used
+
 
     /** @brief Store attributes global to the run being written/read. */
     std::map< std::string, std::shared_ptr<Attribute> > m_global_attributes;
 
-    /** @brief Temp storage for  outgoing particle ids */
-    std::map<GenVertexPtr, std::set<int> >  m_forward_mothers;
-    /** @brief Temp storage for  prod vertex ids */
-    std::map<GenParticlePtr, int >  m_forward_daughters;
+    /** @brief Event being parsed, vertices in order of appearance */
+    GenEventData m_data;
+    /** @brief Vertex ids given in the file, 0 for vertices implied by particles */
+    std::vector<int> m_vertex_ids;
+    /** @brief Position of the vertices with ids given in the file */
+    std::unordered_map<int, int> m_vertex_index;
+    /** @brief Position of the end vertex of the particles parsed so far, -1 if none */
+    std::vector<int> m_end_vertices;
+    /** @brief Temp storage for incoming particles listed before being parsed, as (vertex position, particle id) */
+    std::vector<std::pair<int, int> > m_forward_mothers;
+    /** @brief Temp storage for particles listed before their production vertex, as (particle id, vertex id) */
+    std::vector<std::pair<int, int> > m_forward_daughters;
 
 };
 
@@ -79,16 +79,18 @@ private:
     /** @brief Parse vertex
      *
      *  Helper routine for parsing single event information
+     *  @param[in] evt Event that will own the vertex
      *  @param[in] buf Line of text that needs to be parsed
      */
-    int parse_vertex_information(const char *buf);
+    int parse_vertex_information(GenEvent &evt, const char *buf);
 
     /** @brief Parse particle
      *
      *  Helper routine for parsing single particle information
+     *  @param[in] evt Event that will own the particle
      *  @param[in] buf Line of text that needs to be parsed
      */
-    int parse_particle_information(const char *buf);
+    int parse_particle_information(GenEvent &evt, const char *buf);
 
     /** @brief Parse weight names
      *
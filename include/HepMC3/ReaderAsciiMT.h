@@ -0,0 +1,372 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_READERASCIIMT_H
+#define HEPMC3_READERASCIIMT_H
+///
+/// @file  ReaderAsciiMT.h
+/// @brief Definition of class \b ReaderAsciiMT
+///
+/// @class HepMC3::ReaderAsciiMT
+/// @brief Parallel GenEvent I/O parsing for structured text files
+///
+/// One thread reads the input once and splits it into chunks of events at
+/// the @c E records. A pool of worker threads parses the chunks into
+/// events, each with a ReaderAscii reading the chunk in memory. The events
+/// are delivered by read_event in the order of the file.
+///
+/// The blocks of run information are parsed by the splitting thread, so
+/// that the events of one run share the same GenRunInfo, as with
+/// ReaderAscii. The number of chunks read ahead is bounded, which limits
+/// the memory used by the reader.
+///
+/// The class is defined in the header, so that the HepMC3 library does not
+/// depend on the threads library. Programs using it have to be linked with
+/// it, e.g. with the option -pthread.
+///
+/// @ingroup IO
+///
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "HepMC3/Reader.h"
+#include "HepMC3/ReaderAscii.h"
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/Errors.h"
+
+namespace HepMC3 {
+
+class ReaderAsciiMT : public Reader {
+public:
+    /// @brief Constructor
+    ///
+    /// @param filename Input file
+    /// @param n_threads Number of threads parsing events, by default one per core
+    ReaderAsciiMT(const std::string& filename, const size_t n_threads = 0)
+        : m_file(filename, std::ios::binary), m_stream(&m_file) {
+        if ( !m_file.is_open() ) {
+            HEPMC3_ERROR("ReaderAsciiMT: could not open input file: " << filename)
+            m_failed = true;
+            return;
+        }
+        start(n_threads);
+    }
+    /// The ctor to read from stream
+    ReaderAsciiMT(std::istream& stream, const size_t n_threads = 0): m_stream(&stream) {
+        if ( !m_stream->good() ) {
+            HEPMC3_ERROR("ReaderAsciiMT: could not open input stream ")
+            m_failed = true;
+            return;
+        }
+        start(n_threads);
+    }
+    /// The ctor to read from stream. Useful for temp. streams
+    ReaderAsciiMT(std::shared_ptr<std::istream> s_stream, const size_t n_threads = 0)
+        : ReaderAsciiMT(*s_stream, n_threads) { m_shared_stream = s_stream; }
+
+    /// @brief Destructor
+    ~ReaderAsciiMT() { close(); }
+
+    /// @brief skip events
+    bool skip(const int n) override {
+        GenEvent evt;
+        for (int i = 0; i < n; ++i) if ( !read_event(evt) ) return false;
+        return !failed();
+    }
+
+    /// @brief Load the next event of the file
+    ///
+    /// Exceptions thrown while parsing the event are thrown here, as are
+    /// the ones thrown while splitting the input, after the events split
+    /// before.
+    /// @param[out] evt Event to be filled
+    bool read_event(GenEvent& evt) override {
+        while ( m_position == m_events.size() ) {
+            if ( m_failed || !m_chunk_ok ) {
+                m_failed = true;
+                return false;
+            }
+            Result result;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_done.wait(lock, [this] { return m_results.count(m_next) || m_stop || (m_split_done && m_next == m_submitted); });
+                auto it = m_results.find(m_next);
+                if ( it != m_results.end() ) {
+                    result = std::move(it->second);
+                    m_results.erase(it);
+                    ++m_next;
+                } else if ( m_split_error ) {
+                    result.error = m_split_error;
+                } else {
+                    m_failed = true;
+                    return false;
+                }
+            }
+            m_space.notify_one();
+            if ( result.error ) {
+                m_failed = true;
+                std::rethrow_exception(result.error);
+            }
+            m_events.swap(result.events);
+            m_position = 0;
+            m_chunk_ok = result.ok;
+            set_run_info(result.run_info);
+        }
+        evt = std::move(m_events[m_position++]);
+        return true;
+    }
+
+    /// @brief Return status of the reader
+    bool failed() override { return m_failed; }
+
+    /// @brief Stop the threads and close the file
+    void close() override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_work.notify_all();
+        m_space.notify_all();
+        m_done.notify_all();
+        if ( m_splitter.joinable() ) m_splitter.join();
+        for (auto& worker: m_workers) if ( worker.joinable() ) worker.join();
+        m_workers.clear();
+        if ( m_file.is_open() ) m_file.close();
+    }
+
+private:
+
+    /// @brief A chunk of the input with whole events
+    struct Chunk {
+        size_t number;                          ///< Position of the chunk in the input
+        std::vector<char> text;                 ///< Lines of the chunk, without run information
+        size_t n_events;                        ///< Number of events in the chunk
+        std::shared_ptr<GenRunInfo> run_info;   ///< Run information of the events
+    };
+
+    /// @brief The events parsed from a chunk
+    struct Result {
+        std::vector<GenEvent> events;           ///< Events
+        std::shared_ptr<GenRunInfo> run_info;   ///< Run information of the events
+        bool ok = true;                         ///< All events of the chunk were parsed
+        std::exception_ptr error;               ///< Exception thrown while parsing
+    };
+
+    /// @brief Start the threads
+    void start(size_t n_threads) {
+        if ( n_threads == 0 ) n_threads = std::thread::hardware_concurrency();
+        if ( n_threads == 0 ) n_threads = 1;
+        m_max_chunks = 2*n_threads;
+        set_run_info(std::make_shared<GenRunInfo>());
+        m_splitter = std::thread(&ReaderAsciiMT::split, this);
+        for (size_t i = 0; i < n_threads; ++i) m_workers.emplace_back(&ReaderAsciiMT::parse, this);
+    }
+
+    /// @brief Queue a chunk for the workers, waiting while too many chunks are read ahead
+    bool submit(Chunk& chunk) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_space.wait(lock, [this] { return m_stop || m_submitted - m_next < m_max_chunks; });
+        if ( m_stop ) return false;
+        chunk.number = m_submitted++;
+        m_chunks.push_back(Chunk{chunk.number, std::vector<char>(), chunk.n_events, chunk.run_info});
+        m_chunks.back().text.swap(chunk.text);
+        lock.unlock();
+        m_work.notify_one();
+        chunk.text.reserve(chunk_size + (chunk_size >> 2));
+        chunk.n_events = 0;
+        return true;
+    }
+
+    /// @brief Parse a block of run information
+    static std::shared_ptr<GenRunInfo> parse_run_info(const std::string& text) {
+        ReaderAscii reader(std::vector<char>(text.begin(), text.end()));
+        GenEvent evt;
+        reader.read_event(evt);
+        return reader.run_info();
+    }
+
+    /// @brief Run split_input in the splitting thread, keeping its exceptions for read_event
+    void split() {
+        try {
+            split_input();
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_split_error = std::current_exception();
+            }
+            finish();
+        }
+    }
+
+    /// @brief Split the input into chunks
+    ///
+    /// The lines of run information are told apart from the ones of the
+    /// events by the rules of ReaderAscii::read_event.
+    void split_input() {
+        Chunk chunk{0, std::vector<char>(), 0, run_info()};
+        chunk.text.reserve(chunk_size + (chunk_size >> 2));
+        std::string run_info_text;
+        bool event_context = false;
+        bool run_info_context = false;
+        bool parsed_weights = false;
+        bool parsed_particles_or_vertices = false;
+        std::vector<char> buffer(block_size);
+        size_t begin = 0;
+        size_t end = 0;
+        bool good = true;
+        while ( good ) {
+            // Keep the unread part of the last line, growing the buffer for lines longer than a block
+            if ( begin > 0 ) std::copy(buffer.begin() + begin, buffer.begin() + end, buffer.begin());
+            end -= begin;
+            begin = 0;
+            if ( end == buffer.size() ) buffer.resize(2*buffer.size());
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if ( m_stop ) break;
+            }
+            m_stream->read(buffer.data() + end, buffer.size() - end);
+            const size_t n = m_stream->gcount();
+            end += n;
+            good = (n > 0);
+            while ( begin < end ) {
+                const char* eol = static_cast<const char*>(memchr(buffer.data() + begin, '\n', end - begin));
+                // The last line of the input may have no end of line character
+                if ( !eol && good ) break;
+                const char* line = buffer.data() + begin;
+                const size_t length = eol ? eol + 1 - line : end - begin;
+                begin += length;
+                bool run_info_line = false;
+                switch (line[0]) {
+                case 'E':
+                    if ( !run_info_text.empty() ) {
+                        chunk.run_info = parse_run_info(run_info_text);
+                        run_info_text.clear();
+                    }
+                    if ( chunk.n_events > 0 && chunk.text.size() >= chunk_size && !submit(chunk) ) return finish();
+                    chunk.n_events++;
+                    event_context = true;
+                    run_info_context = false;
+                    parsed_weights = false;
+                    parsed_particles_or_vertices = false;
+                    break;
+                case 'V':
+                case 'P':
+                    parsed_particles_or_vertices = true;
+                    break;
+                case 'W':
+                    run_info_line = !event_context || parsed_weights;
+                    parsed_weights = true;
+                    break;
+                case 'A':
+                    run_info_line = !event_context || parsed_particles_or_vertices;
+                    break;
+                case 'T':
+                    run_info_line = true;
+                    break;
+                default:
+                    break;
+                }
+                if ( !run_info_line ) {
+                    chunk.text.insert(chunk.text.end(), line, line + length);
+                    continue;
+                }
+                // The events before a new block of run information belong to the previous run
+                if ( !run_info_context && chunk.n_events > 0 && !submit(chunk) ) return finish();
+                run_info_context = true;
+                event_context = false;
+                run_info_text.append(line, length);
+                if ( !eol ) run_info_text += '\n';
+            }
+        }
+        if ( !run_info_text.empty() ) chunk.run_info = parse_run_info(run_info_text);
+        submit(chunk);
+        finish();
+    }
+
+    /// @brief Tell the workers and the reader that there are no more chunks
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_split_done = true;
+        }
+        m_work.notify_all();
+        m_done.notify_all();
+    }
+
+    /// @brief Parse chunks into events, run by the worker threads
+    void parse() {
+        while (true) {
+            Chunk chunk;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_work.wait(lock, [this] { return m_stop || m_split_done || !m_chunks.empty(); });
+                if ( m_stop || m_chunks.empty() ) return;
+                chunk = std::move(m_chunks.front());
+                m_chunks.pop_front();
+            }
+            Result result;
+            result.run_info = chunk.run_info;
+            result.events.reserve(chunk.n_events);
+            try {
+                ReaderAscii reader(std::move(chunk.text));
+                reader.set_run_info(chunk.run_info);
+                for (size_t i = 0; i < chunk.n_events && result.ok; ++i) {
+                    result.events.emplace_back();
+                    result.ok = reader.read_event(result.events.back());
+                }
+                if ( !result.ok ) result.events.pop_back();
+            } catch (...) {
+                result.error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_results[chunk.number] = std::move(result);
+            }
+            m_done.notify_all();
+        }
+    }
+
+    /// Size of the blocks read from the input
+    static const size_t block_size = 1 << 20;
+    /// Size of the chunks of events given to the workers
+    static const size_t chunk_size = 1 << 18;
+
+    std::ifstream m_file; //!< Input file
+    std::shared_ptr<std::istream> m_shared_stream; ///< For ctor when reading from temp. stream
+    std::istream* m_stream = nullptr; ///< Input stream, read by the splitting thread
+
+    std::thread m_splitter;                 ///< Thread splitting the input
+    std::vector<std::thread> m_workers;     ///< Threads parsing the chunks
+    std::mutex m_mutex;                     ///< Guards the queues and counters below
+    std::condition_variable m_work;         ///< Signals chunks to the workers
+    std::condition_variable m_space;        ///< Signals room for chunks to the splitting thread
+    std::condition_variable m_done;         ///< Signals parsed chunks to the reader
+    std::deque<Chunk> m_chunks;             ///< Chunks waiting to be parsed
+    std::map<size_t, Result> m_results;     ///< Parsed chunks waiting to be read, by position
+    size_t m_submitted = 0;                 ///< Number of chunks split
+    size_t m_next = 0;                      ///< Position of the next chunk to read
+    size_t m_max_chunks = 1;                ///< Maximum number of chunks split and not yet read
+    bool m_split_done = false;              ///< The input is split completely
+    std::exception_ptr m_split_error;       ///< Exception thrown while splitting the input
+    bool m_stop = false;                    ///< The reader is closed
+
+    std::vector<GenEvent> m_events;         ///< Events of the chunk being read
+    size_t m_position = 0;                  ///< Position of the next event in m_events
+    bool m_chunk_ok = true;                 ///< All events of the chunk being read were parsed
+    bool m_failed = false;                  ///< No more events can be read
+};
+
+} // namespace HepMC3
+
+#endif
@@ -12,6 +12,10 @@
 /// @class HepMC3::ReaderMT
 /// @brief Multithreader GenEvent I/O parsing
 ///
+/// Each of the threads reads the whole file with its own reader and
+/// parses every N-th event. For ReaderAscii, the file is read once and
+/// split between the threads instead, see ReaderAsciiMT.
+///
 /// @ingroup IO
 ///
 #include <set>
@@ -22,6 +26,8 @@
 #include <thread>
 #include "HepMC3/Reader.h"
 #include "HepMC3/GenEvent.h"
+#include "HepMC3/ReaderAscii.h"
+#include "HepMC3/ReaderAsciiMT.h"
 namespace HepMC3 {
 template <class T, size_t m_number_of_threads>  class ReaderMT : public Reader
 {
@@ -61,7 +67,7 @@ public:
     /// @brief event reading
     bool read_event(GenEvent& evt)  override {
         if ( !m_events.empty() ) {
-            evt = m_events.back().first;
+            evt = std::move(m_events.back().first);
             m_events.pop_back();
             return true;
         }
@@ -87,7 +93,7 @@ public:
             m_go_try_cache = false;
             return false;
         }
-        evt = m_events.back().first;
+        evt = std::move(m_events.back().first);
         m_events.pop_back();
         return true;
     }
@@ -103,5 +109,13 @@ public:
         for (auto& reader: m_readers) if (reader) reader->close();
     }
 };
+
+/// @brief ReaderMT for ReaderAscii, reading the file once with ReaderAsciiMT
+template <size_t m_number_of_threads> class ReaderMT<ReaderAscii, m_number_of_threads> : public ReaderAsciiMT
+{
+public:
+    /// @brief Constructor
+    ReaderMT(const std::string& filename): ReaderAsciiMT(filename, m_number_of_threads) {}
+};
 }
 #endif
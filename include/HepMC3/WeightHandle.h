@@ -0,0 +1,132 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#ifndef HEPMC3_WEIGHTHANDLE_H
+#define HEPMC3_WEIGHTHANDLE_H
+///
+/// @file  WeightHandle.h
+/// @brief Definition of \b class WeightHandle and \b class WeightSet
+///
+/// @class HepMC3::WeightHandle
+/// @brief Index of a named event weight, resolved once from GenRunInfo
+///
+/// GenEvent::weight(const std::string&) looks the name up in the run info
+/// on every call. A handle does the lookup once, after which the weight is
+/// read by index without any checks:
+/// @code
+///     WeightHandle muR2(*run, "MUR2_MUF1");
+///     for (...) {
+///         reader.read_event(evt);
+///         if ( !muR2.valid_for(evt) ) muR2 = WeightHandle(*evt.run_info(), "MUR2_MUF1");
+///         histogram.fill(x, muR2(evt));
+///     }
+/// @endcode
+/// The handle remembers GenRunInfo::weight_names_id of the run info it was
+/// resolved from, so a cached handle can be checked cheaply against the run
+/// info of every event.
+///
+/// @class HepMC3::WeightSet
+/// @brief Indices of several named event weights, resolved once from GenRunInfo
+///
+/// Selects weights by a list of names or by a regular expression, and
+/// copies their values from an event into a caller buffer in one call.
+///
+/// @ingroup events
+///
+#include <string>
+#include <vector>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenRunInfo.h"
+
+namespace HepMC3 {
+
+class WeightHandle {
+public:
+    /// @brief Default constructor, invalid handle
+    WeightHandle(): m_index(-1), m_run_id(0) {}
+
+    /// @brief Resolve weight @a name in @a run, invalid if there is no such weight
+    WeightHandle(const GenRunInfo& run, const std::string& name);
+
+    /// @brief Check if the weight was found
+    bool valid() const { return m_index >= 0; }
+
+    /// @brief Check if the handle was resolved from the current weight names of @a run
+    bool valid_for(const GenRunInfo& run) const { return valid() && run.weight_names_id() == m_run_id; }
+
+    /// @brief Check if the handle can be used for @a evt
+    bool valid_for(const GenEvent& evt) const {
+        return evt.run_info() && valid_for(*evt.run_info()) && (size_t)m_index < evt.weights().size();
+    }
+
+    /// @brief Index of the weight in GenEvent::weights
+    int index() const { return m_index; }
+
+    /// @brief Weight of @a evt, unchecked
+    double operator()(const GenEvent& evt) const { return evt.weights()[m_index]; }
+
+    /// @brief Weight of @a evt, unchecked
+    double& operator()(GenEvent& evt) const { return evt.weights()[m_index]; }
+
+private:
+    int m_index;            ///< Index of the weight
+    unsigned long m_run_id; ///< GenRunInfo::weight_names_id at resolution
+};
+
+class WeightSet {
+public:
+    /// @brief Default constructor, empty set
+    WeightSet(): m_run_id(0), m_max_index(-1) {}
+
+    /// @brief Select the weights @a names of @a run, in this order
+    ///
+    /// Names that are not found are skipped, see names().
+    WeightSet(const GenRunInfo& run, const std::vector<std::string>& names);
+
+    /// @brief Select the weights of @a run with names matching the regular expression @a pattern
+    static WeightSet matching(const GenRunInfo& run, const std::string& pattern);
+
+    /// @brief Number of selected weights
+    size_t size() const { return m_indices.size(); }
+
+    /// @brief Check if no weight was selected
+    bool empty() const { return m_indices.empty(); }
+
+    /// @brief Names of the selected weights
+    const std::vector<std::string>& names() const { return m_names; }
+
+    /// @brief Indices of the selected weights in GenEvent::weights
+    const std::vector<int>& indices() const { return m_indices; }
+
+    /// @brief Check if the set was selected from the current weight names of @a run
+    bool valid_for(const GenRunInfo& run) const { return run.weight_names_id() == m_run_id; }
+
+    /// @brief Check if the set can be used for @a evt
+    bool valid_for(const GenEvent& evt) const {
+        return evt.run_info() && valid_for(*evt.run_info()) && m_max_index < (int)evt.weights().size();
+    }
+
+    /// @brief Weight number @a i of the set for @a evt, unchecked
+    double operator()(const GenEvent& evt, const size_t& i) const { return evt.weights()[m_indices[i]]; }
+
+    /// @brief Copy the selected weights of @a evt to @a out, which must hold size() values
+    void gather(const GenEvent& evt, double* out) const;
+
+    /// @brief Copy the selected weights of @a evt to @a out
+    void gather(const GenEvent& evt, std::vector<double>& out) const;
+
+private:
+    /// @brief Add weight number @a index of @a run
+    void add(const GenRunInfo& run, const int& index);
+
+    std::vector<int> m_indices;       ///< Indices of the weights
+    std::vector<std::string> m_names; ///< Names of the weights
+    unsigned long m_run_id;           ///< GenRunInfo::weight_names_id at selection
+    int m_max_index;                  ///< Largest index
+};
+
+} // namespace HepMC3
+
+#endif
@@ -12,9 +12,27 @@
 /// @class HepMC3::WriterAscii
 /// @brief GenEvent I/O serialization for structured text files
 ///
+/// Numbers are formatted in the buffer of the writer. The format of the
+/// floats is chosen with the option "float_printf_specifier", one of the
+/// printf conversions e (default), E, f, F, g and G, or "shortest" for the
+/// shortest representation that reads back to the same value, see set_options.
+///
+/// The floats are formatted with std::to_chars if WriterAscii.cc is compiled
+/// with C++17 and the standard library supports it for floats, e.g. from
+/// GCC 11 on. Otherwise they are formatted with sprintf, which is slower and
+/// uses the decimal point of the current C locale. The output is the same,
+/// except for "shortest", which then writes 17 significant digits. With GCC
+/// and clang, the CMake option HEPMC3_WRITERASCII_CXX17, off by default,
+/// compiles this file with C++17 also if the library uses an older standard.
+///
+/// If set_index_file was called before the first event, the writer records
+/// the byte offsets of the events it writes in an EventIndex, which is
+/// saved by close().
+///
 /// @ingroup IO
 ///
 #include "HepMC3/Writer.h"
+#include "HepMC3/EventIndex.h"
 #include "HepMC3/GenEvent.h"
 #include "HepMC3/GenRunInfo.h"
 #include <string>
@@ -52,8 +70,23 @@ public:
     bool failed()  override;
 
     /// @brief Close file stream
+    ///
+    /// Writes the index of the events if an index file was set.
     void close()  override;
 
+    /// @brief Write the index of the events to @a filename when closing
+    ///
+    /// The offsets are counted from the start of the output, e.g.
+    /// EventIndex::sidecar_name of the output file. Only the events written
+    /// after this call are recorded, so it has to precede the first event.
+    void set_index_file(const std::string& filename) { m_index_file = filename; }
+
+    /// @brief Index of the events written so far, without events unless set_index_file was called
+    const EventIndex& index() const { return m_index; }
+
+    /// @brief Set the options of the writer, see the description of the class
+    void set_options(const std::map<std::string, std::string>& options) override;
+
     /// @brief Set output precision
     ///
     /// So far available range is [2,24]. Default is 16.
@@ -89,6 +122,12 @@ private:
     /// Inline function forcing flush to the output stream
     void forced_flush();
 
+    /// Write @a length bytes to the output stream, counting them
+    void write_bytes(const char* data, const std::ptrdiff_t& length);
+
+    /// Offset in the output of the current position of the cursor
+    int64_t offset() const { return m_written + (m_cursor - m_buffer); }
+
     /// @}
 
 
@@ -101,6 +140,15 @@ private:
     /// with separately.
     void write_string( const std::string &str );
 
+    /// @brief Write integer @a value with a leading space
+    void write_int(const long long& value);
+
+    /// @brief Write floating point @a value with a leading space
+    ///
+    /// @param format printf conversion, 's' for the shortest representation that reads back to @a value
+    /// @param precision printf precision, not used for 's'
+    void write_float(const double& value, const char& format, const int& precision);
+
     /// @brief Write vertex
     ///
     /// Helper routine for writing single vertex to file
@@ -123,10 +171,11 @@ private:
     char* m_buffer;  //!< Stream buffer
     char* m_cursor;  //!< Cursor inside stream buffer
     unsigned long m_buffer_size; //!< Buffer size
-    std::string m_float_printf_specifier; //!< the specifier of printf used for floats
-    std::string m_particle_printf_specifier; //!< the specifier of printf used for floats
-    std::string m_vertex_short_printf_specifier; //!< the specifier of printf used for zero vertices
-    std::string m_vertex_long_printf_specifier; //!< the specifier of printf used for vertices
+    char m_float_format; //!< printf conversion used for floats, 's' for the shortest representation
+
+    int64_t m_written;        //!< Number of bytes written to the output stream
+    EventIndex m_index;       //!< Offsets of the events written
+    std::string m_index_file; //!< File to write the index to, if set
 };
 
 
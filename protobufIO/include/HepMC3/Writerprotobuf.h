@@ -15,6 +15,10 @@
  *  If HepMC was compiled with protobuf available, this class can be used
  *  for writing in the same manner as with HepMC::WriterAscii class.
  *
+ *  With the option "binary_attributes", attributes that implement
+ *  Attribute::to_bytes are stored in binary form instead of as strings.
+ *  Such files cannot be read by older HepMC3 versions.
+ *
  *  @ingroup IO
  *
  */
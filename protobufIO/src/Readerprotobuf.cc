@@ -368,6 +368,30 @@ bool Readerprotobuf::read_GenEvent(bool skip) {
         m_evdata.attribute_string.push_back(ged_pb.attribute_string(it));
     }
 
+    m_evdata.attribute_binary_id.clear();
+    vector_size = ged_pb.attribute_binary_id_size();
+    for (int it = 0; it < vector_size; ++it) {
+        m_evdata.attribute_binary_id.push_back(ged_pb.attribute_binary_id(it));
+    }
+
+    m_evdata.attribute_binary_name.clear();
+    vector_size = ged_pb.attribute_binary_name_size();
+    for (int it = 0; it < vector_size; ++it) {
+        m_evdata.attribute_binary_name.push_back(ged_pb.attribute_binary_name(it));
+    }
+
+    m_evdata.attribute_binary_type.clear();
+    vector_size = ged_pb.attribute_binary_type_size();
+    for (int it = 0; it < vector_size; ++it) {
+        m_evdata.attribute_binary_type.push_back(ged_pb.attribute_binary_type(it));
+    }
+
+    m_evdata.attribute_binary_bytes.clear();
+    vector_size = ged_pb.attribute_binary_bytes_size();
+    for (int it = 0; it < vector_size; ++it) {
+        m_evdata.attribute_binary_bytes.push_back(ged_pb.attribute_binary_bytes(it));
+    }
+
     m_msg_buffer.clear();
     return true;
 }
@@ -126,7 +126,7 @@ void Writerprotobuf::start_file() {
 void Writerprotobuf::write_event(const GenEvent &evt) {
 
     GenEventData data;
-    evt.write_data(data);
+    evt.write_data(data, m_options.count("binary_attributes") != 0);
 
     HepMC3_pb::GenEventData ged_pb;
     ged_pb.set_event_number(data.event_number);
@@ -209,6 +209,18 @@ void Writerprotobuf::write_event(const GenEvent &evt) {
     for (auto const &s : data.attribute_string) {
         ged_pb.add_attribute_string(s);
     }
+    for (auto const &s : data.attribute_binary_id) {
+        ged_pb.add_attribute_binary_id(s);
+    }
+    for (auto const &s : data.attribute_binary_name) {
+        ged_pb.add_attribute_binary_name(s);
+    }
+    for (auto const &s : data.attribute_binary_type) {
+        ged_pb.add_attribute_binary_type(s);
+    }
+    for (auto const &s : data.attribute_binary_bytes) {
+        ged_pb.add_attribute_binary_bytes(s);
+    }
 
     m_event_bytes_written +=
         write_message(m_out_stream, ged_pb, HepMC3_pb::MessageDigest::Event);
@@ -224,7 +224,8 @@ void bind_pyHepMC3_8(std::function< pybind11::module &(std::string const &namesp
 		cl.def("add_vertex", (void (HepMC3::GenEvent::*)(class HepMC3::GenVertex *)) &HepMC3::GenEvent::add_vertex, "Add vertex by raw pointer\n\n \n Use GenEvent::add_vertex( const GenVertexPtr& ) instead\n\nC++: HepMC3::GenEvent::add_vertex(class HepMC3::GenVertex *) --> void", pybind11::arg("v"));
 		cl.def("set_beam_particles", (void (HepMC3::GenEvent::*)(class std::shared_ptr<class HepMC3::GenParticle>, class std::shared_ptr<class HepMC3::GenParticle>)) &HepMC3::GenEvent::set_beam_particles, "Set incoming beam particles\n \n\n Backward compatibility\n\nC++: HepMC3::GenEvent::set_beam_particles(class std::shared_ptr<class HepMC3::GenParticle>, class std::shared_ptr<class HepMC3::GenParticle>) --> void", pybind11::arg("p1"), pybind11::arg("p2"));
 		cl.def("add_beam_particle", (void (HepMC3::GenEvent::*)(class std::shared_ptr<class HepMC3::GenParticle>)) &HepMC3::GenEvent::add_beam_particle, "Add  particle to root vertex\n\nC++: HepMC3::GenEvent::add_beam_particle(class std::shared_ptr<class HepMC3::GenParticle>) --> void", pybind11::arg("p1"));
-		cl.def("write_data", (void (HepMC3::GenEvent::*)(struct HepMC3::GenEventData &) const) &HepMC3::GenEvent::write_data, "Fill GenEventData object\n\nC++: HepMC3::GenEvent::write_data(struct HepMC3::GenEventData &) const --> void", pybind11::arg("data"));
+		cl.def("write_data", [](HepMC3::GenEvent const &o, struct HepMC3::GenEventData & a0) -> void { return o.write_data(a0); }, "", pybind11::arg("data"));
+		cl.def("write_data", (void (HepMC3::GenEvent::*)(struct HepMC3::GenEventData &, const bool &) const) &HepMC3::GenEvent::write_data, "Fill GenEventData object\n\n If  is set, the attributes that implement\n Attribute::to_bytes go to the binary attribute section of ,\n and only the others are converted to strings.\n\nC++: HepMC3::GenEvent::write_data(struct HepMC3::GenEventData &, const bool &) const --> void", pybind11::arg("data"), pybind11::arg("binary_attributes"));
 		cl.def("read_data", (void (HepMC3::GenEvent::*)(const struct HepMC3::GenEventData &)) &HepMC3::GenEvent::read_data, "Fill GenEvent based on GenEventData\n\nC++: HepMC3::GenEvent::read_data(const struct HepMC3::GenEventData &) --> void", pybind11::arg("data"));
 
 		 binder::custom_GenEvent_binder(cl);
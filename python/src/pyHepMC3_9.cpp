@@ -252,6 +252,10 @@ void bind_pyHepMC3_9(std::function< pybind11::module &(std::string const &namesp
 		cl.def_readwrite("attribute_id", &HepMC3::GenEventData::attribute_id);
 		cl.def_readwrite("attribute_name", &HepMC3::GenEventData::attribute_name);
 		cl.def_readwrite("attribute_string", &HepMC3::GenEventData::attribute_string);
+		cl.def_readwrite("attribute_binary_id", &HepMC3::GenEventData::attribute_binary_id);
+		cl.def_readwrite("attribute_binary_name", &HepMC3::GenEventData::attribute_binary_name);
+		cl.def_readwrite("attribute_binary_type", &HepMC3::GenEventData::attribute_binary_type);
+		cl.def_readwrite("attribute_binary_bytes", &HepMC3::GenEventData::attribute_binary_bytes);
 		cl.def("assign", (struct HepMC3::GenEventData & (HepMC3::GenEventData::*)(const struct HepMC3::GenEventData &)) &HepMC3::GenEventData::operator=, "C++: HepMC3::GenEventData::operator=(const struct HepMC3::GenEventData &) --> struct HepMC3::GenEventData &", pybind11::return_value_policy::automatic, pybind11::arg(""));
 	}
 	// HepMC3::version() file: line:20
@@ -15,6 +15,9 @@
  *  If HepMC was compiled with path to ROOT available, this class can be used
  *  for root writing in the same manner as with HepMC::WriterAscii class.
  *
+ *  With the option "binary_attributes", attributes that implement
+ *  Attribute::to_bytes are stored in binary form instead of as strings.
+ *
  *  @ingroup IO
  *
  */
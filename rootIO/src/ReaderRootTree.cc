@@ -91,6 +91,10 @@ bool ReaderRootTree::read_event(GenEvent& evt)
     m_event_data->attribute_id.clear();
     m_event_data->attribute_name.clear();
     m_event_data->attribute_string.clear();
+    m_event_data->attribute_binary_id.clear();
+    m_event_data->attribute_binary_name.clear();
+    m_event_data->attribute_binary_type.clear();
+    m_event_data->attribute_binary_bytes.clear();
 
 
     m_run_info_data->weight_names.clear();
@@ -47,7 +47,7 @@ void WriterRoot::write_event(const GenEvent &evt) {
     }
 
     GenEventData data;
-    evt.write_data(data);
+    evt.write_data(data, m_options.count("binary_attributes") != 0);
 
     std::array<char,16> buf;
     snprintf(buf.data(), buf.size(), "%15i", ++m_events_count);
@@ -81,8 +81,12 @@ void WriterRootTree::write_event(const GenEvent &evt)
     m_event_data->attribute_id.clear();
     m_event_data->attribute_name.clear();
     m_event_data->attribute_string.clear();
+    m_event_data->attribute_binary_id.clear();
+    m_event_data->attribute_binary_name.clear();
+    m_event_data->attribute_binary_type.clear();
+    m_event_data->attribute_binary_bytes.clear();
 
-    evt.write_data(*m_event_data);
+    evt.write_data(*m_event_data, m_options.count("binary_attributes") != 0);
     m_tree->Fill();
     ++m_events_count;
 }
@@ -81,7 +81,7 @@ public:
 
     /** @brief  operator */
     template<typename GenObject_type, typename std::enable_if<std::is_same<GenVertex, typename std::remove_const<typename GenObject_type::element_type>::type>::value, int*>::type = nullptr>
-    GenParticles_type<GenObject_type> operator()(GenObject_type input) const {return input->particles_in();}
+    GenParticles_type<GenObject_type> operator()(GenObject_type input) const {return input->particles_in_span().to_vector();}
 
     /** @brief  operator */
     template<typename GenObject_type, typename std::enable_if<std::is_same<GenParticle, typename std::remove_const<typename GenObject_type::element_type>::type>::value, int*>::type = nullptr>
@@ -104,7 +104,7 @@ public:
 
     /// @brief operator
     template<typename GenObject_type, typename std::enable_if<std::is_same<GenVertex, typename std::remove_const<typename GenObject_type::element_type>::type>::value, int*>::type = nullptr>
-    GenParticles_type<GenObject_type> operator()(GenObject_type input) const {return input->particles_out();}
+    GenParticles_type<GenObject_type> operator()(GenObject_type input) const {return input->particles_out_span().to_vector();}
 
     /// @brief operator
     template<typename GenObject_type, typename std::enable_if<std::is_same<GenParticle, typename std::remove_const<typename GenObject_type::element_type>::type>::value, int*>::type = nullptr>
@@ -0,0 +1,137 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+/**
+ *  @file Attribute.cc
+ *  @brief Implementation of the binary representation of the built-in attributes
+ *
+ */
+#include "HepMC3/Attribute.h"
+#include "HepMC3/AttributeBytes.h"
+#include "HepMC3/GenCrossSection.h"
+#include "HepMC3/GenHeavyIon.h"
+#include "HepMC3/GenPdfInfo.h"
+
+namespace HepMC3 {
+
+namespace {
+/// @brief Encode a single value
+template <class T>
+bool encode(std::string &bytes, const T& value) {
+    ByteWriter(bytes) << value;
+    return true;
+}
+
+/// @brief Decode a single value, the buffer must be consumed completely
+template <class T>
+bool decode(const std::string &bytes, T& value) {
+    ByteReader in(bytes);
+    in >> value;
+    return in.done();
+}
+
+/// @brief Factory of the built-in attribute types
+template <class T>
+std::shared_ptr<Attribute> create() { return std::make_shared<T>(); }
+}
+
+#define HEPMC3_ATTRIBUTE_BYTES(CLASS) \
+bool CLASS::to_bytes(std::string &bytes) const { \
+    return encode(bytes, m_val); \
+} \
+bool CLASS::from_bytes(const std::string &bytes) { \
+    if ( !decode(bytes, m_val) ) return false; \
+    set_is_parsed(true); \
+    return true; \
+}
+
+HEPMC3_ATTRIBUTE_BYTES(IntAttribute)
+HEPMC3_ATTRIBUTE_BYTES(LongAttribute)
+HEPMC3_ATTRIBUTE_BYTES(DoubleAttribute)
+HEPMC3_ATTRIBUTE_BYTES(FloatAttribute)
+HEPMC3_ATTRIBUTE_BYTES(CharAttribute)
+HEPMC3_ATTRIBUTE_BYTES(LongLongAttribute)
+HEPMC3_ATTRIBUTE_BYTES(LongDoubleAttribute)
+HEPMC3_ATTRIBUTE_BYTES(UIntAttribute)
+HEPMC3_ATTRIBUTE_BYTES(ULongAttribute)
+HEPMC3_ATTRIBUTE_BYTES(ULongLongAttribute)
+HEPMC3_ATTRIBUTE_BYTES(BoolAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorCharAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorFloatAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorLongDoubleAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorLongLongAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorUIntAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorULongAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorULongLongAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorIntAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorLongIntAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorDoubleAttribute)
+HEPMC3_ATTRIBUTE_BYTES(VectorStringAttribute)
+
+#undef HEPMC3_ATTRIBUTE_BYTES
+
+/// The string is stored as is, without size prefix
+bool StringAttribute::to_bytes(std::string &bytes) const {
+    bytes = unparsed_string();
+    return true;
+}
+
+bool StringAttribute::from_bytes(const std::string &bytes) {
+    set_unparsed_string(bytes);
+    return true;
+}
+
+std::shared_ptr<Attribute> BinaryAttribute::make(const std::string &tag) {
+    typedef std::shared_ptr<Attribute> (*creator_t)();
+    static const std::map<std::string, creator_t> creators = {
+        {"IntAttribute", &create<IntAttribute>},
+        {"LongAttribute", &create<LongAttribute>},
+        {"DoubleAttribute", &create<DoubleAttribute>},
+        {"FloatAttribute", &create<FloatAttribute>},
+        {"StringAttribute", &create<StringAttribute>},
+        {"CharAttribute", &create<CharAttribute>},
+        {"LongLongAttribute", &create<LongLongAttribute>},
+        {"LongDoubleAttribute", &create<LongDoubleAttribute>},
+        {"UIntAttribute", &create<UIntAttribute>},
+        {"ULongAttribute", &create<ULongAttribute>},
+        {"ULongLongAttribute", &create<ULongLongAttribute>},
+        {"BoolAttribute", &create<BoolAttribute>},
+        {"VectorCharAttribute", &create<VectorCharAttribute>},
+        {"VectorFloatAttribute", &create<VectorFloatAttribute>},
+        {"VectorLongDoubleAttribute", &create<VectorLongDoubleAttribute>},
+        {"VectorLongLongAttribute", &create<VectorLongLongAttribute>},
+        {"VectorUIntAttribute", &create<VectorUIntAttribute>},
+        {"VectorULongAttribute", &create<VectorULongAttribute>},
+        {"VectorULongLongAttribute", &create<VectorULongLongAttribute>},
+        {"VectorIntAttribute", &create<VectorIntAttribute>},
+        {"VectorLongIntAttribute", &create<VectorLongIntAttribute>},
+        {"VectorDoubleAttribute", &create<VectorDoubleAttribute>},
+        {"VectorStringAttribute", &create<VectorStringAttribute>},
+        {"GenCrossSection", &create<GenCrossSection>},
+        {"GenHeavyIon", &create<GenHeavyIon>},
+        {"GenPdfInfo", &create<GenPdfInfo>}
+    };
+    auto it = creators.find(tag);
+    if ( it == creators.end() ) return std::shared_ptr<Attribute>();
+    return it->second();
+}
+
+bool BinaryAttribute::from_string(const std::string &att) {
+    std::shared_ptr<Attribute> a = make(m_tag);
+    return a && a->from_string(att) && a->to_bytes(m_bytes);
+}
+
+bool BinaryAttribute::to_string(std::string &att) const {
+    std::shared_ptr<Attribute> a = make(m_tag);
+    return a && a->from_bytes(m_bytes) && a->to_string(att);
+}
+
+bool BinaryAttribute::parse(Attribute &att) const {
+    if ( !m_tag.empty() && att.type_tag() == m_tag ) return att.from_bytes(m_bytes);
+    std::string st;
+    return to_string(st) && att.from_string(st);
+}
+
+} // namespace HepMC3
@@ -0,0 +1,58 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+/**
+ *  @file AttributeKey.cc
+ *  @brief Implementation of \b class AttributeRegistry
+ *
+ */
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "HepMC3/AttributeKey.h"
+
+namespace HepMC3 {
+
+namespace {
+/// @brief Storage of the registry. The deque keeps the strings at fixed addresses.
+struct RegistryData {
+    std::mutex lock;                           ///< Protects the containers
+    std::deque<std::string> names;             ///< Names by key
+    std::unordered_map<std::string, int> keys; ///< Keys by name
+};
+
+RegistryData& registry() {
+    static RegistryData data;
+    return data;
+}
+}
+
+int AttributeRegistry::key(const std::string& name) {
+    RegistryData& r = registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+    auto it = r.keys.find(name);
+    if ( it != r.keys.end() ) return it->second;
+    const int k = r.names.size();
+    r.names.emplace_back(name);
+    r.keys.emplace(name, k);
+    return k;
+}
+
+const std::string& AttributeRegistry::name(const int& key) {
+    RegistryData& r = registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+    if ( key < 0 || key >= int(r.names.size()) ) throw std::out_of_range("AttributeRegistry::name: unknown attribute key");
+    return r.names[key];
+}
+
+int AttributeRegistry::size() {
+    RegistryData& r = registry();
+    std::lock_guard<std::mutex> lock(r.lock);
+    return r.names.size();
+}
+
+} // namespace HepMC3
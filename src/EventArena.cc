@@ -0,0 +1,80 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+/**
+ *  @file EventArena.cc
+ *  @brief Implementation of \b class EventArena
+ *
+ */
+#include <algorithm> // max
+#include <cstdint>
+#include <new>
+
+#include "HepMC3/EventArena.h"
+
+namespace HepMC3 {
+
+EventArena::EventArena(const size_t& block_size):
+    m_block_size(std::max(block_size, size_t(1024))),
+    m_current(0),
+    m_used_before(0),
+    m_cursor(nullptr),
+    m_end(nullptr),
+    m_live(0) {}
+
+EventArena::~EventArena() {
+    for (auto& b: m_blocks) ::operator delete(b.data);
+}
+
+void* EventArena::allocate(const size_t& bytes, const size_t& alignment) {
+    std::uintptr_t p = reinterpret_cast<std::uintptr_t>(m_cursor);
+    std::uintptr_t aligned = (p + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+    if ( !m_cursor || aligned + bytes > reinterpret_cast<std::uintptr_t>(m_end) ) {
+        next_block(bytes + alignment);
+        p = reinterpret_cast<std::uintptr_t>(m_cursor);
+        aligned = (p + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+    }
+    m_cursor = reinterpret_cast<char*>(aligned + bytes);
+    m_live.fetch_add(1, std::memory_order_relaxed);
+    return reinterpret_cast<void*>(aligned);
+}
+
+void EventArena::next_block(const size_t& bytes) {
+    if ( m_cursor ) {
+        m_used_before += m_cursor - m_blocks[m_current].data;
+        ++m_current;
+    }
+    // Reuse blocks kept from before the last reset, if they are large enough
+    while ( m_current < m_blocks.size() && m_blocks[m_current].size < bytes ) ++m_current;
+    if ( m_current == m_blocks.size() ) {
+        Block b;
+        b.size = std::max(bytes, m_block_size);
+        b.data = static_cast<char*>(::operator new(b.size));
+        m_blocks.push_back(b);
+    }
+    m_cursor = m_blocks[m_current].data;
+    m_end    = m_cursor + m_blocks[m_current].size;
+}
+
+void EventArena::reset() {
+    m_current     = 0;
+    m_used_before = 0;
+    if ( m_blocks.empty() ) return;
+    m_cursor = m_blocks[0].data;
+    m_end    = m_cursor + m_blocks[0].size;
+}
+
+size_t EventArena::capacity() const {
+    size_t ret = 0;
+    for (const auto& b: m_blocks) ret += b.size;
+    return ret;
+}
+
+size_t EventArena::used() const {
+    if ( !m_cursor ) return 0;
+    return m_used_before + (m_cursor - m_blocks[m_current].data);
+}
+
+} // namespace HepMC3
@@ -0,0 +1,145 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+/**
+ *  @file EventIndex.cc
+ *  @brief Implementation of \b class EventIndex
+ *
+ */
+#include <algorithm>
+#include <fstream>
+
+#include "HepMC3/EventIndex.h"
+#include "HepMC3/Errors.h"
+
+namespace HepMC3 {
+
+namespace {
+const char* header = "HepMC3::EventIndex";
+}
+
+EventIndex EventIndex::scan(const std::string& filename) {
+    EventIndex index;
+    std::ifstream file(filename, std::ios::binary);
+    if ( !file.is_open() ) {
+        HEPMC3_ERROR("EventIndex::scan: could not open input file: " << filename)
+        return index;
+    }
+    // Same rules as ReaderAscii::read_event for the end of an event
+    bool event_context = false;
+    bool run_info_context = false;
+    bool parsed_weights = false;
+    bool parsed_particles_or_vertices = false;
+    bool line_start = true;
+    int64_t offset = 0;
+    std::vector<char> buffer(1 << 20);
+    while ( file.read(buffer.data(), buffer.size()) || file.gcount() > 0 ) {
+        const size_t n = file.gcount();
+        for (size_t i = 0; i < n; ++i) {
+            const char c = buffer[i];
+            if ( !line_start ) {
+                line_start = (c == '\n');
+                continue;
+            }
+            line_start = (c == '\n');
+            bool run_info = false;
+            switch (c) {
+            case 'E':
+                index.add_event(offset + i);
+                event_context = true;
+                run_info_context = false;
+                parsed_weights = false;
+                parsed_particles_or_vertices = false;
+                break;
+            case 'V':
+            case 'P':
+                parsed_particles_or_vertices = true;
+                break;
+            case 'W':
+                run_info = !event_context || parsed_weights;
+                parsed_weights = true;
+                break;
+            case 'A':
+                run_info = !event_context || parsed_particles_or_vertices;
+                break;
+            case 'T':
+                run_info = true;
+                break;
+            default:
+                break;
+            }
+            if ( run_info && !run_info_context ) {
+                index.add_run_info(offset + i);
+                run_info_context = true;
+                event_context = false;
+            }
+        }
+        offset += n;
+    }
+    index.set_file_size(offset);
+    return index;
+}
+
+bool EventIndex::read(const std::string& filename) {
+    std::ifstream file(filename);
+    if ( !file.is_open() ) return false;
+    std::string tag;
+    int64_t file_size = -1;
+    if ( !(file >> tag >> file_size) || tag != header ) {
+        HEPMC3_WARNING("EventIndex::read: " << filename << " is not an event index")
+        return false;
+    }
+    EventIndex index;
+    index.set_file_size(file_size);
+    char type = 0;
+    int64_t offset = 0;
+    while ( file >> type >> offset ) {
+        if ( type == 'E' ) index.add_event(offset);
+        else if ( type == 'R' ) index.add_run_info(offset);
+        else {
+            HEPMC3_WARNING("EventIndex::read: unknown entry " << type << " in " << filename)
+            return false;
+        }
+    }
+    if ( !file.eof() ) return false;
+    *this = index;
+    return true;
+}
+
+bool EventIndex::write(const std::string& filename) const {
+    std::ofstream file(filename);
+    if ( !file.is_open() ) {
+        HEPMC3_ERROR("EventIndex::write: could not open output file: " << filename)
+        return false;
+    }
+    file << header << " " << m_file_size << "\n";
+    size_t r = 0;
+    for (size_t i = 0; i <= m_events.size(); ++i) {
+        for (; r < m_run_infos.size() && m_run_info_first[r] == i; ++r) file << "R " << m_run_infos[r] << "\n";
+        if ( i < m_events.size() ) file << "E " << m_events[i] << "\n";
+    }
+    return (bool)file;
+}
+
+void EventIndex::add_run_info(const int64_t& offset) {
+    m_run_infos.push_back(offset);
+    m_run_info_first.push_back(m_events.size());
+}
+
+size_t EventIndex::event_at(const int64_t& offset) const {
+    return std::lower_bound(m_events.begin(), m_events.end(), offset) - m_events.begin();
+}
+
+int64_t EventIndex::run_info_offset(const size_t& i) const {
+    const size_t r = std::upper_bound(m_run_info_first.begin(), m_run_info_first.end(), i) - m_run_info_first.begin();
+    return r ? m_run_infos[r - 1] : -1;
+}
+
+int64_t EventIndex::run_info_before(const int64_t& offset) const {
+    const size_t r = std::upper_bound(m_run_infos.begin(), m_run_infos.end(), offset - 1) - m_run_infos.begin();
+    return r ? m_run_infos[r - 1] : -1;
+}
+
+} // namespace HepMC3
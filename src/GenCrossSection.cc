@@ -14,6 +14,7 @@
 #include <sstream>
 
 #include "HepMC3/GenCrossSection.h"
+#include "HepMC3/AttributeBytes.h"
 #include "HepMC3/GenEvent.h"
 
 
@@ -104,6 +105,21 @@ bool GenCrossSection::to_string(std::string &att) const {
     return true;
 }
 
+std::shared_ptr<Attribute> GenCrossSection::clone() const {
+    return clone_exact<GenCrossSection>();
+}
+
+bool GenCrossSection::to_bytes(std::string &bytes) const {
+    ByteWriter(bytes) << accepted_events << attempted_events << cross_sections << cross_section_errors;
+    return true;
+}
+
+bool GenCrossSection::from_bytes(const std::string &bytes) {
+    ByteReader in(bytes);
+    in >> accepted_events >> attempted_events >> cross_sections >> cross_section_errors;
+    return in.done();
+}
+
 bool GenCrossSection::operator==(const GenCrossSection& a) const {
     return ( memcmp( (void*)this, (void*) &a, sizeof(class GenCrossSection) ) == 0 );
 }
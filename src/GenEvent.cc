@@ -9,10 +9,18 @@
  *
  */
 #include <algorithm> // sort
+#include <cmath>
+#include <cstring>
 #include <deque>
+#include <limits>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "HepMC3/Data/CompactEventData.h"
 #include "HepMC3/Data/GenEventData.h"
 #include "HepMC3/GenEvent.h"
+#include "HepMC3/LorentzTransform.h"
 #include "HepMC3/GenParticle.h"
 #include "HepMC3/GenVertex.h"
 
@@ -46,16 +54,20 @@ const std::vector<ConstGenVertexPtr>& GenEvent::vertices() const {
 
 
 void GenEvent::add_particle(GenParticlePtr p) {
+    if ( refuse_change("GenEvent::add_particle") ) return;
     if ( !p || p->in_event() ) return;
+    invalidate_positions();
 
     m_particles.emplace_back(p);
 
     p->m_event = this;
     p->m_id = particles().size();
 
-    // Particles without production vertex are added to the root vertex
-    if ( !p->production_vertex() ) {
-        m_rootvertex->add_particle_out(p);
+    // Particles without production vertex are added to the root vertex.
+    // They cannot be in its list yet, so the search for duplicates is skipped.
+    if ( p->m_production_vertex.expired() ) {
+        root_vertex()->m_particles_out.push_back(p);
+        p->m_production_vertex = m_rootvertex;
     }
 }
 
@@ -73,8 +85,8 @@ GenEvent::GenEvent(const GenEvent&e) {
 }
 
 GenEvent::~GenEvent() {
-    for ( auto attm = m_attributes.begin(); attm != m_attributes.end(); ++attm) {
-        for ( auto att = attm->second.begin(); att != attm->second.end(); ++att) { if (att->second) att->second->m_event = nullptr;}
+    for ( auto& table: m_attributes ) {
+        for ( auto& att: table.entries ) { if (att.second) att.second->m_event = nullptr;}
     }
     for  ( auto v = m_vertices.begin(); v != m_vertices.end(); ++v ) if (*v)  if ((*v)->m_event == this) (*v)->m_event = nullptr;
     for  ( auto p = m_particles.begin(); p != m_particles.end(); ++p ) if (*p)  if ((*p)->m_event == this)  (*p)->m_event = nullptr;
@@ -93,29 +105,282 @@ GenEvent& GenEvent::operator=(const GenEvent& e) {
     return *this;
 }
 
+// As for the standard containers, the source of a move must not be used
+// concurrently, so nothing is locked and nothing is allocated
+GenEvent::GenEvent(GenEvent&& e) noexcept {
+    move_from(e);
+}
+
+GenEvent& GenEvent::operator=(GenEvent&& e) noexcept {
+    if ( refuse_change("GenEvent::operator=") ) return *this;
+    if (this != &e)
+    {
+        // Release the current content as the destructor does
+        for (const AttributeTable& table: m_attributes) for (const att_val_t& vt2: table.entries) if (vt2.second) vt2.second->m_event = nullptr;
+        for (const auto& v: m_vertices) if (v && v->m_event == this) v->m_event = nullptr;
+        for (const auto& p: m_particles) if (p && p->m_event == this) p->m_event = nullptr;
+        move_from(e);
+    }
+    return *this;
+}
+
+void GenEvent::move_from(GenEvent& e) {
+    m_particles     = std::move(e.m_particles);
+    m_vertices      = std::move(e.m_vertices);
+    m_event_number  = e.m_event_number;
+    m_weights       = std::move(e.m_weights);
+    m_momentum_unit = e.m_momentum_unit;
+    m_length_unit   = e.m_length_unit;
+    m_rootvertex    = std::move(e.m_rootvertex);
+    m_run_info      = std::move(e.m_run_info);
+    m_attributes    = std::move(e.m_attributes);
+    m_arena         = std::move(e.m_arena);
+    m_recycling     = e.m_recycling;
+    m_free_particles = std::move(e.m_free_particles);
+    m_free_vertices  = std::move(e.m_free_vertices);
+    m_free_strings   = std::move(e.m_free_strings);
+    m_frozen.store(e.is_frozen(), std::memory_order_release);
+    e.m_frozen.store(false, std::memory_order_release);
+    invalidate_positions();
+    e.invalidate_positions();
+
+    // Leave the source empty but usable
+    e.m_particles.clear();
+    e.m_vertices.clear();
+    e.m_weights.clear();
+    e.m_attributes.clear();
+    e.m_free_particles.clear();
+    e.m_free_vertices.clear();
+    e.m_free_strings.clear();
+    e.m_rootvertex.reset();
+
+    // Re-point the back-pointers to this event
+    for (const auto& p: m_particles) p->m_event = this;
+    for (const auto& v: m_vertices) v->m_event = this;
+    for (const AttributeTable& table: m_attributes) for (const att_val_t& vt2: table.entries) if (vt2.second) vt2.second->m_event = this;
+}
+
+GenEvent GenEvent::clone() const {
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    GenEvent ret(m_momentum_unit, m_length_unit);
+    ret.m_event_number = m_event_number;
+    ret.m_weights      = m_weights;
+    ret.m_run_info     = m_run_info;
+    ret.m_rootvertex->set_position(event_pos());
+
+    ret.m_particles.reserve(m_particles.size());
+    ret.m_vertices.reserve(m_vertices.size());
+    for (const auto& p: m_particles) {
+        ret.m_particles.emplace_back(ret.make_particle(p->data()));
+        ret.m_particles.back()->m_event = &ret;
+        ret.m_particles.back()->m_id    = ret.m_particles.size();
+    }
+    for (const auto& v: m_vertices) {
+        ret.m_vertices.emplace_back(ret.make_vertex(v->data()));
+        ret.m_vertices.back()->m_event = &ret;
+        ret.m_vertices.back()->m_id    = -(int)ret.m_vertices.size();
+    }
+
+    // Restore links in the original order
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        ret.m_vertices[i]->reserve(m_vertices[i]->m_particles_in.size(), m_vertices[i]->m_particles_out.size());
+        for (const auto& p: m_vertices[i]->particles_in_span()) {
+            if ( p->parent_event() == this ) ret.m_vertices[i]->add_particle_in(ret.m_particles[p->id() - 1]);
+        }
+        for (const auto& p: m_vertices[i]->particles_out_span()) {
+            if ( p->parent_event() == this ) ret.m_vertices[i]->add_particle_out(ret.m_particles[p->id() - 1]);
+        }
+    }
+    for (auto& p: ret.m_particles) if (!p->production_vertex()) ret.m_rootvertex->add_particle_out(p);
+
+    // Copy attributes, through strings only if the attribute cannot be cloned
+    ret.m_attributes.reserve(m_attributes.size());
+    for (const AttributeTable& table: m_attributes) {
+        AttributeTable target = { table.key, table.name, std::vector<att_val_t>() };
+        target.entries.reserve(table.entries.size());
+        for (const att_val_t& vt2: table.entries) {
+            if (!vt2.second) continue;
+            std::shared_ptr<Attribute> att = vt2.second->clone();
+            if (!att) {
+                std::string st;
+                if ( !vt2.second->to_string(st) ) {
+                    HEPMC3_WARNING("GenEvent::clone: problem serializing attribute: " << *table.name)
+                    continue;
+                }
+                att = std::make_shared<StringAttribute>(st);
+            }
+            const int id = vt2.first;
+            att->m_particle.reset();
+            att->m_vertex.reset();
+            ret.attach_attribute(att, id);
+            target.entries.emplace_back(id, att);
+        }
+        ret.m_attributes.emplace_back(std::move(target));
+    }
+    return ret;
+}
+
+
+void GenEvent::merge(const GenEvent& other, const FourVector& shift) {
+    if ( refuse_change("GenEvent::merge") ) return;
+    if ( &other == this ) return;
+    m_particles.reserve(m_particles.size() + other.m_particles.size());
+    m_vertices.reserve(m_vertices.size() + other.m_vertices.size());
+    append(other, shift);
+}
+
+void GenEvent::merge(const std::vector<const GenEvent*>& others, const std::vector<FourVector>& shifts) {
+    if ( refuse_change("GenEvent::merge") ) return;
+    if ( !shifts.empty() && shifts.size() != others.size() ) {
+        HEPMC3_WARNING("GenEvent::merge: number of shifts does not match the number of events. Ignored.")
+        return;
+    }
+    size_t n_particles = m_particles.size(), n_vertices = m_vertices.size();
+    for (const GenEvent* other: others) {
+        if ( !other || other == this ) continue;
+        n_particles += other->m_particles.size();
+        n_vertices += other->m_vertices.size();
+    }
+    m_particles.reserve(n_particles);
+    m_vertices.reserve(n_vertices);
+    for (size_t i = 0; i < others.size(); ++i) {
+        if ( !others[i] || others[i] == this ) continue;
+        append(*others[i], shifts.empty() ? FourVector::ZERO_VECTOR() : shifts[i]);
+    }
+}
+
+void GenEvent::append(const GenEvent& other, const FourVector& shift) {
+    invalidate_positions();
+    std::lock(m_lock_attributes, other.m_lock_attributes);
+    std::lock_guard<std::recursive_mutex> lhs_lk(m_lock_attributes, std::adopt_lock);
+    std::lock_guard<std::recursive_mutex> rhs_lk(other.m_lock_attributes, std::adopt_lock);
+    const int particle_offset = m_particles.size();
+    const int vertex_offset = m_vertices.size();
+
+    GenParticleData pd;
+    for (const GenParticlePtr& p: other.m_particles) {
+        pd = p->m_data;
+        Units::convert(pd.momentum, other.m_momentum_unit, m_momentum_unit);
+        if ( pd.is_mass_set ) Units::convert(pd.mass, other.m_momentum_unit, m_momentum_unit);
+        m_particles.emplace_back(make_particle(pd));
+        m_particles.back()->m_event = this;
+        m_particles.back()->m_id    = m_particles.size();
+    }
+
+    GenVertexData vd;
+    for (const GenVertexPtr& v: other.m_vertices) {
+        vd.status   = v->m_data.status;
+        vd.position = v->position();
+        Units::convert(vd.position, other.m_length_unit, m_length_unit);
+        vd.position += shift;
+        m_vertices.emplace_back(make_vertex(vd));
+        GenVertexPtr& nv = m_vertices.back();
+        nv->m_event = this;
+        nv->m_id    = -(int)m_vertices.size();
+        nv->m_particles_in.reserve(v->m_particles_in.size());
+        nv->m_particles_out.reserve(v->m_particles_out.size());
+        for (const GenParticlePtr& p: v->m_particles_in) {
+            if ( p->parent_event() != &other ) continue;
+            const GenParticlePtr& np = m_particles[particle_offset + p->id() - 1];
+            nv->m_particles_in.push_back(np);
+            np->m_end_vertex = nv;
+        }
+        for (const GenParticlePtr& p: v->m_particles_out) {
+            if ( p->parent_event() != &other ) continue;
+            const GenParticlePtr& np = m_particles[particle_offset + p->id() - 1];
+            nv->m_particles_out.push_back(np);
+            np->m_production_vertex = nv;
+        }
+    }
+    for (size_t i = particle_offset; i < m_particles.size(); ++i) {
+        GenParticlePtr& p = m_particles[i];
+        if ( !p->m_production_vertex.expired() ) continue;
+        root_vertex()->m_particles_out.push_back(p);
+        p->m_production_vertex = m_rootvertex;
+    }
+
+    std::unordered_map<int, int> index;
+    other.index_vertices(index);
+
+    // Copy the particle and vertex attributes with the new ids, which
+    // come before (vertices) and after (particles) the existing ones
+    std::vector<att_val_t> vertex_entries;
+    for (const AttributeTable& table: other.m_attributes) {
+        if ( table.entries.empty() ) continue;
+        AttributeTable& target = attribute_table(*table.name);
+        vertex_entries.clear();
+        for (const att_val_t& vt2: table.entries) {
+            if ( !vt2.second || vt2.first == 0 ) continue;
+            std::shared_ptr<Attribute> att = vt2.second->clone();
+            if (!att) {
+                std::string st;
+                if ( !vt2.second->to_string(st) ) {
+                    HEPMC3_WARNING("GenEvent::merge: problem serializing attribute: " << *table.name)
+                    continue;
+                }
+                att = std::make_shared<StringAttribute>(st);
+            }
+            int id = vt2.first;
+            if ( id > 0 ) {
+                if ( id > (int)other.m_particles.size() ) continue;
+                id += particle_offset;
+            } else {
+                const int i = other.vertex_index(id, index);
+                if ( i < 0 ) continue;
+                id = -(vertex_offset + i) - 1;
+            }
+            att->m_particle.reset();
+            att->m_vertex.reset();
+            attach_attribute(att, id);
+            if ( id < 0 ) vertex_entries.emplace_back(id, att);
+            else target.set(id, att);
+        }
+        if ( !index.empty() ) {
+            std::sort(vertex_entries.begin(), vertex_entries.end(),
+                      [](const att_val_t& a, const att_val_t& b) { return a.first < b.first; });
+        }
+        target.entries.insert(target.entries.begin(), vertex_entries.begin(), vertex_entries.end());
+    }
+}
 
 void GenEvent::add_vertex(GenVertexPtr v) {
+    if ( refuse_change("GenEvent::add_vertex") ) return;
     if ( !v|| v->in_event() ) return;
+    invalidate_positions();
     m_vertices.emplace_back(v);
 
     v->m_event = this;
     v->m_id = -(int)vertices().size();
 
     // Add all incoming and outgoing particles and restore their production/end vertices
-    for (const auto& p: v->particles_in()) {
+    for (const auto& p: v->particles_in_span()) {
         if (!p->in_event()) add_particle(p);
         p->m_end_vertex = v->shared_from_this();
     }
 
-    for (const auto& p: v->particles_out()) {
+    for (const auto& p: v->particles_out_span()) {
         if (!p->in_event()) add_particle(p);
         p->m_production_vertex = v;
     }
 }
 
 
+GenVertexPtr GenEvent::add_vertex(const std::vector<GenParticlePtr>& particles_in,
+                                  const std::vector<GenParticlePtr>& particles_out,
+                                  const FourVector& position) {
+    if ( refuse_change("GenEvent::add_vertex") ) return GenVertexPtr();
+    GenVertexPtr v = make_vertex(position);
+    v->add_particles_in(particles_in);
+    v->add_particles_out(particles_out);
+    add_vertex(v);
+    return v;
+}
+
+
 void GenEvent::remove_particle(GenParticlePtr p) {
+    if ( refuse_change("GenEvent::remove_particle") ) return;
     if ( !p || p->parent_event() != this ) return;
+    invalidate_positions();
 
     HEPMC3_DEBUG(30, "GenEvent::remove_particle - called with particle: " << p->id());
     GenVertexPtr end_vtx = p->end_vertex();
@@ -123,7 +388,7 @@ void GenEvent::remove_particle(GenParticlePtr p) {
         end_vtx->remove_particle_in(p);
 
         // If that was the only incoming particle, remove vertex from the event
-        if ( end_vtx->particles_in().empty() )  remove_vertex(end_vtx);
+        if ( end_vtx->particles_in_span().empty() )  remove_vertex(end_vtx);
     }
 
     GenVertexPtr prod_vtx = p->production_vertex();
@@ -131,7 +396,7 @@ void GenEvent::remove_particle(GenParticlePtr p) {
         prod_vtx->remove_particle_out(p);
 
         // If that was the only outgoing particle, remove vertex from the event
-        if ( prod_vtx->particles_out().empty() ) remove_vertex(prod_vtx);
+        if ( prod_vtx->particles_out_span().empty() ) remove_vertex(prod_vtx);
     }
 
     HEPMC3_DEBUG(30, "GenEvent::remove_particle - erasing particle: " << p->id())
@@ -141,60 +406,342 @@ void GenEvent::remove_particle(GenParticlePtr p) {
 
     // Remove attributes of this particle
     std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-    for (att_key_t& vt1: m_attributes) {
-        auto vt2 = vt1.second.find(idx);
-        if (vt2 == vt1.second.end()) continue;
-        vt1.second.erase(vt2);
+    for (AttributeTable& table: m_attributes) {
+        table.erase(idx);
+
+        //
+        // Reassign id of attributes with id above this one, the order is kept
+        //
+        auto vt2 = std::upper_bound(table.entries.begin(), table.entries.end(), idx,
+                                    [](const int& i, const att_val_t& a) { return i < a.first; });
+        for (; vt2 != table.entries.end(); ++vt2) --(vt2->first);
+    }
+    // Reassign id of particles with id above this one
+    for (; it != m_particles.end(); ++it) {
+        --((*it)->m_id);
     }
 
-    //
-    // Reassign id of attributes with id above this one
-    //
-    std::vector< std::pair< int, std::shared_ptr<Attribute> > > changed_attributes;
+    // Finally - set parent event and id of this particle to 0
+    p->m_event = nullptr;
+    p->m_id    = 0;
+}
+
+void GenEvent::remove_particles(std::vector<GenParticlePtr> v) {
+    remove_bulk(v);
+}
 
-    for (att_key_t& vt1: m_attributes) {
-        changed_attributes.clear();
+GenEvent::IdMap GenEvent::remove_bulk(const std::vector<GenParticlePtr>& particles, const std::vector<GenVertexPtr>& vertices) {
+    if ( refuse_change("GenEvent::remove_bulk") ) return IdMap();
+    normalize_vertex_ids();
+    std::vector<char> particle_removed(m_particles.size(), 0);
+    std::vector<char> vertex_removed(m_vertices.size(), 0);
+
+    // Number of incoming and outgoing particles of each vertex that are still there
+    std::vector<int> in_left(m_vertices.size());
+    std::vector<int> out_left(m_vertices.size());
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        in_left[i]  = m_vertices[i]->particles_in_span().size();
+        out_left[i] = m_vertices[i]->particles_out_span().size();
+    }
 
-        for (auto vt2 = vt1.second.begin(); vt2 != vt1.second.end(); ++vt2) {
-            if ( (*vt2).first > p->id() ) {
-                changed_attributes.emplace_back(*vt2);
+    std::vector<GenParticlePtr> stack;
+    auto mark_particle = [&](const GenParticlePtr& p) {
+        if ( !p || p->parent_event() != this || particle_removed[p->id() - 1] ) return;
+        particle_removed[p->id() - 1] = 1;
+        stack.emplace_back(p);
+    };
+    // Same as remove_vertex: the outgoing sub-trees go together with the vertex
+    auto mark_vertex = [&](const GenVertexPtr& v) {
+        if ( !v || v->parent_event() != this || vertex_removed[-v->id() - 1] ) return;
+        vertex_removed[-v->id() - 1] = 1;
+        for (const auto& p: v->particles_out_span()) mark_particle(p);
+    };
+
+    for (const auto& v: vertices) mark_vertex(v);
+    for (const auto& p: particles) mark_particle(p);
+
+    // Same rules as remove_particle: drop vertices left without incoming or outgoing particles
+    while ( !stack.empty() ) {
+        GenParticlePtr p = stack.back();
+        stack.pop_back();
+
+        GenVertexPtr end_vtx = p->end_vertex();
+        if ( end_vtx && end_vtx->parent_event() == this && --in_left[-end_vtx->id() - 1] == 0 ) mark_vertex(end_vtx);
+
+        GenVertexPtr prod_vtx = p->production_vertex();
+        if ( prod_vtx && prod_vtx->parent_event() == this && --out_left[-prod_vtx->id() - 1] == 0 ) mark_vertex(prod_vtx);
+    }
+
+    return compact(particle_removed, vertex_removed);
+}
+
+GenEvent::IdMap GenEvent::prune(const std::function<bool(ConstGenParticlePtr)>& keep) {
+    if ( refuse_change("GenEvent::prune") ) return IdMap();
+    normalize_vertex_ids();
+    const size_t n = m_particles.size();
+    const size_t m = m_vertices.size();
+    std::vector<char> particle_removed(n, 0);
+    std::vector<char> vertex_removed(m, 0);
+    for (size_t i = 0; i < n; ++i) particle_removed[i] = !keep(m_particles[i]);
+
+    // Union-find of the vertices joined by removed particles. Node 0 stands
+    // for the root vertex or no vertex and is never merged, node i+1 is the
+    // vertex i. The smallest node of a set is its representative.
+    std::vector<size_t> parent(m + 1);
+    std::vector<std::vector<size_t> > members(m + 1);
+    // Number of particles entering each set from outside of it
+    std::vector<int> in_edges(m + 1, 0);
+    for (size_t k = 0; k <= m; ++k) {
+        parent[k] = k;
+        if ( k == 0 ) continue;
+        members[k].assign(1, k);
+        in_edges[k] = m_vertices[k - 1]->m_particles_in.size();
+    }
+    auto find = [&](size_t k) {
+        while ( parent[k] != k ) k = parent[k] = parent[parent[k]];
+        return k;
+    };
+    auto node = [&](const GenVertexPtr& v) -> size_t {
+        if ( !v || v->parent_event() != this ) return 0;
+        return -v->id();
+    };
+
+    // Removed particles that no longer link their vertices
+    std::vector<char> dropped(n, 0);
+    // Check if the set b is reached from the set a other than through particle skip
+    std::vector<size_t> visited(m + 1, 0);
+    size_t search = 0;
+    std::vector<size_t> stack;
+    auto reachable = [&](const size_t& a, const size_t& b, const size_t& skip) {
+        ++search;
+        visited[a] = search;
+        stack.assign(1, a);
+        while ( !stack.empty() ) {
+            const size_t k = stack.back();
+            stack.pop_back();
+            for (const size_t& w: members[k]) {
+                for (const GenParticlePtr& p: m_vertices[w - 1]->m_particles_out) {
+                    if ( p->parent_event() != this ) continue;
+                    const size_t i = p->id() - 1;
+                    if ( i == skip || dropped[i] ) continue;
+                    const size_t e = node(p->end_vertex());
+                    if ( e == 0 ) continue;
+                    const size_t r = find(e);
+                    if ( r == b ) return true;
+                    if ( visited[r] != search ) {
+                        visited[r] = search;
+                        stack.emplace_back(r);
+                    }
+                }
             }
         }
+        return false;
+    };
+
+    for (size_t i = 0; i < n; ++i) {
+        if ( !particle_removed[i] ) continue;
+        const GenParticlePtr& p = m_particles[i];
+        const size_t e = node(p->end_vertex());
+        if ( e == 0 ) continue;
+        const size_t b = find(e);
+        const size_t a = find(node(p->production_vertex()));
+        // Removed beams are detached from their end vertex, which is never
+        // merged into the root vertex. If the end vertex can be reached from
+        // the production vertex in another way, merging them would close a
+        // loop, so the particle is only dropped and the ancestry is kept
+        // through the other way.
+        if ( a == 0 || (in_edges[b] > 1 && reachable(a, b, i)) ) {
+            dropped[i] = 1;
+            in_edges[b]--;
+            continue;
+        }
+        const size_t r = std::min(a, b);
+        const size_t o = std::max(a, b);
+        parent[o] = r;
+        in_edges[r] = in_edges[a] + in_edges[b] - 1;
+        if ( members[r].size() < members[o].size() ) members[r].swap(members[o]);
+        members[r].insert(members[r].end(), members[o].begin(), members[o].end());
+        members[o].clear();
+    }
 
-        for ( const auto& val: changed_attributes ) {
-            vt1.second.erase(val.first);
-            vt1.second[val.first-1] = val.second;
+    // Move the surviving particles of every vertex to its representative
+    for (size_t k = 1; k <= m; ++k) {
+        const size_t r = find(k);
+        if ( r == k ) continue;
+        const GenVertexPtr& from = m_vertices[k - 1];
+        const GenVertexPtr& to = m_vertices[r - 1];
+        for (const GenParticlePtr& p: from->m_particles_in) {
+            if ( p->parent_event() != this || particle_removed[p->id() - 1] ) continue;
+            to->m_particles_in.push_back(p);
+            p->m_end_vertex = to;
+        }
+        for (const GenParticlePtr& p: from->m_particles_out) {
+            if ( p->parent_event() != this || particle_removed[p->id() - 1] ) continue;
+            to->m_particles_out.push_back(p);
+            p->m_production_vertex = to;
         }
+        from->m_particles_in.clear();
+        from->m_particles_out.clear();
+        vertex_removed[k - 1] = 1;
     }
-    // Reassign id of particles with id above this one
-    for (; it != m_particles.end(); ++it) {
-        --((*it)->m_id);
+
+    // Drop the vertices without surviving outgoing particles
+    for (size_t i = 0; i < m; ++i) {
+        if ( vertex_removed[i] ) continue;
+        bool has_out = false;
+        for (const GenParticlePtr& p: m_vertices[i]->m_particles_out) {
+            if ( p->parent_event() == this && !particle_removed[p->id() - 1] ) { has_out = true; break; }
+        }
+        if ( !has_out ) vertex_removed[i] = 1;
     }
 
-    // Finally - set parent event and id of this particle to 0
-    p->m_event = nullptr;
-    p->m_id    = 0;
+    return compact(particle_removed, vertex_removed);
 }
 
-void GenEvent::remove_particles(std::vector<GenParticlePtr> v) {
-    std::sort(v.begin(), v.end(), [](const GenParticlePtr& p1, const GenParticlePtr& p2) { return p1->id() > p2->id();});
+void GenEvent::index_vertices(std::unordered_map<int, int>& index) const {
+    index.clear();
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        if ( m_vertices[i]->id() == -(int)i - 1 ) continue;
+        for (size_t j = 0; j < m_vertices.size(); ++j) index[m_vertices[j]->id()] = j;
+        break;
+    }
+}
+
+int GenEvent::vertex_index(const int& id, const std::unordered_map<int, int>& index) const {
+    if ( index.empty() ) return id < 0 && -id - 1 < (int)m_vertices.size() ? -id - 1 : -1;
+    auto it = index.find(id);
+    return it == index.end() ? -1 : it->second;
+}
+
+int GenEvent::vertex_index(const GenVertex* v, const std::unordered_map<int, int>& index) const {
+    if ( !v || v->parent_event() != this ) return -1;
+    const int i = vertex_index(v->id(), index);
+    // A vertex held after clear keeps its id, which may belong to another vertex by now
+    return i >= 0 && m_vertices[i].get() == v ? i : -1;
+}
+
+void GenEvent::normalize_vertex_ids() {
+    bool in_order = true;
+    for (size_t i = 0; i < m_vertices.size() && in_order; ++i) in_order = m_vertices[i]->id() == -(int)i - 1;
+    if ( in_order ) return;
+
+    invalidate_positions();
+    std::unordered_map<int, int> new_ids;
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        new_ids[m_vertices[i]->id()] = -(int)i - 1;
+        m_vertices[i]->m_id = -(int)i - 1;
+    }
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    for (AttributeTable& table: m_attributes) {
+        size_t n = 0;
+        for (size_t i = 0; i < table.entries.size(); ++i) {
+            att_val_t& entry = table.entries[i];
+            if ( entry.first < 0 ) {
+                auto it = new_ids.find(entry.first);
+                // Attributes of vertices that are not in the event are dropped
+                if ( it == new_ids.end() ) continue;
+                entry.first = it->second;
+            }
+            if ( n != i ) table.entries[n] = std::move(entry);
+            ++n;
+        }
+        table.entries.resize(n);
+        std::stable_sort(table.entries.begin(), table.entries.end(),
+                         [](const att_val_t& a, const att_val_t& b) { return a.first < b.first; });
+    }
+}
+
+GenEvent::IdMap GenEvent::compact(const std::vector<char>& particle_removed, const std::vector<char>& vertex_removed) {
+    invalidate_positions();
+    IdMap ret;
+    ret.particles.resize(m_particles.size(), 0);
+    ret.vertices.resize(m_vertices.size(), 0);
+
+    auto is_removed = [&](const GenParticlePtr& p) {
+        return p->parent_event() == this && particle_removed[p->id() - 1];
+    };
+
+    // Cut the links of the remaining vertices to removed particles
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        if ( vertex_removed[i] ) continue;
+        auto& in  = m_vertices[i]->m_particles_in;
+        auto& out = m_vertices[i]->m_particles_out;
+        in.erase(std::remove_if(in.begin(), in.end(), is_removed), in.end());
+        out.erase(std::remove_if(out.begin(), out.end(), is_removed), out.end());
+    }
+    auto& beams = root_vertex()->m_particles_out;
+    beams.erase(std::remove_if(beams.begin(), beams.end(), is_removed), beams.end());
+
+    // Renumber particles
+    size_t n_particles = 0;
+    for (size_t i = 0; i < m_particles.size(); ++i) {
+        GenParticlePtr& p = m_particles[i];
+        if ( particle_removed[i] ) {
+            p->m_production_vertex.reset();
+            p->m_end_vertex.reset();
+            p->m_event = nullptr;
+            p->m_id    = 0;
+            continue;
+        }
+        GenVertexPtr end_vtx = p->end_vertex();
+        if ( end_vtx && end_vtx->parent_event() == this && vertex_removed[-end_vtx->id() - 1] ) p->m_end_vertex.reset();
+        if ( n_particles != i ) m_particles[n_particles] = std::move(p);
+        ret.particles[i] = ++n_particles;
+        m_particles[n_particles - 1]->m_id = n_particles;
+    }
+
+    // Renumber vertices
+    size_t n_vertices = 0;
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        GenVertexPtr& v = m_vertices[i];
+        if ( vertex_removed[i] ) {
+            v->m_event = nullptr;
+            v->m_id    = 0;
+            continue;
+        }
+        if ( n_vertices != i ) m_vertices[n_vertices] = std::move(v);
+        ret.vertices[i] = -(int)(++n_vertices);
+        m_vertices[n_vertices - 1]->m_id = ret.vertices[i];
+    }
+
+    const int removed_particles = m_particles.size() - n_particles;
+    const int removed_vertices  = m_vertices.size() - n_vertices;
+    m_particles.resize(n_particles);
+    m_vertices.resize(n_vertices);
 
-    for (auto p = v.begin(); p != v.end(); ++p) {
-        remove_particle(*p);
+    // Renumber attributes. The renumbering keeps the order of the ids,
+    // so the tables are compacted in place.
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    for (AttributeTable& table: m_attributes) {
+        size_t n = 0;
+        for (size_t i = 0; i < table.entries.size(); ++i) {
+            int id = table.entries[i].first;
+            if ( id > 0 ) id = ( id <= int(ret.particles.size()) ) ? ret.particles[id - 1] : id - removed_particles;
+            else if ( id < 0 ) id = ( -id <= int(ret.vertices.size()) ) ? ret.vertices[-id - 1] : id + removed_vertices;
+            // Event attributes keep id 0, removed objects are mapped to 0
+            if ( id == 0 && table.entries[i].first != 0 ) continue;
+            if ( n != i ) table.entries[n].second = std::move(table.entries[i].second);
+            table.entries[n++].first = id;
+        }
+        table.entries.resize(n);
     }
+
+    return ret;
 }
 
 void GenEvent::remove_vertex(GenVertexPtr v) {
+    if ( refuse_change("GenEvent::remove_vertex") ) return;
     if ( !v || v->parent_event() != this ) return;
+    invalidate_positions();
 
     HEPMC3_DEBUG(30, "GenEvent::remove_vertex   - called with vertex:  " << v->id());
     std::shared_ptr<GenVertex> null_vtx;
 
-    for (const auto& p: v->particles_in()) {
+    for (const auto& p: v->particles_in_span()) {
         p->m_end_vertex = std::weak_ptr<GenVertex>();
     }
 
-    for (const auto& p: v->particles_out()) {
+    for (const auto& p: v->particles_out_span()) {
         p->m_production_vertex = std::weak_ptr<GenVertex>();
 
         // recursive delete rest of the tree
@@ -208,31 +755,13 @@ void GenEvent::remove_vertex(GenVertexPtr v) {
     auto it = m_vertices.erase(m_vertices.begin() + idx-1);
     // Remove attributes of this vertex
     std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-    for (att_key_t& vt1: m_attributes) {
-        auto vt2 = vt1.second.find(-idx);
-        if (vt2 == vt1.second.end()) continue;
-        vt1.second.erase(vt2);
-    }
-
-    //
-    // Reassign id of attributes with id below this one
-    //
-
-    std::vector< std::pair< int, std::shared_ptr<Attribute> > > changed_attributes;
+    for (AttributeTable& table: m_attributes) {
+        table.erase(-idx);
 
-    for ( att_key_t& vt1: m_attributes ) {
-        changed_attributes.clear();
-
-        for (auto vt2 = vt1.second.begin(); vt2 != vt1.second.end(); ++vt2) {
-            if ( (*vt2).first < v->id() ) {
-                changed_attributes.emplace_back(*vt2);
-            }
-        }
-
-        for ( const auto& val: changed_attributes ) {
-            vt1.second.erase(val.first);
-            vt1.second[val.first+1] = val.second;
-        }
+        //
+        // Reassign id of attributes with id below this one, the order is kept
+        //
+        for (auto vt2 = table.entries.begin(); vt2 != table.entries.end() && vt2->first < -idx; ++vt2) ++(vt2->first);
     }
 
     // Reassign id of particles with id above this one
@@ -244,60 +773,30 @@ void GenEvent::remove_vertex(GenVertexPtr v) {
     v->m_event = nullptr;
     v->m_id    = 0;
 }
-/// @todo This looks dangerously similar to the recusive event traversel that we forbade in the
-///       Core library due to wories about generator dependence
-static bool visit_children(std::map<ConstGenVertexPtr, int>  &a, const ConstGenVertexPtr& v)
-{
-    for (const ConstGenParticlePtr& p: v->particles_out()) {
-        if (p->end_vertex())
-        {
-            if (a[p->end_vertex()] != 0) { return true; }
-            a[p->end_vertex()]++;
-            if (visit_children(a, p->end_vertex())) return true;
-        }
-    }
-    return false;
-}
-
 void GenEvent::add_tree(const std::vector<GenParticlePtr> &parts) {
+    if ( refuse_change("GenEvent::add_tree") ) return;
+    invalidate_positions();
     m_particles.reserve(m_particles.size() + parts.size());
     m_vertices.reserve(m_vertices.size() + parts.size());
     std::shared_ptr<IntAttribute> existing_hc = attribute<IntAttribute>("cycles");
-    bool has_cycles = false;
-    std::map<GenVertexPtr, int>  sortingv;
-    std::vector<GenVertexPtr> noinv;
-    if (existing_hc)     if (existing_hc->value() != 0) has_cycles = true;
-    if (!existing_hc)
-    {
-        for (const GenParticlePtr& p: parts) {
-            GenVertexPtr v = p->production_vertex();
-            if (v) sortingv[v]=0;
-            if ( !v || v->particles_in().empty()) {
-                GenVertexPtr v2 = p->end_vertex();
-                if (v2) {noinv.emplace_back(v2); sortingv[v2] = 0;}
-            }
-        }
-        for (const GenVertexPtr& v: noinv) {
-            std::map<ConstGenVertexPtr, int>  sorting_temp(sortingv.begin(), sortingv.end());
-            has_cycles = (has_cycles || visit_children(sorting_temp, v));
-        }
-    }
-    if (has_cycles) {
-        add_attribute("cycles", std::make_shared<IntAttribute>(1));
-        /* Commented out  as improvemnts allow us to do sorting in other way.
-         for ( std::map<GenVertexPtr,int>::iterator vi=sortingv.begin();vi!=sortingv.end();++vi) if ( !vi->first->in_event() ) add_vertex(vi->first);
-         return;
-         */
-    }
+    bool has_cycles = existing_hc && existing_hc->value() != 0;
 
+    // Vertices are queued once, and waiting while their mothers are added first.
+    // Meeting a waiting vertex among the mothers means that the tree has a cycle.
+    enum { QUEUED = 1, WAITING = 2 };
+    std::unordered_map<const GenVertex*, int> state;
+    state.reserve(2*parts.size());
     std::deque<GenVertexPtr> sorting;
 
     // Find all starting vertices (end vertex of particles that have no production vertex)
     for (const auto& p: parts) {
         const GenVertexPtr &v = p->production_vertex();
-        if ( !v || v->particles_in().empty() ) {
+        if ( !v || v->particles_in_span().empty() ) {
             const GenVertexPtr &v2 = p->end_vertex();
-            if (v2) sorting.emplace_back(v2);
+            if ( v2 ) {
+                state[v2.get()] |= QUEUED;
+                sorting.emplace_back(v2);
+            }
         }
     }
 
@@ -313,57 +812,69 @@ void GenEvent::add_tree(const std::vector<GenParticlePtr> &parts) {
             ++sorting_loop_count;
         )
 
-            GenVertexPtr &v = sorting.front();
+        GenVertexPtr v = sorting.front();
+        if ( v->in_event() ) {
+            sorting.pop_front();
+            continue;
+        }
 
         bool added = false;
 
         // Add all mothers to the front of the list
-        for (const auto& p: v->particles_in() ) {
+        for (const auto& p: v->particles_in_span() ) {
             GenVertexPtr v2 = p->production_vertex();
-            if ( v2 && !v2->in_event() && find(sorting.begin(), sorting.end(), v2) == sorting.end() ) {
-                sorting.push_front(v2);
-                added = true;
+            if ( !v2 || v2->in_event() ) continue;
+            int& s = state[v2.get()];
+            if ( s & WAITING ) {
+                has_cycles = true;
+                continue;
             }
+            s |= QUEUED;
+            sorting.push_front(v2);
+            added = true;
         }
 
         // If we have added at least one production vertex,
         // our vertex is not the first one on the list
-        if ( added ) continue;
-
-        // If vertex not yet added
-        if ( !v->in_event() ) {
-            add_vertex(v);
-
-            // Add all end vertices to the end of the list
-            for (const auto& p: v->particles_out()) {
-                GenVertexPtr v2 = p->end_vertex();
-                if ( v2 && !v2->in_event()&& find(sorting.begin(), sorting.end(), v2) == sorting.end() ) {
-                    sorting.emplace_back(v2);
-                }
-            }
+        if ( added ) {
+            state[v.get()] |= WAITING;
+            continue;
         }
 
+        add_vertex(v);
+        state[v.get()] &= ~WAITING;
         sorting.pop_front();
+
+        // Add all end vertices to the end of the list
+        for (const auto& p: v->particles_out_span()) {
+            GenVertexPtr v2 = p->end_vertex();
+            if ( !v2 || v2->in_event() ) continue;
+            int& s = state[v2.get()];
+            if ( s & QUEUED ) continue;
+            s |= QUEUED;
+            sorting.emplace_back(v2);
+        }
     }
 
+    if ( has_cycles ) add_attribute("cycles", std::make_shared<IntAttribute>(1));
+
     // LL: Make sure root vertex has index zero and is not written out
-    if ( m_rootvertex->id() != 0 ) {
+    if ( m_rootvertex && m_rootvertex->id() != 0 ) {
         const int vx = -1 - m_rootvertex->id();
         const int rootid = m_rootvertex->id();
         if ( vx >= 0 && vx < (int) m_vertices.size() && m_vertices[vx] == m_rootvertex ) {
             auto next = m_vertices.erase(m_vertices.begin() + vx);
             std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-            for (auto & vt1: m_attributes) {
-                std::vector< std::pair< int, std::shared_ptr<Attribute> > > changed_attributes;
-                for ( const auto& vt2 : vt1.second ) {
-                    if ( vt2.first <= rootid ) {
-                        changed_attributes.emplace_back(vt2);
-                    }
-                }
-                for ( const auto& val : changed_attributes ) {
-                    vt1.second.erase(val.first);
-                    vt1.second[val.first == rootid? 0: val.first + 1] = val.second;
+            for (AttributeTable& table: m_attributes) {
+                // Attributes of the root vertex become event attributes
+                std::shared_ptr<Attribute> root_att;
+                std::shared_ptr<Attribute>* slot = table.find(rootid);
+                if ( slot ) {
+                    root_att = *slot;
+                    table.erase(rootid);
                 }
+                for (auto vt2 = table.entries.begin(); vt2 != table.entries.end() && vt2->first < rootid; ++vt2) ++(vt2->first);
+                if ( root_att ) table.set(0, root_att);
             }
             m_rootvertex->set_id(0);
             while ( next != m_vertices.end() ) {
@@ -387,8 +898,207 @@ void GenEvent::reserve(const size_t& parts, const size_t& verts) {
     m_vertices.reserve(verts);
 }
 
+MemoryUsage GenEvent::memory_usage() const {
+    MemoryUsage usage;
+    // Objects in the arena are accounted for by the size of the arena
+    const size_t particle_size = m_arena ? 0 : sizeof(GenParticle) + MemoryUsage::shared_overhead;
+    const size_t vertex_size = m_arena ? 0 : sizeof(GenVertex) + MemoryUsage::shared_overhead;
+    if ( m_arena ) usage.arena = m_arena->capacity();
+
+    usage.particles = m_particles.capacity()*sizeof(GenParticlePtr) + m_particles.size()*particle_size;
+    usage.vertices = m_vertices.capacity()*sizeof(GenVertexPtr) + (m_vertices.size() + 1)*vertex_size;
+    usage.vertices += m_positions.capacity()*sizeof(const FourVector*);
+    usage.links = m_rootvertex ? (m_rootvertex->m_particles_in.heap_capacity() + m_rootvertex->m_particles_out.heap_capacity())*sizeof(GenParticlePtr) : 0;
+    for (const GenVertexPtr& v: m_vertices) {
+        usage.links += (v->m_particles_in.heap_capacity() + v->m_particles_out.heap_capacity())*sizeof(GenParticlePtr);
+    }
+    usage.weights = m_weights.capacity()*sizeof(double);
+
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    usage.attributes = m_attributes.capacity()*sizeof(AttributeTable);
+    for (const AttributeTable& table: m_attributes) {
+        usage.attributes += table.entries.capacity()*sizeof(att_val_t);
+        for (const att_val_t& entry: table.entries) if ( entry.second ) usage.add_attribute(*entry.second);
+    }
+    return usage;
+}
+
+
+namespace {
+
+/// @brief Incremental 64-bit digest, independent of the byte order of the platform
+class Digest {
+public:
+    /// @brief Add an integer
+    void add(const std::uint64_t& v) {
+        std::uint64_t k = v*0x87c37b91114253d5ULL;
+        k = (k << 31) | (k >> 33);
+        m_h ^= k*0x4cf5ad432745937fULL;
+        m_h = ((m_h << 27) | (m_h >> 37))*5 + 0x52dce729;
+    }
+
+    /// @brief Add a signed integer
+    void add_int(const int& v) { add(std::uint64_t(std::int64_t(v))); }
+
+    /// @brief Add a double by its bit pattern, with -0 taken as 0
+    void add_double(const double& v) {
+        const double x = v == 0.0 ? 0.0 : v;
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        add(bits);
+    }
+
+    /// @brief Add a four-vector
+    void add_vector(const FourVector& v) {
+        add_double(v.x());
+        add_double(v.y());
+        add_double(v.z());
+        add_double(v.t());
+    }
+
+    /// @brief Add a string, in chunks of eight characters
+    void add_string(const std::string& s) {
+        add(std::uint64_t(s.size()));
+        std::uint64_t chunk = 0;
+        for (size_t i = 0; i < s.size(); ++i) {
+            chunk = (chunk << 8) | (unsigned char)s[i];
+            if ( i%8 == 7 ) { add(chunk); chunk = 0; }
+        }
+        if ( s.size()%8 ) add(chunk);
+    }
+
+    /// @brief Final value
+    std::uint64_t value() const {
+        std::uint64_t h = m_h;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+private:
+    std::uint64_t m_h = 0x9e3779b97f4a7c15ULL; ///< Current state
+};
+
+/// @brief Sorted ids of @a particles, so that the order of attachment does not matter
+template <class L>
+void sorted_ids(const L& particles, std::vector<int>& ids) {
+    ids.clear();
+    for (const auto& p: particles) ids.push_back(p->id());
+    std::sort(ids.begin(), ids.end());
+}
+
+/// @brief Compare two values with a tolerance relative to their magnitude, or absolute below one
+bool close(const double& a, const double& b, const double& tolerance) {
+    if ( a == b ) return true;
+    return std::abs(a - b) <= tolerance*std::max(1.0, std::max(std::abs(a), std::abs(b)));
+}
+
+/// @brief Compare two four-vectors componentwise, see close
+bool close(const FourVector& a, const FourVector& b, const double& tolerance) {
+    return close(a.x(), b.x(), tolerance) && close(a.y(), b.y(), tolerance) &&
+           close(a.z(), b.z(), tolerance) && close(a.t(), b.t(), tolerance);
+}
+
+/// @brief String form of the attributes of @a evt, without names that have no entries
+std::map<std::string, std::map<int, std::string> > attribute_strings(const GenEvent& evt) {
+    std::map<std::string, std::map<int, std::string> > ret;
+    for (const auto& table: evt.attributes()) {
+        for (const auto& entry: table.second) {
+            if ( !entry.second ) continue;
+            entry.second->to_string(ret[table.first][entry.first]);
+        }
+    }
+    return ret;
+}
+
+} // namespace
+
+std::uint64_t GenEvent::hash(const bool& with_attributes) const {
+    Digest digest;
+    digest.add_int(m_momentum_unit);
+    digest.add_int(m_length_unit);
+
+    digest.add(std::uint64_t(m_particles.size()));
+    for (const GenParticlePtr& p: m_particles) {
+        const GenParticleData& data = p->m_data;
+        digest.add_int(data.pid);
+        digest.add_int(data.status);
+        digest.add_vector(data.momentum);
+        // Writers store the momentum mass if no generated mass is set
+        digest.add_double(p->generated_mass());
+    }
+
+    digest.add_vector(event_pos());
+    digest.add(std::uint64_t(m_vertices.size()));
+    std::vector<int> ids;
+    for (const GenVertexPtr& v: m_vertices) {
+        digest.add_int(v->m_data.status);
+        digest.add_vector(v->m_data.position);
+        sorted_ids(v->m_particles_in, ids);
+        digest.add(std::uint64_t(ids.size()));
+        for (const int& id: ids) digest.add_int(id);
+        sorted_ids(v->m_particles_out, ids);
+        digest.add(std::uint64_t(ids.size()));
+        for (const int& id: ids) digest.add_int(id);
+    }
+
+    digest.add(std::uint64_t(m_weights.size()));
+    for (const double& w: m_weights) digest.add_double(w);
+
+    if ( with_attributes ) {
+        for (const auto& table: attribute_strings(*this)) {
+            digest.add_string(table.first);
+            digest.add(std::uint64_t(table.second.size()));
+            for (const auto& entry: table.second) {
+                digest.add_int(entry.first);
+                digest.add_string(entry.second);
+            }
+        }
+    }
+    return digest.value();
+}
+
+bool equivalent(const GenEvent& a, const GenEvent& b, const double& tolerance, const bool& with_attributes) {
+    if ( &a == &b ) return true;
+    if ( a.momentum_unit() != b.momentum_unit() || a.length_unit() != b.length_unit() ) return false;
+    if ( a.particles().size() != b.particles().size() || a.vertices().size() != b.vertices().size() ) return false;
+    if ( a.weights().size() != b.weights().size() ) return false;
+
+    for (size_t i = 0; i < a.particles().size(); ++i) {
+        const ConstGenParticlePtr& pa = a.particles()[i];
+        const ConstGenParticlePtr& pb = b.particles()[i];
+        if ( pa->pid() != pb->pid() || pa->status() != pb->status() ) return false;
+        if ( !close(pa->momentum(), pb->momentum(), tolerance) ) return false;
+        if ( !close(pa->generated_mass(), pb->generated_mass(), tolerance) ) return false;
+    }
+
+    if ( !close(a.event_pos(), b.event_pos(), tolerance) ) return false;
+    std::vector<int> ids_a, ids_b;
+    for (size_t i = 0; i < a.vertices().size(); ++i) {
+        const ConstGenVertexPtr& va = a.vertices()[i];
+        const ConstGenVertexPtr& vb = b.vertices()[i];
+        if ( va->status() != vb->status() ) return false;
+        if ( !close(va->data().position, vb->data().position, tolerance) ) return false;
+        sorted_ids(va->particles_in_span(), ids_a);
+        sorted_ids(vb->particles_in_span(), ids_b);
+        if ( ids_a != ids_b ) return false;
+        sorted_ids(va->particles_out_span(), ids_a);
+        sorted_ids(vb->particles_out_span(), ids_b);
+        if ( ids_a != ids_b ) return false;
+    }
+
+    for (size_t i = 0; i < a.weights().size(); ++i) {
+        if ( !close(a.weights()[i], b.weights()[i], tolerance) ) return false;
+    }
+
+    return !with_attributes || attribute_strings(a) == attribute_strings(b);
+}
 
 void GenEvent::set_units(Units::MomentumUnit new_momentum_unit, Units::LengthUnit new_length_unit) {
+    if ( refuse_change("GenEvent::set_units") ) return;
     if ( new_momentum_unit != m_momentum_unit ) {
         for ( GenParticlePtr& p: m_particles ) {
             Units::convert(p->m_data.momentum, m_momentum_unit, new_momentum_unit);
@@ -410,27 +1120,107 @@ void GenEvent::set_units(Units::MomentumUnit new_momentum_unit, Units::LengthUni
 
 
 const FourVector& GenEvent::event_pos() const {
-    return m_rootvertex->data().position;
+    return m_rootvertex ? m_rootvertex->data().position : FourVector::ZERO_VECTOR();
+}
+
+void GenEvent::resolve_positions() const {
+    if ( m_positions_valid.load(std::memory_order_acquire) ) return;
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    if ( m_positions_valid.load(std::memory_order_relaxed) ) return;
+
+    std::shared_ptr<IntAttribute> cycles = attribute<IntAttribute>("cycles");
+    // The ancestors are not searched in events with cycles
+    const bool search_ancestors = !cycles || cycles->value() == 0;
+    const FourVector* origin = &event_pos();
+
+    const size_t n = m_vertices.size();
+    m_positions.assign(n, nullptr);
+    index_vertices(m_position_index);
+    std::vector<char> on_path(n, 0);
+    std::vector<size_t> path;
+    for (size_t i = 0; i < n; ++i) {
+        // Walk up the first production vertices until a known position is found
+        size_t k = i;
+        const FourVector* found = nullptr;
+        while ( !found ) {
+            if ( m_positions[k] ) { found = m_positions[k]; break; }
+            const GenVertexPtr& v = m_vertices[k];
+            if ( v->has_set_position() ) { found = m_positions[k] = &v->data().position; break; }
+            path.push_back(k);
+            on_path[k] = 1;
+            if ( !search_ancestors ) { found = origin; break; }
+            GenVertexPtr pv;
+            for (const GenParticlePtr& p: v->m_particles_in) {
+                pv = p->production_vertex();
+                if ( pv ) break;
+            }
+            if ( !pv || pv == m_rootvertex ) { found = origin; break; }
+            if ( pv->parent_event() != this ) { found = &pv->position(); break; }
+            const size_t j = position_index(pv.get());
+            // Vertex held outside the event when it was cleared
+            if ( j == n ) { found = pv->has_set_position() ? &pv->data().position : origin; break; }
+            // Unflagged cycle
+            if ( on_path[j] ) { found = origin; break; }
+            k = j;
+        }
+        for (const size_t& l: path) { m_positions[l] = found; on_path[l] = 0; }
+        path.clear();
+    }
+    m_positions_valid.store(true, std::memory_order_release);
+}
+
+size_t GenEvent::position_index(const GenVertex* v) const {
+    const int i = vertex_index(v, m_position_index);
+    return i < 0 ? m_vertices.size() : i;
+}
+
+const FourVector& GenEvent::resolved_position(const GenVertex* v) const {
+    resolve_positions();
+    size_t i = position_index(v);
+    if ( i < m_positions.size() ) return *m_positions[i];
+
+    // The vertex is no longer in the event: walk up its first production
+    // vertices until a position is set or a vertex of the event is reached
+    std::unordered_set<const GenVertex*> seen;
+    ConstGenVertexPtr held;
+    while ( seen.insert(v).second ) {
+        if ( v->has_set_position() ) return v->data().position;
+        ConstGenVertexPtr pv;
+        for (const GenParticlePtr& p: v->m_particles_in) {
+            pv = p->production_vertex();
+            if ( pv ) break;
+        }
+        if ( !pv || pv == m_rootvertex ) break;
+        if ( pv->parent_event() != this ) return pv->position();
+        i = position_index(pv.get());
+        if ( i < m_positions.size() ) return *m_positions[i];
+        held = pv;
+        v = held.get();
+    }
+    return event_pos();
 }
 
 std::vector<ConstGenParticlePtr> GenEvent::beams(const int status) const {
-    if (!status) return std::const_pointer_cast<const GenVertex>(m_rootvertex)->particles_out();
+    if (!m_rootvertex) return std::vector<ConstGenParticlePtr>();
+    if (!status) return std::const_pointer_cast<const GenVertex>(m_rootvertex)->particles_out_span().to_vector();
     std::vector<ConstGenParticlePtr> ret;
-    for (auto p: m_rootvertex->particles_out()) if (p->status() == status) ret.emplace_back(p);
+    for (auto p: m_rootvertex->particles_out_span()) if (p->status() == status) ret.emplace_back(p);
     return ret;
 }
 
 std::vector<ConstGenParticlePtr> GenEvent::beams() const {
-    return std::const_pointer_cast<const GenVertex>(m_rootvertex)->particles_out();
+    if (!m_rootvertex) return std::vector<ConstGenParticlePtr>();
+    return std::const_pointer_cast<const GenVertex>(m_rootvertex)->particles_out_span().to_vector();
 }
 
 
 const std::vector<GenParticlePtr> & GenEvent::beams() {
-    return m_rootvertex->particles_out();
+    return root_vertex()->particles_out();
 }
 
 void GenEvent::shift_position_by(const FourVector & delta) {
-    m_rootvertex->set_position(event_pos() + delta);
+    if ( refuse_change("GenEvent::shift_position_by") ) return;
+    root_vertex()->set_position(event_pos() + delta);
 
     // Offset all vertices
     for ( GenVertexPtr& v: m_vertices ) {
@@ -442,201 +1232,305 @@ void GenEvent::shift_position_by(const FourVector & delta) {
 
 bool GenEvent::rotate(const FourVector&  delta)
 {
-    for ( auto& p: m_particles)
-    {
-        const FourVector& mom = p->momentum();
-        long double tempX = mom.x();
-        long double tempY = mom.y();
-        long double tempZ = mom.z();
-
-        long double cosa = std::cos(delta.x());
-        long double sina = std::sin(delta.x());
-
-        long double tempY_ = cosa*tempY+sina*tempZ;
-        long double tempZ_ = -sina*tempY+cosa*tempZ;
-        tempY = tempY_;
-        tempZ = tempZ_;
-
-
-        long double cosb = std::cos(delta.y());
-        long double sinb = std::sin(delta.y());
-
-        long double tempX_ = cosb*tempX-sinb*tempZ;
-        tempZ_ = sinb*tempX+cosb*tempZ;
-        tempX = tempX_;
-        tempZ = tempZ_;
+    if ( refuse_change("GenEvent::rotate") ) return false;
+    LorentzTransformLD transform;
+    transform.rotate(delta);
+    transform.apply(*this);
+    return true;
+}
 
-        long double cosg = std::cos(delta.z());
-        long double sing = std::sin(delta.z());
+bool GenEvent::reflect(const int axis)
+{
+    if ( refuse_change("GenEvent::reflect") ) return false;
+    LorentzTransform transform;
+    if ( !transform.reflect(axis) ) return false;
+    transform.apply(*this);
+    return true;
+}
 
-        tempX_ = cosg*tempX+sing*tempY;
-        tempY_ = -sing*tempX+cosg*tempY;
-        tempX = tempX_;
-        tempY = tempY_;
+bool GenEvent::boost(const FourVector&  delta)
+{
+    if ( refuse_change("GenEvent::boost") ) return false;
+    LorentzTransformLD transform;
+    if ( !transform.boost(delta) ) return false;
+    // Only the momenta are boosted
+    transform.apply(*this, false);
+    return true;
+}
 
-        FourVector temp(tempX, tempY, tempZ, mom.e());
-        p->set_momentum(temp);
+void GenEvent::clear() {
+    if ( refuse_change("GenEvent::clear") ) return;
+    invalidate_positions();
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    m_event_number = 0;
+    m_weights.clear();
+    if ( m_recycling ) {
+        recycle();
+        return;
     }
-    for (auto& v: m_vertices)
-    {
-        const FourVector& pos = v->position();
-        long double tempX = pos.x();
-        long double tempY = pos.y();
-        long double tempZ = pos.z();
-
-        long double cosa = std::cos(delta.x());
-        long double sina = std::sin(delta.x());
-
-        long double tempY_ = cosa*tempY+sina*tempZ;
-        long double tempZ_ = -sina*tempY+cosa*tempZ;
-        tempY = tempY_;
-        tempZ = tempZ_;
-
-
-        long double cosb = std::cos(delta.y());
-        long double sinb = std::sin(delta.y());
-
-        long double tempX_ = cosb*tempX-sinb*tempZ;
-        tempZ_ = sinb*tempX+cosb*tempZ;
-        tempX = tempX_;
-        tempZ = tempZ_;
+    m_rootvertex.reset();
+    m_attributes.clear();
+    m_particles.clear();
+    m_vertices.clear();
+    if ( m_arena ) {
+        // Objects still referenced from outside keep the old arena alive
+        if ( m_arena->live() == 0 ) m_arena->reset();
+        else m_arena = std::make_shared<EventArena>(m_arena->block_size());
+    }
+    m_rootvertex = make_vertex();
+}
 
-        long double cosg = std::cos(delta.z());
-        long double sing = std::sin(delta.z());
+void GenEvent::recycle() {
+    // Objects referenced only by the event have a use count of one once the
+    // links from the attributes and the vertices are cut
+    for (AttributeTable& table: m_attributes) {
+        for (att_val_t& entry: table.entries) {
+            std::shared_ptr<Attribute>& att = entry.second;
+            if ( !att || att.use_count() != 1 ) continue;
+            att->m_event = nullptr;
+            att->m_particle.reset();
+            att->m_vertex.reset();
+            if ( typeid(*att) == typeid(StringAttribute) ) m_free_strings.emplace_back(std::static_pointer_cast<StringAttribute>(att));
+        }
+    }
+    // As in clear, no tables are left, so event attributes fall back to the run info again
+    m_attributes.clear();
+    for (GenVertexPtr& v: m_vertices) {
+        if ( v.use_count() != 1 ) continue;
+        unlink(v);
+        v->m_event = nullptr;
+        v->m_id = 0;
+        m_free_vertices.emplace_back(std::move(v));
+    }
+    m_vertices.clear();
+    if ( m_rootvertex.use_count() == 1 ) {
+        unlink(m_rootvertex);
+        m_rootvertex->m_data.status = 0;
+        m_rootvertex->m_data.position = FourVector::ZERO_VECTOR();
+    } else {
+        m_rootvertex = make_vertex();
+    }
+    for (GenParticlePtr& p: m_particles) {
+        if ( p.use_count() != 1 ) continue;
+        p->m_production_vertex.reset();
+        p->m_end_vertex.reset();
+        p->m_event = nullptr;
+        p->m_id = 0;
+        m_free_particles.emplace_back(std::move(p));
+    }
+    m_particles.clear();
+}
 
-        tempX_ = cosg*tempX+sing*tempY;
-        tempY_ = -sing*tempX+cosg*tempY;
-        tempX = tempX_;
-        tempY = tempY_;
+void GenEvent::unlink(const GenVertexPtr& v) {
+    // Particles kept by the user must not see the vertex in its next use
+    for (const GenParticlePtr& p: v->m_particles_in) p->m_end_vertex.reset();
+    for (const GenParticlePtr& p: v->m_particles_out) p->m_production_vertex.reset();
+    v->m_particles_in.clear();
+    v->m_particles_out.clear();
+}
 
-        FourVector temp(tempX, tempY, tempZ, pos.t());
-        v->set_position(temp);
+void GenEvent::freeze() {
+    if ( is_frozen() ) return;
+    {
+        std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+        // Cache the parsed standard attributes while the tables may still change
+        attribute<GenCrossSection>("GenCrossSection");
+        attribute<GenHeavyIon>("GenHeavyIon");
+        attribute<GenPdfInfo>("GenPdfInfo");
+        resolve_positions();
     }
+    m_frozen.store(true, std::memory_order_release);
+}
 
+const GenVertexPtr& GenEvent::root_vertex() {
+    if ( !m_rootvertex ) m_rootvertex = make_vertex();
+    return m_rootvertex;
+}
 
+bool GenEvent::refuse_change(const char* method) const {
+    if ( !is_frozen() ) return false;
+    HEPMC3_ERROR(method << ": the event is frozen, the change is ignored")
     return true;
 }
 
-bool GenEvent::reflect(const int axis)
-{
-    if ( axis > 3 || axis < 0 )
-    {
-        HEPMC3_WARNING("GenEvent::reflect: wrong axis")
-        return false;
-    }
-    switch (axis)
-    {
-    case 0:
-        for ( auto& p: m_particles) { FourVector temp = p->momentum(); temp.setX(-p->momentum().x()); p->set_momentum(temp);}
-        for ( auto& v: m_vertices)  { FourVector temp = v->position(); temp.setX(-v->position().x()); v->set_position(temp);}
-        break;
-    case 1:
-        for ( auto& p: m_particles) { FourVector temp = p->momentum(); temp.setY(-p->momentum().y()); p->set_momentum(temp);}
-        for ( auto& v: m_vertices)  { FourVector temp = v->position(); temp.setY(-v->position().y()); v->set_position(temp);}
-        break;
-    case 2:
-        for ( auto& p: m_particles) { FourVector temp = p->momentum(); temp.setZ(-p->momentum().z()); p->set_momentum(temp);}
-        for ( auto& v: m_vertices)  { FourVector temp = v->position(); temp.setZ(-v->position().z()); v->set_position(temp);}
-        break;
-    case 3:
-        for ( auto& p: m_particles) { FourVector temp = p->momentum(); temp.setT(-p->momentum().e()); p->set_momentum(temp);}
-        for ( auto& v: m_vertices)  { FourVector temp = v->position(); temp.setT(-v->position().t()); v->set_position(temp);}
-        break;
-    default:
-        return false;
-    }
+std::unique_lock<std::recursive_mutex> GenEvent::attribute_lock() const {
+    if ( is_frozen() ) return std::unique_lock<std::recursive_mutex>(m_lock_attributes, std::defer_lock);
+    return std::unique_lock<std::recursive_mutex>(m_lock_attributes);
+}
 
-    return true;
+void GenEvent::set_recycling(const bool& recycling) {
+    m_recycling = recycling;
+    if ( recycling ) return;
+    m_free_particles = std::vector<GenParticlePtr>();
+    m_free_vertices = std::vector<GenVertexPtr>();
+    m_free_strings = std::vector<std::shared_ptr<StringAttribute> >();
 }
 
-bool GenEvent::boost(const FourVector&  delta)
-{
-    double deltalength2d = delta.length2();
-    if (deltalength2d > 1.0)
-    {
-        HEPMC3_WARNING("GenEvent::boost: wrong large boost vector. Will leave event as is.")
-        return false;
-    }
-    if (std::abs(deltalength2d-1.0) < std::numeric_limits<double>::epsilon())
-    {
-        HEPMC3_WARNING("GenEvent::boost: too large gamma. Will leave event as is.")
-        return false;
+GenParticlePtr GenEvent::make_particle(const FourVector& momentum, int pid, int status) {
+    if ( !m_free_particles.empty() ) {
+        GenParticlePtr p = std::move(m_free_particles.back());
+        m_free_particles.pop_back();
+        p->m_data.pid         = pid;
+        p->m_data.momentum    = momentum;
+        p->m_data.status      = status;
+        p->m_data.is_mass_set = false;
+        p->m_data.mass        = 0.0;
+        return p;
     }
-    if (std::abs(deltalength2d) < std::numeric_limits<double>::epsilon())
-    {
-        HEPMC3_WARNING("GenEvent::boost: wrong small boost vector. Will leave event as is.")
-        return true;
-    }
-    long double deltaX = delta.x();
-    long double deltaY = delta.y();
-    long double deltaZ = delta.z();
-    long double deltalength2 = deltaX*deltaX+deltaY*deltaY+deltaZ*deltaZ;
-    long double deltalength = std::sqrt(deltalength2);
-    long double gamma = 1.0/std::sqrt(1.0-deltalength2);
-
-    for ( auto& p: m_particles)
-    {
-        const FourVector& mom = p->momentum();
+    if ( !m_arena ) return std::make_shared<GenParticle>(momentum, pid, status);
+    return std::allocate_shared<GenParticle>(ArenaAllocator<GenParticle>(m_arena), momentum, pid, status);
+}
 
-        long double tempX = mom.x();
-        long double tempY = mom.y();
-        long double tempZ = mom.z();
-        long double tempE = mom.e();
-        long double nr = (deltaX*tempX+deltaY*tempY+deltaZ*tempZ)/deltalength;
+GenParticlePtr GenEvent::make_particle(const GenParticleData& data) {
+    if ( !m_free_particles.empty() ) {
+        GenParticlePtr p = std::move(m_free_particles.back());
+        m_free_particles.pop_back();
+        p->m_data = data;
+        return p;
+    }
+    if ( !m_arena ) return std::make_shared<GenParticle>(data);
+    return std::allocate_shared<GenParticle>(ArenaAllocator<GenParticle>(m_arena), data);
+}
 
-        tempX+=(deltaX*((gamma-1)*nr/deltalength)-deltaX*(tempE*gamma));
-        tempY+=(deltaY*((gamma-1)*nr/deltalength)-deltaY*(tempE*gamma));
-        tempZ+=(deltaZ*((gamma-1)*nr/deltalength)-deltaZ*(tempE*gamma));
-        tempE = gamma*(tempE-deltalength*nr);
-        FourVector temp(tempX, tempY, tempZ, tempE);
-        p->set_momentum(temp);
+GenVertexPtr GenEvent::make_vertex(const FourVector& position) {
+    if ( !m_free_vertices.empty() ) {
+        GenVertexPtr v = std::move(m_free_vertices.back());
+        m_free_vertices.pop_back();
+        v->m_data.status   = 0;
+        v->m_data.position = position;
+        return v;
     }
+    if ( !m_arena ) return std::make_shared<GenVertex>(position);
+    return std::allocate_shared<GenVertex>(ArenaAllocator<GenVertex>(m_arena), position);
+}
 
-    return true;
+GenVertexPtr GenEvent::make_vertex(const GenVertexData& data) {
+    if ( !m_free_vertices.empty() ) {
+        GenVertexPtr v = std::move(m_free_vertices.back());
+        m_free_vertices.pop_back();
+        v->m_data = data;
+        return v;
+    }
+    if ( !m_arena ) return std::make_shared<GenVertex>(data);
+    return std::allocate_shared<GenVertex>(ArenaAllocator<GenVertex>(m_arena), data);
 }
 
-void GenEvent::clear() {
-    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-    m_event_number = 0;
-    m_rootvertex = std::make_shared<GenVertex>();
-    m_weights.clear();
-    m_attributes.clear();
-    m_particles.clear();
-    m_vertices.clear();
+std::shared_ptr<StringAttribute> GenEvent::make_string_attribute(const std::string& text) {
+    if ( m_free_strings.empty() ) return std::make_shared<StringAttribute>(text);
+    std::shared_ptr<StringAttribute> att = std::move(m_free_strings.back());
+    m_free_strings.pop_back();
+    att->m_string = text;
+    att->m_is_parsed = false;
+    return att;
 }
 
 void GenEvent::remove_attribute(const std::string &name,  const int& id) {
+    if ( refuse_change("GenEvent::remove_attribute") ) return;
     std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-    auto i1 = m_attributes.find(name);
-    if ( i1 == m_attributes.end() ) return;
+    if ( name == "cycles" ) invalidate_positions();
+    AttributeTable* table = find_attribute_table(name);
+    if ( !table ) return;
 
-    auto i2 = i1->second.find(id);
-    if ( i2 == i1->second.end() ) return;
-
-    i1->second.erase(i2);
+    table->erase(id);
 }
 
 std::vector<std::string> GenEvent::attribute_names(const int& id) const {
     std::vector<std::string> results;
 
-    for (const att_key_t& vt1: m_attributes) {
-        if ( vt1.second.count(id) == 1 ) {
-            results.emplace_back(vt1.first);
+    std::unique_lock<std::recursive_mutex> lock = attribute_lock();
+    for (AttributeTable& table: m_attributes) {
+        if ( table.find(id) ) {
+            results.emplace_back(*table.name);
         }
     }
 
     return results;
 }
 
-void GenEvent::write_data(GenEventData& data) const {
+std::map< std::string, std::map<int, std::shared_ptr<Attribute> > > GenEvent::attributes() const {
+    std::map< std::string, std::map<int, std::shared_ptr<Attribute> > > ret;
+    std::unique_lock<std::recursive_mutex> lock = attribute_lock();
+    for (const AttributeTable& table: m_attributes) {
+        std::map<int, std::shared_ptr<Attribute> >& target = ret.emplace_hint(ret.end(), *table.name, std::map<int, std::shared_ptr<Attribute> >())->second;
+        for (const att_val_t& vt2: table.entries) target.emplace_hint(target.end(), vt2);
+    }
+    return ret;
+}
+
+std::shared_ptr<Attribute>* GenEvent::AttributeTable::find(const int& id) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), id,
+                               [](const att_val_t& a, const int& i) { return a.first < i; });
+    if ( it == entries.end() || it->first != id ) return nullptr;
+    return &(it->second);
+}
+
+void GenEvent::AttributeTable::set(const int& id, const std::shared_ptr<Attribute>& att, const bool& replace) {
+    // Attributes are mostly added in increasing id order
+    if ( entries.empty() || entries.back().first < id ) {
+        entries.emplace_back(id, att);
+        return;
+    }
+    auto it = std::lower_bound(entries.begin(), entries.end(), id,
+                               [](const att_val_t& a, const int& i) { return a.first < i; });
+    if ( it != entries.end() && it->first == id ) {
+        if ( replace ) it->second = att;
+        return;
+    }
+    entries.emplace(it, id, att);
+}
+
+void GenEvent::AttributeTable::erase(const int& id) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), id,
+                               [](const att_val_t& a, const int& i) { return a.first < i; });
+    if ( it != entries.end() && it->first == id ) entries.erase(it);
+}
+
+GenEvent::AttributeTable* GenEvent::find_attribute_table(const std::string& name) const {
+    auto it = std::lower_bound(m_attributes.begin(), m_attributes.end(), name,
+                               [](const AttributeTable& t, const std::string& n) { return *t.name < n; });
+    if ( it == m_attributes.end() || *it->name != name ) return nullptr;
+    return &(*it);
+}
+
+GenEvent::AttributeTable* GenEvent::find_attribute_table(const int& key) const {
+    // Events have few attribute names, a linear search on integers is the fastest
+    for (AttributeTable& table: m_attributes) if ( table.key == key ) return &table;
+    return nullptr;
+}
+
+GenEvent::AttributeTable& GenEvent::attribute_table(const std::string& name) {
+    // Inherited vertex positions depend on the "cycles" attribute
+    if ( name == "cycles" ) invalidate_positions();
+    auto it = std::lower_bound(m_attributes.begin(), m_attributes.end(), name,
+                               [](const AttributeTable& t, const std::string& n) { return *t.name < n; });
+    if ( it != m_attributes.end() && *it->name == name ) return *it;
+    const int key = AttributeRegistry::key(name);
+    AttributeTable table = { key, &AttributeRegistry::name(key), std::vector<att_val_t>() };
+    return *m_attributes.emplace(it, std::move(table));
+}
+
+void GenEvent::attach_attribute(const std::shared_ptr<Attribute>& att, const int& id) const {
+    att->m_event = this;
+    if ( id > 0 && id <= int(m_particles.size()) ) {
+        att->m_particle = m_particles[id - 1];
+    }
+    if ( id < 0 && -id <= int(m_vertices.size()) ) {
+        att->m_vertex = m_vertices[-id - 1];
+    }
+}
+
+void GenEvent::write_data(GenEventData& data, const bool& binary_attributes) const {
     // Reserve memory for containers
     data.particles.reserve(this->particles().size());
     data.vertices.reserve(this->vertices().size());
     data.links1.reserve(this->particles().size()*2);
     data.links2.reserve(this->particles().size()*2);
-    data.attribute_id.reserve(m_attributes.size());
-    data.attribute_name.reserve(m_attributes.size());
-    data.attribute_string.reserve(m_attributes.size());
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    size_t n_attributes = 0;
+    for (const AttributeTable& table: m_attributes) n_attributes += table.entries.size();
+    data.attribute_id.reserve(n_attributes);
+    data.attribute_name.reserve(n_attributes);
+    data.attribute_string.reserve(n_attributes);
 
     // Fill event data
     data.event_number  = this->event_number();
@@ -655,29 +1549,40 @@ void GenEvent::write_data(GenEventData& data) const {
         data.vertices.emplace_back(v->data());
         int v_id = v->id();
 
-        for (const ConstGenParticlePtr& p: v->particles_in()) {
+        for (const ConstGenParticlePtr& p: v->particles_in_span()) {
             data.links1.emplace_back(p->id());
             data.links2.emplace_back(v_id);
         }
 
-        for (const ConstGenParticlePtr& p: v->particles_out()) {
+        for (const ConstGenParticlePtr& p: v->particles_out_span()) {
             data.links1.emplace_back(v_id);
             data.links2.emplace_back(p->id());
         }
     }
 
-    for (const att_key_t& vt1: this->attributes()) {
-        for (const att_val_t& vt2: vt1.second) {
+    for (const AttributeTable& table: m_attributes) {
+        for (const att_val_t& vt2: table.entries) {
             std::string st;
 
+            if ( binary_attributes ) {
+                std::string tag = vt2.second->type_tag();
+                if ( !tag.empty() && vt2.second->to_bytes(st) ) {
+                    data.attribute_binary_id.emplace_back(vt2.first);
+                    data.attribute_binary_name.emplace_back(*table.name);
+                    data.attribute_binary_type.emplace_back(std::move(tag));
+                    data.attribute_binary_bytes.emplace_back(std::move(st));
+                    continue;
+                }
+            }
+
             bool status = vt2.second->to_string(st);
 
             if ( !status ) {
-                HEPMC3_WARNING("GenEvent::write_data: problem serializing attribute: " << vt1.first)
+                HEPMC3_WARNING("GenEvent::write_data: problem serializing attribute: " << *table.name)
             }
             else {
                 data.attribute_id.emplace_back(vt2.first);
-                data.attribute_name.emplace_back(vt1.first);
+                data.attribute_name.emplace_back(*table.name);
                 data.attribute_string.emplace_back(st);
             }
         }
@@ -686,6 +1591,7 @@ void GenEvent::write_data(GenEventData& data) const {
 
 
 void GenEvent::read_data(const GenEventData &data) {
+    if ( refuse_change("GenEvent::read_data") ) return;
     this->clear();
     this->set_event_number(data.event_number);
     //Note: set_units checks the current unit of event, i.e. applicable only for fully constructed event.
@@ -700,18 +1606,29 @@ void GenEvent::read_data(const GenEventData &data) {
 
     // Fill particle information
     for ( const GenParticleData &pd: data.particles ) {
-        m_particles.emplace_back(std::make_shared<GenParticle>(pd));
+        m_particles.emplace_back(make_particle(pd));
         m_particles.back()->m_event = this;
         m_particles.back()->m_id    = m_particles.size();
     }
 
     // Fill vertex information
     for ( const GenVertexData &vd: data.vertices ) {
-        m_vertices.emplace_back(std::make_shared<GenVertex>(vd));
+        m_vertices.emplace_back(make_vertex(vd));
         m_vertices.back()->m_event = this;
         m_vertices.back()->m_id    = -(int)m_vertices.size();
     }
 
+    // Size the particle lists of the vertices before restoring the links
+    std::vector<size_t> n_in(m_vertices.size(), 0);
+    std::vector<size_t> n_out(m_vertices.size(), 0);
+    for (unsigned int i = 0; i < data.links1.size(); ++i) {
+        const int id1 = data.links1[i];
+        const int id2 = data.links2[i];
+        if ( id1 > 0 && id2 < 0 && (size_t)(-id2) <= n_in.size() ) ++n_in[-id2 - 1];
+        if ( id1 < 0 && id2 > 0 && (size_t)(-id1) <= n_out.size() ) ++n_out[-id1 - 1];
+    }
+    for (size_t i = 0; i < m_vertices.size(); ++i) m_vertices[i]->reserve(n_in[i], n_out[i]);
+
     // Restore links
     for (unsigned int i = 0; i < data.links1.size(); ++i) {
         const int id1 = data.links1[i];
@@ -726,28 +1643,156 @@ void GenEvent::read_data(const GenEventData &data) {
         if ( id1 > 0 ) { m_vertices[ (-id2)-1 ]->add_particle_in ( m_particles[ id1-1 ] ); continue; }
         if ( id1 < 0 ) { m_vertices[ (-id1)-1 ]->add_particle_out( m_particles[ id2-1 ] );   continue; }
     }
-    for (auto& p:  m_particles) if (!p->production_vertex()) m_rootvertex->add_particle_out(p);
+    for (auto& p:  m_particles) if (!p->production_vertex()) root_vertex()->add_particle_out(p);
 
     // Read attributes
     std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    AttributeTable* table = nullptr;
     for (unsigned int i = 0; i < data.attribute_id.size(); ++i) {
         ///Disallow empty strings
-        const std::string name = data.attribute_name[i];
+        const std::string& name = data.attribute_name[i];
         if (name.length() == 0) continue;
         const int id = data.attribute_id[i];
-        if (m_attributes.count(name) == 0) m_attributes[name] = std::map<int, std::shared_ptr<Attribute> >();
-        auto att = std::make_shared<StringAttribute>(data.attribute_string[i]);
-        att->m_event = this;
-        if ( id > 0 && id <= int(m_particles.size()) ) {
-            att->m_particle = m_particles[id - 1];
-        }
-        if ( id < 0 && -id <= int(m_vertices.size()) ) {
-            att->m_vertex = m_vertices[-id - 1];
+        // Attributes usually come grouped by name
+        if ( !table || *table->name != name ) table = &attribute_table(name);
+        auto att = make_string_attribute(data.attribute_string[i]);
+        attach_attribute(att, id);
+        table->set(id, att);
+    }
+    for (unsigned int i = 0; i < data.attribute_binary_id.size(); ++i) {
+        const std::string& name = data.attribute_binary_name[i];
+        if (name.length() == 0) continue;
+        const int id = data.attribute_binary_id[i];
+        if ( !table || *table->name != name ) table = &attribute_table(name);
+        auto att = std::make_shared<BinaryAttribute>(data.attribute_binary_type[i], data.attribute_binary_bytes[i]);
+        attach_attribute(att, id);
+        table->set(id, att);
+    }
+}
+
+
+void GenEvent::write_data(CompactEventData& data) const {
+    data.event_number  = this->event_number();
+    data.momentum_unit = this->momentum_unit();
+    data.length_unit   = this->length_unit();
+    data.event_pos     = this->event_pos();
+    data.weights       = this->weights();
+
+    std::unordered_map<int, int> index;
+    index_vertices(index);
+
+    data.particles.resize(m_particles.size());
+    for (size_t i = 0; i < m_particles.size(); ++i) {
+        const GenParticleData& pd = m_particles[i]->m_data;
+        CompactParticleData& cd = data.particles[i];
+        cd.pid    = pd.pid;
+        cd.status = pd.status;
+        cd.px     = pd.momentum.px();
+        cd.py     = pd.momentum.py();
+        cd.pz     = pd.momentum.pz();
+        cd.e      = pd.momentum.e();
+        cd.mass   = pd.is_mass_set ? pd.mass : std::numeric_limits<float>::quiet_NaN();
+        cd.production_vertex = vertex_index(m_particles[i]->production_vertex().get(), index);
+        cd.end_vertex        = vertex_index(m_particles[i]->end_vertex().get(), index);
+    }
+
+    data.vertices.resize(m_vertices.size());
+    for (size_t i = 0; i < m_vertices.size(); ++i) {
+        const GenVertexData& vd = m_vertices[i]->m_data;
+        CompactVertexData& cd = data.vertices[i];
+        cd.status = vd.status;
+        cd.x      = vd.position.x();
+        cd.y      = vd.position.y();
+        cd.z      = vd.position.z();
+        cd.t      = vd.position.t();
+    }
+
+    data.attribute_id.clear();
+    data.attribute_name.clear();
+    data.attribute_string.clear();
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    for (const AttributeTable& table: m_attributes) {
+        for (const att_val_t& vt2: table.entries) {
+            std::string st;
+            if ( !vt2.second->to_string(st) ) {
+                HEPMC3_WARNING("GenEvent::write_data: problem serializing attribute: " << *table.name)
+                continue;
+            }
+            data.attribute_id.emplace_back(vt2.first);
+            data.attribute_name.emplace_back(*table.name);
+            data.attribute_string.emplace_back(std::move(st));
         }
-        m_attributes[name][id] = att;
     }
 }
 
+void GenEvent::read_data(const CompactEventData& data) {
+    if ( refuse_change("GenEvent::read_data") ) return;
+    this->clear();
+    this->set_event_number(data.event_number);
+    m_momentum_unit = data.momentum_unit;
+    m_length_unit = data.length_unit;
+    this->shift_position_to(data.event_pos);
+    this->weights() = data.weights;
+    m_particles.reserve(data.particles.size());
+    m_vertices.reserve(data.vertices.size());
+
+    GenVertexData vd;
+    for ( const CompactVertexData& cd: data.vertices ) {
+        vd.status   = cd.status;
+        vd.position = cd.position();
+        m_vertices.emplace_back(make_vertex(vd));
+        m_vertices.back()->m_event = this;
+        m_vertices.back()->m_id    = -(int)m_vertices.size();
+    }
+
+    // Size the particle lists of the vertices before attaching the particles
+    const int nv = (int)m_vertices.size();
+    std::vector<size_t> n_in(nv, 0);
+    std::vector<size_t> n_out(nv + 1, 0);
+    for ( const CompactParticleData& cd: data.particles ) {
+        ++n_out[cd.production_vertex >= 0 && cd.production_vertex < nv ? cd.production_vertex : nv];
+        if ( cd.end_vertex >= 0 && cd.end_vertex < nv ) ++n_in[cd.end_vertex];
+    }
+    for (int i = 0; i < nv; ++i) m_vertices[i]->reserve(n_in[i], n_out[i]);
+    root_vertex()->reserve(0, n_out[nv]);
+
+    GenParticleData pd;
+    for ( const CompactParticleData& cd: data.particles ) {
+        pd.pid         = cd.pid;
+        pd.status      = cd.status;
+        pd.is_mass_set = cd.is_mass_set();
+        pd.mass        = pd.is_mass_set ? cd.mass : 0.0;
+        pd.momentum    = cd.momentum();
+        GenParticlePtr p = make_particle(pd);
+        p->m_event = this;
+        p->m_id    = m_particles.size() + 1;
+        m_particles.emplace_back(p);
+
+        if ( cd.production_vertex >= 0 && cd.production_vertex < nv ) {
+            m_vertices[cd.production_vertex]->m_particles_out.push_back(p);
+            p->m_production_vertex = m_vertices[cd.production_vertex];
+        } else {
+            m_rootvertex->m_particles_out.push_back(p);
+            p->m_production_vertex = m_rootvertex;
+        }
+        if ( cd.end_vertex >= 0 && cd.end_vertex < nv ) {
+            m_vertices[cd.end_vertex]->m_particles_in.push_back(p);
+            p->m_end_vertex = m_vertices[cd.end_vertex];
+        }
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    AttributeTable* table = nullptr;
+    for (size_t i = 0; i < data.attribute_id.size(); ++i) {
+        const std::string& name = data.attribute_name[i];
+        if (name.length() == 0) continue;
+        const int id = data.attribute_id[i];
+        if ( !table || *table->name != name ) table = &attribute_table(name);
+        auto att = make_string_attribute(data.attribute_string[i]);
+        attach_attribute(att, id);
+        table->set(id, att);
+    }
+}
 
 //
 // Deprecated functions
@@ -764,8 +1809,10 @@ void GenEvent::add_vertex(GenVertex *v) {
 
 
 void GenEvent::set_beam_particles(GenParticlePtr p1, GenParticlePtr p2) {
-    m_rootvertex->add_particle_out(p1);
-    m_rootvertex->add_particle_out(p2);
+    if ( refuse_change("GenEvent::set_beam_particles") ) return;
+    invalidate_positions();
+    root_vertex()->add_particle_out(p1);
+    root_vertex()->add_particle_out(p2);
 }
 
 void GenEvent::add_beam_particle(GenParticlePtr p1) {
@@ -787,44 +1834,39 @@ void GenEvent::add_beam_particle(GenParticlePtr p1) {
 
 
 std::string GenEvent::attribute_as_string(const std::string &name, const int& id) const {
-    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-    auto i1 = m_attributes.find(name);
-    if ( i1 == m_attributes.end() ) {
+    std::unique_lock<std::recursive_mutex> lock = attribute_lock();
+    AttributeTable* table = find_attribute_table(name);
+    if ( !table ) {
         if ( id == 0 && run_info() ) {
             return run_info()->attribute_as_string(name);
         }
         return {};
     }
 
-    auto i2 = i1->second.find(id);
-    if (i2 == i1->second.end() ) return {};
+    std::shared_ptr<Attribute>* slot = table->find(id);
+    if ( !slot ) return {};
 
-    if ( !i2->second ) return {};
+    if ( !*slot ) return {};
 
     std::string ret;
-    i2->second->to_string(ret);
+    (*slot)->to_string(ret);
 
     return ret;
 }
 
 void GenEvent::add_attribute(const std::string &name, const std::shared_ptr<Attribute> &att, const int& id ) {
+    if ( refuse_change("GenEvent::add_attribute") ) return;
     ///Disallow empty strings
     if (name.length() == 0) return;
     if (!att)  return;
     std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-    if (m_attributes.count(name) == 0) m_attributes[name] = std::map<int, std::shared_ptr<Attribute> >();
-    m_attributes[name][id] = att;
-    att->m_event = this;
-    if ( id > 0 && id <= int(particles().size()) ) {
-        att->m_particle = particles()[id - 1];
-    }
-    if ( id < 0 && -id <= int(vertices().size()) ) {
-        att->m_vertex = vertices()[-id - 1];
-    }
+    attribute_table(name).set(id, att);
+    attach_attribute(att, id);
 }
 
 
 void GenEvent::add_attributes(const std::vector<std::string> &names, const std::vector<std::shared_ptr<Attribute> > &atts, const std::vector<int>& ids) {
+    if ( refuse_change("GenEvent::add_attributes") ) return;
     size_t N = names.size();
     if ( N == 0 ) return;
     if (N != atts.size()) return;
@@ -836,71 +1878,46 @@ void GenEvent::add_attributes(const std::vector<std::string> &names, const std::
     unames.resize(std::distance(unames.begin(), ip));
     std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
     for (const auto& name: unames) {
-        if (m_attributes.count(name) == 0) m_attributes[name] = std::map<int, std::shared_ptr<Attribute> >();
+        if (name.length() != 0) attribute_table(name);
     }
-    const int particles_size = int(m_particles.size());
-    const int vertices_size = int(m_vertices.size());
+    AttributeTable* table = nullptr;
     for (size_t i = 0; i < N; i++) {
         ///Disallow empty strings
         if (names.at(i).length() == 0) continue;
         if (!atts[i])  continue;
-        m_attributes[names.at(i)][ids.at(i)] = atts[i];
-        atts[i]->m_event = this;
-        if ( ids.at(i) > 0 && ids.at(i) <= particles_size )
-        { atts[i]->m_particle = m_particles[ids.at(i) - 1]; }
-        else {
-            if ( ids.at(i) < 0 && -ids.at(i) <= vertices_size ) {
-                atts[i]->m_vertex = m_vertices[-ids.at(i) - 1];
-            }
-        }
+        if ( !table || *table->name != names.at(i) ) table = find_attribute_table(names.at(i));
+        table->set(ids.at(i), atts[i]);
+        attach_attribute(atts[i], ids.at(i));
     }
 }
 
 void GenEvent::add_attributes(const std::string& name, const std::vector<std::shared_ptr<Attribute> > &atts, const std::vector<int>& ids) {
+    if ( refuse_change("GenEvent::add_attributes") ) return;
     if (name.length() == 0) return;
     size_t N = ids.size();
     if(!N) return;
     if ( N != atts.size()) return;
 
     std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-    if (m_attributes.count(name) == 0) m_attributes[name] = std::map<int, std::shared_ptr<Attribute> >();
-    auto& tmap = m_attributes[name];
-    const int particles_size = int(m_particles.size());
-    const int vertices_size = int(m_vertices.size());
+    AttributeTable& table = attribute_table(name);
     for (size_t i = 0; i < N; i++) {
         ///Disallow empty strings
         if (!atts[i])  continue;
-        tmap[ids.at(i)] = atts[i];
-        atts[i]->m_event = this;
-        if ( ids.at(i) > 0 && ids.at(i) <= particles_size )
-        { atts[i]->m_particle = m_particles[ids.at(i) - 1]; }
-        else {
-            if ( ids.at(i) < 0 && -ids.at(i) <= vertices_size ) {
-                atts[i]->m_vertex = m_vertices[-ids.at(i) - 1];
-            }
-        }
+        table.set(ids.at(i), atts[i]);
+        attach_attribute(atts[i], ids.at(i));
     }
 }
 void GenEvent::add_attributes(const std::string& name, const std::vector<std::pair<int, std::shared_ptr<Attribute> > > &atts) {
+    if ( refuse_change("GenEvent::add_attributes") ) return;
     if (name.length() == 0) return;
     if (atts.empty()) return;
     std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
-    if (m_attributes.count(name) == 0) m_attributes[name] = std::map<int, std::shared_ptr<Attribute> >();
-    auto& tmap = m_attributes[name];
-    const int particles_size = int(m_particles.size());
-    const int vertices_size = int(m_vertices.size());
+    AttributeTable& table = attribute_table(name);
     for (const auto& att: atts) {
         ///Disallow empty strings
         if (!att.second)  continue;
-        tmap.insert(att);
-        att.second->m_event = this;
-        if ( att.first > 0 && att.first <= particles_size )
-        { att.second->m_particle = m_particles[att.first - 1]; }
-        else {
-            if ( att.first < 0 && -att.first <= vertices_size ) {
-                att.second->m_vertex = m_vertices[-att.first - 1];
-            }
-        }
+        table.set(att.first, att.second, false);
+        attach_attribute(att.second, att.first);
     }
 }
 
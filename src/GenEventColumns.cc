@@ -0,0 +1,91 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+/**
+ *  @file GenEventColumns.cc
+ *  @brief Implementation of \b class GenEventColumns
+ *
+ */
+#include "HepMC3/GenEventColumns.h"
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/Data/GenEventData.h"
+
+namespace HepMC3 {
+
+GenEventColumns::GenEventColumns(const GenEvent& evt) { fill(evt); }
+
+GenEventColumns::GenEventColumns(const GenEventData& data) { fill(data); }
+
+void GenEventColumns::resize(const size_t& n) {
+    pid.resize(n);
+    status.resize(n);
+    px.resize(n);
+    py.resize(n);
+    pz.resize(n);
+    e.resize(n);
+    mass.resize(n);
+    production_vertex_index.resize(n);
+    end_vertex_index.resize(n);
+}
+
+void GenEventColumns::clear() { resize(0); }
+
+void GenEventColumns::fill(const GenEvent& evt) {
+    momentum_unit = evt.momentum_unit();
+    length_unit   = evt.length_unit();
+
+    const std::vector<ConstGenParticlePtr>& particles = evt.particles();
+    resize(particles.size());
+
+    for (size_t i = 0; i < particles.size(); ++i) {
+        const GenParticleData& pd = particles[i]->data();
+        pid[i]    = pd.pid;
+        status[i] = pd.status;
+        px[i]     = pd.momentum.px();
+        py[i]     = pd.momentum.py();
+        pz[i]     = pd.momentum.pz();
+        e[i]      = pd.momentum.e();
+        mass[i]   = pd.is_mass_set ? pd.mass : pd.momentum.m();
+
+        // The root vertex has id 0 and thus maps to -1
+        ConstGenVertexPtr prod = particles[i]->production_vertex();
+        ConstGenVertexPtr end  = particles[i]->end_vertex();
+        production_vertex_index[i] = prod ? -prod->id() - 1 : -1;
+        end_vertex_index[i]        = end  ? -end->id()  - 1 : -1;
+    }
+}
+
+void GenEventColumns::fill(const GenEventData& data) {
+    momentum_unit = data.momentum_unit;
+    length_unit   = data.length_unit;
+
+    const size_t n = data.particles.size();
+    resize(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        const GenParticleData& pd = data.particles[i];
+        pid[i]    = pd.pid;
+        status[i] = pd.status;
+        px[i]     = pd.momentum.px();
+        py[i]     = pd.momentum.py();
+        pz[i]     = pd.momentum.pz();
+        e[i]      = pd.momentum.e();
+        mass[i]   = pd.is_mass_set ? pd.mass : pd.momentum.m();
+        production_vertex_index[i] = -1;
+        end_vertex_index[i]        = -1;
+    }
+
+    // See GenEventData::links1 for the meaning of the links
+    for (size_t i = 0; i < data.links1.size(); ++i) {
+        const int id1 = data.links1[i];
+        const int id2 = data.links2[i];
+        if ( id1 > 0 && id2 < 0 && (size_t)id1 <= n ) end_vertex_index[id1 - 1] = -id2 - 1;
+        if ( id1 < 0 && id2 > 0 && (size_t)id2 <= n ) production_vertex_index[id2 - 1] = -id1 - 1;
+    }
+}
+
+} // namespace HepMC3
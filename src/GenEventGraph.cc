@@ -0,0 +1,138 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+/**
+ *  @file GenEventGraph.cc
+ *  @brief Implementation of \b class GenEventGraph
+ *
+ */
+#include <unordered_map>
+
+#include "HepMC3/GenEventGraph.h"
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/Data/GenEventData.h"
+
+namespace HepMC3 {
+
+GenEventGraph::GenEventGraph(const GenEvent& evt) { fill(evt); }
+
+GenEventGraph::GenEventGraph(const GenEventData& data) { fill(data); }
+
+void GenEventGraph::clear() {
+    m_production_vertex.clear();
+    m_end_vertex.clear();
+    m_in_offsets.clear();
+    m_in.clear();
+    m_out_offsets.clear();
+    m_out.clear();
+}
+
+void GenEventGraph::fill(const GenEvent& evt) {
+    const std::vector<ConstGenParticlePtr>& particles = evt.particles();
+    const std::vector<ConstGenVertexPtr>& vertices = evt.vertices();
+
+    std::unordered_map<int, int> index;
+    evt.index_vertices(index);
+
+    m_production_vertex.resize(particles.size());
+    m_end_vertex.resize(particles.size());
+    for (size_t i = 0; i < particles.size(); ++i) {
+        m_production_vertex[i] = evt.vertex_index(particles[i]->production_vertex().get(), index);
+        m_end_vertex[i]        = evt.vertex_index(particles[i]->end_vertex().get(), index);
+    }
+    build(vertices.size());
+}
+
+void GenEventGraph::fill(const GenEventData& data) {
+    const size_t n = data.particles.size();
+    m_production_vertex.assign(n, -1);
+    m_end_vertex.assign(n, -1);
+
+    // See GenEventData::links1 for the meaning of the links
+    const int n_vertices = data.vertices.size();
+    for (size_t i = 0; i < data.links1.size(); ++i) {
+        const int id1 = data.links1[i];
+        const int id2 = data.links2[i];
+        if ( id1 > 0 && id2 < 0 && (size_t)id1 <= n && -id2 <= n_vertices ) m_end_vertex[id1 - 1] = -id2 - 1;
+        if ( id1 < 0 && id2 > 0 && (size_t)id2 <= n && -id1 <= n_vertices ) m_production_vertex[id2 - 1] = -id1 - 1;
+    }
+    build(n_vertices);
+}
+
+void GenEventGraph::build(const size_t& n_vertices) {
+    // Counting sort of the particles by vertex
+    const size_t n = m_production_vertex.size();
+    m_in_offsets.assign(n_vertices + 1, 0);
+    m_out_offsets.assign(n_vertices + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        if ( m_end_vertex[i] >= 0 ) ++m_in_offsets[m_end_vertex[i] + 1];
+        if ( m_production_vertex[i] >= 0 ) ++m_out_offsets[m_production_vertex[i] + 1];
+    }
+    for (size_t v = 0; v < n_vertices; ++v) {
+        m_in_offsets[v + 1] += m_in_offsets[v];
+        m_out_offsets[v + 1] += m_out_offsets[v];
+    }
+    m_in.resize(m_in_offsets.back());
+    m_out.resize(m_out_offsets.back());
+
+    std::vector<int> in_next(m_in_offsets.begin(), m_in_offsets.end() - 1);
+    std::vector<int> out_next(m_out_offsets.begin(), m_out_offsets.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        if ( m_end_vertex[i] >= 0 ) m_in[in_next[m_end_vertex[i]]++] = i;
+        if ( m_production_vertex[i] >= 0 ) m_out[out_next[m_production_vertex[i]]++] = i;
+    }
+}
+
+GenEventGraph::Range GenEventGraph::range(const std::vector<int>& values, const std::vector<int>& offsets, const int& v) {
+    if ( v < 0 ) return Range(nullptr, nullptr);
+    return Range(values.data() + offsets[v], values.data() + offsets[v + 1]);
+}
+
+std::vector<int> GenEventGraph::walk(const int& i, const bool up) const {
+    std::vector<int> result;
+    std::vector<char> visited(particles_size(), 0);
+    visited[i] = 1;
+    // The result is the queue of the breadth-first search
+    result.push_back(i);
+    for (size_t k = 0; k < result.size(); ++k) {
+        for (const int& next: up ? parents(result[k]) : children(result[k])) {
+            if ( visited[next] ) continue;
+            visited[next] = 1;
+            result.push_back(next);
+        }
+    }
+    result.erase(result.begin());
+    return result;
+}
+
+std::vector<int> GenEventGraph::ancestors(const int& i) const { return walk(i, true); }
+
+std::vector<int> GenEventGraph::descendants(const int& i) const { return walk(i, false); }
+
+bool GenEventGraph::has_cycles() const {
+    // Kahn's algorithm: remove vertices without remaining mothers one by one
+    const size_t n_vertices = vertices_size();
+    std::vector<int> mothers(n_vertices, 0);
+    std::vector<int> ready;
+    for (size_t v = 0; v < n_vertices; ++v) {
+        for (const int& p: particles_in(v)) if ( m_production_vertex[p] >= 0 ) ++mothers[v];
+        if ( mothers[v] == 0 ) ready.push_back(v);
+    }
+    size_t processed = 0;
+    while ( !ready.empty() ) {
+        const int v = ready.back();
+        ready.pop_back();
+        ++processed;
+        for (const int& p: particles_out(v)) {
+            const int next = m_end_vertex[p];
+            if ( next >= 0 && --mothers[next] == 0 ) ready.push_back(next);
+        }
+    }
+    return processed != n_vertices;
+}
+
+} // namespace HepMC3
@@ -14,6 +14,7 @@
 #include <sstream> // sprintf
 
 #include "HepMC3/GenHeavyIon.h"
+#include "HepMC3/AttributeBytes.h"
 
 namespace HepMC3 {
 
@@ -103,6 +104,45 @@ bool GenHeavyIon::to_string(std::string &att) const {
     return true;
 }
 
+std::shared_ptr<Attribute> GenHeavyIon::clone() const {
+    return clone_exact<GenHeavyIon>();
+}
+
+/// The deprecated fields are always present in the binary layout,
+/// so that it does not depend on HEPMC3_NO_DEPRECATED.
+bool GenHeavyIon::to_bytes(std::string &bytes) const {
+#ifdef HEPMC3_NO_DEPRECATED
+    const int spectator_neutrons = 0, spectator_protons = 0;
+    const double eccentricity = 0.0;
+    const bool forceoldformat = false;
+#endif
+    ByteWriter(bytes) << Ncoll_hard << Npart_proj << Npart_targ << Ncoll
+                      << spectator_neutrons << spectator_protons
+                      << N_Nwounded_collisions << Nwounded_N_collisions << Nwounded_Nwounded_collisions
+                      << impact_parameter << event_plane_angle << eccentricity
+                      << sigma_inel_NN << centrality << user_cent_estimate
+                      << Nspec_proj_n << Nspec_targ_n << Nspec_proj_p << Nspec_targ_p
+                      << participant_plane_angles << eccentricities << forceoldformat;
+    return true;
+}
+
+bool GenHeavyIon::from_bytes(const std::string &bytes) {
+#ifdef HEPMC3_NO_DEPRECATED
+    int spectator_neutrons, spectator_protons;
+    double eccentricity;
+    bool forceoldformat;
+#endif
+    ByteReader in(bytes);
+    in >> Ncoll_hard >> Npart_proj >> Npart_targ >> Ncoll
+       >> spectator_neutrons >> spectator_protons
+       >> N_Nwounded_collisions >> Nwounded_N_collisions >> Nwounded_Nwounded_collisions
+       >> impact_parameter >> event_plane_angle >> eccentricity
+       >> sigma_inel_NN >> centrality >> user_cent_estimate
+       >> Nspec_proj_n >> Nspec_targ_n >> Nspec_proj_p >> Nspec_targ_p
+       >> participant_plane_angles >> eccentricities >> forceoldformat;
+    return in.done();
+}
+
 
 #ifndef HEPMC3_NO_DEPRECATED
 
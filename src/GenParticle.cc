@@ -38,23 +38,28 @@ double GenParticle::generated_mass() const {
 }
 
 void GenParticle::set_pid(int pidin) {
+    if ( m_event && m_event->refuse_change("GenParticle::set_pid") ) return;
     m_data.pid = pidin;
 }
 
 void GenParticle::set_status(int stat) {
+    if ( m_event && m_event->refuse_change("GenParticle::set_status") ) return;
     m_data.status = stat;
 }
 
 void GenParticle::set_momentum(const FourVector& mom) {
+    if ( m_event && m_event->refuse_change("GenParticle::set_momentum") ) return;
     m_data.momentum = mom;
 }
 
 void GenParticle::set_generated_mass(double m) {
+    if ( m_event && m_event->refuse_change("GenParticle::set_generated_mass") ) return;
     m_data.mass        = m;
     m_data.is_mass_set = true;
 }
 
 void GenParticle::unset_generated_mass() {
+    if ( m_event && m_event->refuse_change("GenParticle::unset_generated_mass") ) return;
     m_data.mass        = 0.;
     m_data.is_mass_set = false;
 }
@@ -76,19 +81,19 @@ ConstGenVertexPtr GenParticle::end_vertex() const {
 }
 
 std::vector<GenParticlePtr> GenParticle::parents() {
-    return (m_production_vertex.expired())? std::vector<GenParticlePtr>() : production_vertex()->particles_in();
+    return (m_production_vertex.expired())? std::vector<GenParticlePtr>() : production_vertex()->particles_in_span().to_vector();
 }
 
 std::vector<ConstGenParticlePtr> GenParticle::parents() const {
-    return (m_production_vertex.expired()) ? std::vector<ConstGenParticlePtr>() : production_vertex()->particles_in();
+    return (m_production_vertex.expired()) ? std::vector<ConstGenParticlePtr>() : production_vertex()->particles_in_span().to_vector();
 }
 
 std::vector<GenParticlePtr> GenParticle::children() {
-    return (m_end_vertex.expired())? std::vector<GenParticlePtr>() : end_vertex()->particles_out();
+    return (m_end_vertex.expired())? std::vector<GenParticlePtr>() : end_vertex()->particles_out_span().to_vector();
 }
 
 std::vector<ConstGenParticlePtr> GenParticle::children() const {
-    return (m_end_vertex.expired()) ? std::vector<ConstGenParticlePtr>() : end_vertex()->particles_out();
+    return (m_end_vertex.expired()) ? std::vector<ConstGenParticlePtr>() : end_vertex()->particles_out_span().to_vector();
 }
 
 bool GenParticle::add_attribute(const std::string& name, std::shared_ptr<Attribute> att) {
@@ -14,6 +14,7 @@
 #include <cstring> // memcmp
 
 #include "HepMC3/GenPdfInfo.h"
+#include "HepMC3/AttributeBytes.h"
 
 namespace HepMC3 {
 
@@ -68,6 +69,23 @@ bool GenPdfInfo::to_string(std::string &att) const {
     return true;
 }
 
+std::shared_ptr<Attribute> GenPdfInfo::clone() const {
+    return clone_exact<GenPdfInfo>();
+}
+
+bool GenPdfInfo::to_bytes(std::string &bytes) const {
+    ByteWriter(bytes) << parton_id[0] << parton_id[1] << pdf_id[0] << pdf_id[1]
+                      << scale << x[0] << x[1] << xf[0] << xf[1];
+    return true;
+}
+
+bool GenPdfInfo::from_bytes(const std::string &bytes) {
+    ByteReader in(bytes);
+    in >> parton_id[0] >> parton_id[1] >> pdf_id[0] >> pdf_id[1]
+       >> scale >> x[0] >> x[1] >> xf[0] >> xf[1];
+    return in.done();
+}
+
 void GenPdfInfo::set(const int& parton_id1, const int& parton_id2, const double& x1, const double& x2,
                      const double& scale_in, const double& xf1, const double& xf2,
                      const int& pdf_id1, const int& pdf_id2) {
@@ -8,6 +8,7 @@
  *  @brief Implementation of \b class GenRunInfo
  *
  */
+#include <atomic>
 #include <sstream>
 
 #include "HepMC3/Data/GenRunInfoData.h"
@@ -16,8 +17,16 @@
 
 namespace HepMC3 {
 
+namespace {
+/// Next identifier of weight names
+std::atomic<unsigned long> next_weight_names_id(1);
+}
+
+GenRunInfo::GenRunInfo(): m_weight_names_id(next_weight_names_id++) {}
+
 
 void GenRunInfo::set_weight_names(const std::vector<std::string> & names) {
+    m_weight_names_id = next_weight_names_id++;
     m_weight_indices.clear();
     m_weight_names = names;
     for ( int i = 0, N = names.size(); i < N; ++i ) {
@@ -82,6 +91,29 @@ std::vector<std::string> GenRunInfo::attribute_names() const {
     return results;
 }
 
+MemoryUsage GenRunInfo::memory_usage() const {
+    // Typical node of a red-black tree: colour and three pointers before the value
+    const size_t map_node = 4*sizeof(void*);
+    MemoryUsage usage;
+    usage.weights = m_weight_names.capacity()*sizeof(std::string);
+    for (const std::string& name: m_weight_names) usage.weights += MemoryUsage::string_heap(name);
+    for (const auto& wi: m_weight_indices) {
+        usage.weights += map_node + sizeof(wi) + MemoryUsage::string_heap(wi.first);
+    }
+    usage.strings = m_tools.capacity()*sizeof(ToolInfo);
+    for (const ToolInfo& tool: m_tools) {
+        usage.strings += MemoryUsage::string_heap(tool.name) + MemoryUsage::string_heap(tool.version) + MemoryUsage::string_heap(tool.description);
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(m_lock_attributes);
+    for (const auto& att: m_attributes) {
+        usage.attributes += map_node + sizeof(att);
+        usage.strings += MemoryUsage::string_heap(att.first);
+        if ( att.second ) usage.add_attribute(*att.second);
+    }
+    return usage;
+}
+
 void GenRunInfo::read_data(const GenRunInfoData& data) {
     // Weight names
     set_weight_names(data.weight_names);
@@ -103,7 +135,7 @@ void GenRunInfo::read_data(const GenRunInfoData& data) {
     }
 }
 
-GenRunInfo::GenRunInfo(const GenRunInfo& r)
+GenRunInfo::GenRunInfo(const GenRunInfo& r): m_weight_names_id(next_weight_names_id++)
 {
     if (this != &r)
     {
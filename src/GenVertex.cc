@@ -9,6 +9,7 @@
  *
  */
 #include <algorithm> // std::remove
+#include <unordered_set>
 
 #include "HepMC3/Attribute.h"
 #include "HepMC3/GenEvent.h"
@@ -35,11 +36,13 @@ GenVertex::GenVertex(const GenVertexData &dat):
 
 void GenVertex::add_particle_in(GenParticlePtr p) {
     if (!p) return;
+    if (m_event && m_event->refuse_change("GenVertex::add_particle_in")) return;
 
     // Avoid duplicates
-    if (std::find(particles_in().begin(), particles_in().end(), p) != particles_in().end()) return;
+    if (std::find(m_particles_in.begin(), m_particles_in.end(), p) != m_particles_in.end()) return;
 
-    m_particles_in.emplace_back(p);
+    m_particles_in.push_back(p);
+    if (m_event) m_event->invalidate_positions();
 
     if ( p->end_vertex() ) p->end_vertex()->remove_particle_in(p);
 
@@ -51,11 +54,13 @@ void GenVertex::add_particle_in(GenParticlePtr p) {
 
 void GenVertex::add_particle_out(GenParticlePtr p) {
     if (!p) return;
+    if (m_event && m_event->refuse_change("GenVertex::add_particle_out")) return;
 
     // Avoid duplicates
-    if (std::find(particles_out().begin(), particles_out().end(), p) != particles_out().end()) return;
+    if (std::find(m_particles_out.begin(), m_particles_out.end(), p) != m_particles_out.end()) return;
 
-    m_particles_out.emplace_back(p);
+    m_particles_out.push_back(p);
+    if (m_event) m_event->invalidate_positions();
 
     if ( p->production_vertex() ) p->production_vertex()->remove_particle_out(p);
 
@@ -64,9 +69,54 @@ void GenVertex::add_particle_out(GenParticlePtr p) {
     if (m_event) m_event->add_particle(p);
 }
 
+void GenVertex::add_particles_in(const std::vector<GenParticlePtr>& particles, const bool check_duplicates) {
+    if (m_event && m_event->refuse_change("GenVertex::add_particles_in")) return;
+    std::unordered_set<const GenParticle*> present;
+    if ( check_duplicates ) for (const GenParticlePtr& p: m_particles_in) present.insert(p.get());
+
+    GenVertexPtr self = shared_from_this();
+    m_particles_in.reserve(m_particles_in.size() + particles.size());
+    for (const GenParticlePtr& p: particles) {
+        if ( !p ) continue;
+        GenVertexPtr old = p->end_vertex();
+        if ( old == self ) continue;
+        if ( check_duplicates && !present.insert(p.get()).second ) continue;
+
+        m_particles_in.push_back(p);
+        if ( old ) old->remove_particle_in(p);
+        p->m_end_vertex = self;
+        if (m_event) m_event->add_particle(p);
+    }
+    if (m_event) m_event->invalidate_positions();
+}
+
+
+void GenVertex::add_particles_out(const std::vector<GenParticlePtr>& particles, const bool check_duplicates) {
+    if (m_event && m_event->refuse_change("GenVertex::add_particles_out")) return;
+    std::unordered_set<const GenParticle*> present;
+    if ( check_duplicates ) for (const GenParticlePtr& p: m_particles_out) present.insert(p.get());
+
+    GenVertexPtr self = shared_from_this();
+    m_particles_out.reserve(m_particles_out.size() + particles.size());
+    for (const GenParticlePtr& p: particles) {
+        if ( !p ) continue;
+        GenVertexPtr old = p->production_vertex();
+        if ( old == self ) continue;
+        if ( check_duplicates && !present.insert(p.get()).second ) continue;
+
+        m_particles_out.push_back(p);
+        if ( old ) old->remove_particle_out(p);
+        p->m_production_vertex = self;
+        if (m_event) m_event->add_particle(p);
+    }
+    if (m_event) m_event->invalidate_positions();
+}
+
 void GenVertex::remove_particle_in(GenParticlePtr p) {
     if (!p) return;
+    if (m_event && m_event->refuse_change("GenVertex::remove_particle_in")) return;
     if (std::find(m_particles_in.begin(), m_particles_in.end(), p) == m_particles_in.end()) return;
+    if (m_event) m_event->invalidate_positions();
     p->m_end_vertex.reset();
     m_particles_in.erase(std::remove(m_particles_in.begin(), m_particles_in.end(), p), m_particles_in.end());
 }
@@ -74,46 +124,45 @@ void GenVertex::remove_particle_in(GenParticlePtr p) {
 
 void GenVertex::remove_particle_out(GenParticlePtr p) {
     if (!p) return;
+    if (m_event && m_event->refuse_change("GenVertex::remove_particle_out")) return;
     if (std::find(m_particles_out.begin(), m_particles_out.end(), p) == m_particles_out.end()) return;
+    if (m_event) m_event->invalidate_positions();
     p->m_production_vertex.reset();
     m_particles_out.erase(std::remove(m_particles_out.begin(), m_particles_out.end(), p), m_particles_out.end());
 }
 
 void GenVertex::set_id(int id) {
     m_id = id;
+    if (m_event) m_event->invalidate_positions();
 }
 
 
 const std::vector<ConstGenParticlePtr>& GenVertex::particles_in()const {
-    return *(reinterpret_cast<const std::vector<ConstGenParticlePtr>*>(&m_particles_in));
+    return *(reinterpret_cast<const std::vector<ConstGenParticlePtr>*>(&m_particles_in.vector()));
 }
 
 const std::vector<ConstGenParticlePtr>& GenVertex::particles_out()const {
-    return *(reinterpret_cast<const std::vector<ConstGenParticlePtr>*>(&m_particles_out));
+    return *(reinterpret_cast<const std::vector<ConstGenParticlePtr>*>(&m_particles_out.vector()));
 }
 
 const FourVector& GenVertex::position() const {
     if ( has_set_position() ) return m_data.position;
 
-    // No position information - look at event and/or search ancestors
-    if ( parent_event() )
-    {
-        std::shared_ptr<IntAttribute> cycles = parent_event()->attribute<IntAttribute>("cycles");
-        //This could be a recussive call.  Try to prevent it.
-        if (!cycles || cycles->value() == 0)
-        {
-            for (const auto& p: m_particles_in) {
-                ConstGenVertexPtr v = p->production_vertex();
-                if (v) return v->position();
-            }
-        }
-        return parent_event()->event_pos();
-    }
+    // No position information - the event resolves the positions of all
+    // vertices from their ancestors at once and caches them
+    if ( parent_event() ) return parent_event()->resolved_position(this);
     return FourVector::ZERO_VECTOR();
 }
 
+void GenVertex::set_status(int stat) {
+    if (m_event && m_event->refuse_change("GenVertex::set_status")) return;
+    m_data.status = stat;
+}
+
 void GenVertex::set_position(const FourVector& new_pos) {
+    if (m_event && m_event->refuse_change("GenVertex::set_position")) return;
     m_data.position = new_pos;
+    if (m_event) m_event->invalidate_positions();
 }
 
 bool GenVertex::add_attribute(const std::string& name, std::shared_ptr<Attribute> att) {
@@ -0,0 +1,174 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+/**
+ *  @file LorentzTransform.cc
+ *  @brief Implementation of \b class LorentzTransformT
+ *
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "HepMC3/LorentzTransform.h"
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/Setup.h"
+
+namespace HepMC3 {
+
+namespace {
+/// Number of four-vectors transformed per batch
+const size_t batch_size = 256;
+}
+
+template <class T>
+LorentzTransformT<T>::LorentzTransformT() {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) m_matrix[i][j] = (i == j) ? T(1) : T(0);
+    }
+}
+
+template <class T>
+void LorentzTransformT<T>::multiply_left(const T m[4][4]) {
+    T r[4][4];
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            r[i][j] = m[i][0]*m_matrix[0][j] + m[i][1]*m_matrix[1][j] + m[i][2]*m_matrix[2][j] + m[i][3]*m_matrix[3][j];
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) m_matrix[i][j] = r[i][j];
+    }
+}
+
+template <class T>
+bool LorentzTransformT<T>::boost(const FourVector& delta) {
+    const double deltalength2d = delta.length2();
+    if (deltalength2d > 1.0)
+    {
+        HEPMC3_WARNING("LorentzTransform::boost: wrong large boost vector. Will leave transformation as is.")
+        return false;
+    }
+    if (std::abs(deltalength2d-1.0) < std::numeric_limits<double>::epsilon())
+    {
+        HEPMC3_WARNING("LorentzTransform::boost: too large gamma. Will leave transformation as is.")
+        return false;
+    }
+    if (std::abs(deltalength2d) < std::numeric_limits<double>::epsilon())
+    {
+        HEPMC3_WARNING("LorentzTransform::boost: wrong small boost vector. Will leave transformation as is.")
+        return true;
+    }
+    const T beta[3] = { T(delta.x()), T(delta.y()), T(delta.z()) };
+    const T beta2 = beta[0]*beta[0] + beta[1]*beta[1] + beta[2]*beta[2];
+    const T gamma = T(1)/std::sqrt(T(1) - beta2);
+
+    T m[4][4];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) m[i][j] = (i == j ? T(1) : T(0)) + (gamma - T(1))*beta[i]*beta[j]/beta2;
+        m[i][3] = -gamma*beta[i];
+        m[3][i] = -gamma*beta[i];
+    }
+    m[3][3] = gamma;
+    multiply_left(m);
+    return true;
+}
+
+template <class T>
+bool LorentzTransformT<T>::rotate(const FourVector& delta) {
+    const T cosa = std::cos(T(delta.x()));
+    const T sina = std::sin(T(delta.x()));
+    const T cosb = std::cos(T(delta.y()));
+    const T sinb = std::sin(T(delta.y()));
+    const T cosg = std::cos(T(delta.z()));
+    const T sing = std::sin(T(delta.z()));
+
+    // Rotation around z after rotation around y after rotation around x
+    const T m[4][4] = {
+        { cosg*cosb, sing*cosa + cosg*sinb*sina, sing*sina - cosg*sinb*cosa, T(0) },
+        { -sing*cosb, cosg*cosa - sing*sinb*sina, cosg*sina + sing*sinb*cosa, T(0) },
+        { sinb, -cosb*sina, cosb*cosa, T(0) },
+        { T(0), T(0), T(0), T(1) }
+    };
+    multiply_left(m);
+    return true;
+}
+
+template <class T>
+bool LorentzTransformT<T>::reflect(const int axis) {
+    if ( axis > 3 || axis < 0 )
+    {
+        HEPMC3_WARNING("LorentzTransform::reflect: wrong axis")
+        return false;
+    }
+    for (int j = 0; j < 4; ++j) m_matrix[axis][j] = -m_matrix[axis][j];
+    return true;
+}
+
+template <class T>
+LorentzTransformT<T> LorentzTransformT<T>::operator*(const LorentzTransformT& other) const {
+    LorentzTransformT result(other);
+    result.multiply_left(m_matrix);
+    return result;
+}
+
+template <class T>
+FourVector LorentzTransformT<T>::operator()(const FourVector& v) const {
+    double x = v.x(), y = v.y(), z = v.z(), t = v.t();
+    apply(&x, &y, &z, &t, 1);
+    return FourVector(x, y, z, t);
+}
+
+template <class T>
+void LorentzTransformT<T>::apply(double* x, double* y, double* z, double* t, const size_t n) const {
+    const T m00 = m_matrix[0][0], m01 = m_matrix[0][1], m02 = m_matrix[0][2], m03 = m_matrix[0][3];
+    const T m10 = m_matrix[1][0], m11 = m_matrix[1][1], m12 = m_matrix[1][2], m13 = m_matrix[1][3];
+    const T m20 = m_matrix[2][0], m21 = m_matrix[2][1], m22 = m_matrix[2][2], m23 = m_matrix[2][3];
+    const T m30 = m_matrix[3][0], m31 = m_matrix[3][1], m32 = m_matrix[3][2], m33 = m_matrix[3][3];
+    for (size_t i = 0; i < n; ++i) {
+        const T xi = x[i], yi = y[i], zi = z[i], ti = t[i];
+        x[i] = double(m00*xi + m01*yi + m02*zi + m03*ti);
+        y[i] = double(m10*xi + m11*yi + m12*zi + m13*ti);
+        z[i] = double(m20*xi + m21*yi + m22*zi + m23*ti);
+        t[i] = double(m30*xi + m31*yi + m32*zi + m33*ti);
+    }
+}
+
+template <class T>
+void LorentzTransformT<T>::apply(GenEvent& evt, const bool positions) const {
+    double x[batch_size], y[batch_size], z[batch_size], t[batch_size];
+
+    const std::vector<GenParticlePtr>& particles = evt.particles();
+    for (size_t first = 0; first < particles.size(); first += batch_size) {
+        const size_t n = std::min(batch_size, particles.size() - first);
+        for (size_t i = 0; i < n; ++i) {
+            const FourVector& mom = particles[first + i]->momentum();
+            x[i] = mom.x(); y[i] = mom.y(); z[i] = mom.z(); t[i] = mom.e();
+        }
+        apply(x, y, z, t, n);
+        for (size_t i = 0; i < n; ++i) particles[first + i]->set_momentum(FourVector(x[i], y[i], z[i], t[i]));
+    }
+    if ( !positions ) return;
+
+    std::vector<GenVertexPtr> vertices;
+    vertices.reserve(evt.vertices().size());
+    for (const GenVertexPtr& v: evt.vertices()) if ( v->has_set_position() ) vertices.emplace_back(v);
+    for (size_t first = 0; first < vertices.size(); first += batch_size) {
+        const size_t n = std::min(batch_size, vertices.size() - first);
+        for (size_t i = 0; i < n; ++i) {
+            const FourVector& pos = vertices[first + i]->position();
+            x[i] = pos.x(); y[i] = pos.y(); z[i] = pos.z(); t[i] = pos.t();
+        }
+        apply(x, y, z, t, n);
+        for (size_t i = 0; i < n; ++i) vertices[first + i]->set_position(FourVector(x[i], y[i], z[i], t[i]));
+    }
+}
+
+template class LorentzTransformT<double>;
+template class LorentzTransformT<long double>;
+
+} // namespace HepMC3
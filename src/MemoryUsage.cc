@@ -0,0 +1,88 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+/**
+ *  @file MemoryUsage.cc
+ *  @brief Implementation of \b struct MemoryUsage and \b class MemoryUsageStatistics
+ *
+ */
+#include <algorithm> // min, max
+#include <iomanip>
+
+#include "HepMC3/Attribute.h"
+#include "HepMC3/MemoryUsage.h"
+
+namespace HepMC3 {
+
+namespace {
+/// Parts of MemoryUsage, in the order of printing
+size_t MemoryUsage::* const parts[] = { &MemoryUsage::particles, &MemoryUsage::vertices, &MemoryUsage::links,
+                                        &MemoryUsage::attributes, &MemoryUsage::strings, &MemoryUsage::weights, &MemoryUsage::arena
+                                      };
+/// Names of the parts
+const char* const part_names[] = { "particles", "vertices", "links", "attributes", "strings", "weights", "arena" };
+}
+
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other) {
+    particles  += other.particles;
+    vertices   += other.vertices;
+    links      += other.links;
+    attributes += other.attributes;
+    strings    += other.strings;
+    weights    += other.weights;
+    arena      += other.arena;
+    return *this;
+}
+
+void MemoryUsage::add_attribute(const Attribute& att) {
+    // The size of the derived class is not known, the base class is counted
+    attributes += sizeof(Attribute) + shared_overhead;
+    // StringAttribute keeps its value in the unparsed string, counted once here
+    strings += string_heap(att.unparsed_string());
+}
+
+size_t MemoryUsage::string_heap(const std::string& s) {
+    // Short strings are stored inside the object
+    static const size_t local_capacity = std::string().capacity();
+    return s.capacity() > local_capacity ? s.capacity() + 1 : 0;
+}
+
+void MemoryUsageStatistics::add(const MemoryUsage& usage) {
+    if ( m_count == 0 ) {
+        m_min = usage;
+        m_max = usage;
+        m_min_total = m_max_total = usage.total();
+    }
+    else {
+        for (size_t MemoryUsage::* part: parts) {
+            m_min.*part = std::min(m_min.*part, usage.*part);
+            m_max.*part = std::max(m_max.*part, usage.*part);
+        }
+        m_min_total = std::min(m_min_total, usage.total());
+        m_max_total = std::max(m_max_total, usage.total());
+    }
+    m_sum += usage;
+    ++m_count;
+}
+
+MemoryUsage MemoryUsageStatistics::mean() const {
+    MemoryUsage result;
+    if ( m_count == 0 ) return result;
+    for (size_t MemoryUsage::* part: parts) result.*part = m_sum.*part/m_count;
+    return result;
+}
+
+void MemoryUsageStatistics::print(std::ostream& os) const {
+    const MemoryUsage avg = mean();
+    os << "Memory usage of " << m_count << " events in bytes (min/mean/max):" << std::endl;
+    for (size_t i = 0; i < 7; ++i) {
+        os << "  " << std::left << std::setw(11) << part_names[i] << std::right
+           << std::setw(12) << m_min.*parts[i] << std::setw(12) << avg.*parts[i] << std::setw(12) << m_max.*parts[i] << std::endl;
+    }
+    os << "  " << std::left << std::setw(11) << "total" << std::right
+       << std::setw(12) << m_min_total << std::setw(12) << avg.total() << std::setw(12) << m_max_total << std::endl;
+}
+
+} // namespace HepMC3
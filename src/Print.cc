@@ -142,7 +142,7 @@ void Print::listing(std::ostream& os, ConstGenVertexPtr v) {
     bool printed_header = false;
 
     // Print out all the incoming particles
-    for (const ConstGenParticlePtr& p: v->particles_in()) {
+    for (const ConstGenParticlePtr& p: v->particles_in_span()) {
         if ( !printed_header ) {
             os << " I: ";
             printed_header = true;
@@ -155,7 +155,7 @@ void Print::listing(std::ostream& os, ConstGenVertexPtr v) {
     printed_header = false;
 
     // Print out all the outgoing particles
-    for (const ConstGenParticlePtr& p: v->particles_out()) {
+    for (const ConstGenParticlePtr& p: v->particles_out_span()) {
         if ( !printed_header ) {
             os << " O: ";
             printed_header = true;
@@ -229,9 +229,9 @@ void Print::line(std::ostream& os, ConstGenVertexPtr v, bool attributes) {
     os << "GenVertex:  " << v->id() << " stat: ";
     os.width(3);
     os << v->status();
-    os << " in: "  << v->particles_in().size();
+    os << " in: "  << v->particles_in_span().size();
     os.width(3);
-    os << " out: " << v->particles_out().size();
+    os << " out: " << v->particles_out_span().size();
 
     const FourVector &pos = v->position();
     os << " has_set_position: ";
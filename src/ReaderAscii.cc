@@ -8,8 +8,14 @@
 /// @brief Implementation of \b class ReaderAscii
 ///
 #include <array>
+#include <cstdlib>
 #include <cstring>
 #include <sstream>
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
 
 #include "HepMC3/ReaderAscii.h"
 
@@ -20,18 +26,54 @@
 
 namespace HepMC3 {
 
+namespace {
+/// Size of the blocks read from files
+const size_t block_size = 1 << 20;
+/// Size of the line buffer for streams
+const size_t line_size = 262144;
+
+/// Integer at @a s, skipping leading spaces, independent of the locale
+int to_int(const char* s) {
+    while ( *s == ' ' ) ++s;
+    const bool negative = (*s == '-');
+    if ( *s == '-' || *s == '+' ) ++s;
+    int value = 0;
+    for (; *s >= '0' && *s <= '9'; ++s) value = 10*value + (*s - '0');
+    return negative ? -value : value;
+}
+
+/// Floating point number at @a s, skipping leading spaces
+double to_double(const char* s) {
+#ifdef __cpp_lib_to_chars
+    while ( *s == ' ' ) ++s;
+    if ( *s == '+' ) ++s;
+    const char* end = s;
+    while ( *end && *end != ' ' ) ++end;
+    double value = 0.0;
+    if ( std::from_chars(s, end, value).ec == std::errc() ) return value;
+#endif
+    return std::strtod(s, nullptr);
+}
+}
 
 ReaderAscii::ReaderAscii(const std::string &filename)
-    : m_file(filename), m_stream(nullptr), m_isstream(false)
+    : m_file(filename), m_stream(&m_file), m_isstream(false), m_filename(filename), m_offset(0),
+      m_begin(0), m_end(0), m_blocks(false), m_state(std::ios::goodbit), m_indexed(false)
 {
     if ( !m_file.is_open() ) {
         HEPMC3_ERROR("ReaderAscii: could not open input file: " << filename)
     }
+    // Seekable files are read in blocks, named pipes line by line as streams
+    else if ( m_file.rdbuf()->pubseekoff(0, std::ios::cur, std::ios::in) != std::streampos(-1) ) {
+        m_blocks = true;
+    }
+    m_buffer.resize(m_blocks ? block_size + 1 : line_size);
     set_run_info(std::make_shared<GenRunInfo>());
 }
 
 ReaderAscii::ReaderAscii(std::istream & stream)
-    : m_stream(&stream), m_isstream(true)
+    : m_stream(&stream), m_isstream(true), m_buffer(line_size), m_offset(0),
+      m_begin(0), m_end(0), m_blocks(false), m_state(std::ios::goodbit), m_indexed(false)
 {
     if ( !m_stream->good() ) {
         HEPMC3_ERROR("ReaderAscii: could not open input stream ")
@@ -41,7 +83,8 @@ ReaderAscii::ReaderAscii(std::istream & stream)
 
 
 ReaderAscii::ReaderAscii(std::shared_ptr<std::istream> s_stream)
-    : m_shared_stream(s_stream), m_stream(s_stream.get()), m_isstream(true)
+    : m_shared_stream(s_stream), m_stream(s_stream.get()), m_isstream(true), m_buffer(line_size), m_offset(0),
+      m_begin(0), m_end(0), m_blocks(false), m_state(std::ios::goodbit), m_indexed(false)
 {
     if ( !m_stream->good() ) {
         HEPMC3_ERROR("ReaderAscii: could not open input stream ")
@@ -49,39 +92,53 @@ ReaderAscii::ReaderAscii(std::shared_ptr<std::istream> s_stream)
     set_run_info(std::make_shared<GenRunInfo>());
 }
 
+ReaderAscii::ReaderAscii(std::vector<char> text)
+    : m_stream(nullptr), m_isstream(true), m_buffer(std::move(text)), m_offset(0),
+      m_begin(0), m_end(m_buffer.size()), m_blocks(true), m_state(std::ios::goodbit), m_indexed(false)
+{
+    // The text is the only block, with room for the terminating character of the last line
+    m_buffer.push_back('\0');
+    set_run_info(std::make_shared<GenRunInfo>());
+}
+
 ReaderAscii::~ReaderAscii() { if (!m_isstream) close(); }
 
 bool ReaderAscii::skip(const int n)
 {
-    std::array<char, 262144> buf;
+    if ( m_indexed ) {
+        if ( failed() ) return false;
+        const size_t next = m_index.event_at(m_offset + m_begin);
+        return seek_event(next + (n > 0 ? n : 0));
+    }
+    const char*        line = nullptr;
     bool               event_context    = false;
     bool               run_info_context    = false;
     int nn = n;
     while (!failed()) {
         char  peek(0);
         if ( (!m_file.is_open()) && (!m_isstream) ) return false;
-        m_isstream ? peek = m_stream->peek() : peek = m_file.peek();
+        peek = peek_char();
         if ( peek == 'E' ) { event_context = true; nn--; }
         //We have to read each run info.
         if ( !event_context && ( peek == 'W' || peek == 'A' || peek == 'T' ) ) {
-            m_isstream ? m_stream->getline(buf.data(), buf.size()) : m_file.getline(buf.data(), buf.size());
+            line = next_line();
             if (!run_info_context) {
                 set_run_info(std::make_shared<GenRunInfo>());
                 run_info_context = true;
             }
             if ( peek == 'W' ) {
-                parse_weight_names(buf.data());
+                parse_weight_names(line);
             }
             if ( peek == 'T' ) {
-                parse_tool(buf.data());
+                parse_tool(line);
             }
             if ( peek == 'A' ) {
-                parse_run_attribute(buf.data());
+                parse_run_attribute(line);
             }
         }
         if ( event_context && ( peek == 'V' || peek == 'P' ) ) event_context=false;
         if (nn < 0) return true;
-        m_isstream ? m_stream->getline(buf.data(), buf.size()) : m_file.getline(buf.data(), buf.size());
+        next_line();
     }
     return true;
 }
@@ -91,7 +148,7 @@ bool ReaderAscii::read_event(GenEvent &evt) {
     if ( (!m_file.is_open()) && (!m_isstream) ) return false;
 
     char               peek(0);
-    std::array<char, 262144> buf;
+    const char*        buf = "";
     bool               event_context    = false;
     bool               parsed_weights    = false;
     bool               parsed_particles_or_vertices    = false;
@@ -101,23 +158,38 @@ bool ReaderAscii::read_event(GenEvent &evt) {
 
     evt.clear();
     evt.set_run_info(run_info());
+    m_data.event_number = 0;
+    m_data.momentum_unit = evt.momentum_unit();
+    m_data.length_unit = evt.length_unit();
+    m_data.event_pos = FourVector::ZERO_VECTOR();
+    m_data.particles.clear();
+    m_data.vertices.clear();
+    m_data.weights.clear();
+    m_data.links1.clear();
+    m_data.links2.clear();
+    m_data.attribute_id.clear();
+    m_data.attribute_name.clear();
+    m_data.attribute_string.clear();
+    m_vertex_ids.clear();
+    m_vertex_index.clear();
+    m_end_vertices.clear();
     m_forward_daughters.clear();
     m_forward_mothers.clear();
     //
     // Parse event, vertex and particle information
     //
     while (!failed()) {
-        m_isstream ? m_stream->getline(buf.data(), buf.size()) : m_file.getline(buf.data(), buf.size());
+        buf = next_line();
 
-        if ( strlen(buf.data()) == 0 ) continue;
+        if ( buf[0] == '\0' ) continue;
 
         // Check for ReaderAscii header/footer
-        if ( strncmp(buf.data(), "HepMC", 5) == 0 ) {
-            if ( strncmp(buf.data(), "HepMC::Version", 14) != 0 && strncmp(buf.data(), "HepMC::Asciiv3", 14) != 0 )
+        if ( strncmp(buf, "HepMC", 5) == 0 ) {
+            if ( strncmp(buf, "HepMC::Version", 14) != 0 && strncmp(buf, "HepMC::Asciiv3", 14) != 0 )
             {
                 HEPMC3_WARNING("ReaderAscii: found unsupported expression in header. Will close the input.")
-                std::cout << buf.data() << std::endl;
-                m_isstream ? m_stream->clear(std::ios::eofbit) : m_file.clear(std::ios::eofbit);
+                std::cout << buf << std::endl;
+                set_state(std::ios::eofbit);
             }
             if (event_context) {
                 is_parsing_successful = true;
@@ -128,7 +200,7 @@ bool ReaderAscii::read_event(GenEvent &evt) {
 
         switch (buf[0]) {
         case 'E':
-            vertices_and_particles = parse_event_information(evt, buf.data());
+            vertices_and_particles = parse_event_information(buf);
             if (vertices_and_particles.second < 0) {
                 is_parsing_successful = false;
             } else {
@@ -140,16 +212,16 @@ bool ReaderAscii::read_event(GenEvent &evt) {
             run_info_context   = false;
             break;
         case 'V':
-            is_parsing_successful = parse_vertex_information(evt, buf.data());
+            is_parsing_successful = parse_vertex_information(buf);
             parsed_particles_or_vertices =  true;
             break;
         case 'P':
-            is_parsing_successful = parse_particle_information(evt, buf.data());
+            is_parsing_successful = parse_particle_information(buf);
             parsed_particles_or_vertices =  true;
             break;
         case 'W':
             if ( event_context ) {
-                is_parsing_successful = parse_weight_values(evt, buf.data());
+                is_parsing_successful = parse_weight_values(buf);
                 parsed_weights=true;
             } else {
                 if ( !run_info_context ) {
@@ -157,11 +229,11 @@ bool ReaderAscii::read_event(GenEvent &evt) {
                     evt.set_run_info(run_info());
                 }
                 run_info_context = true;
-                is_parsing_successful = parse_weight_names(buf.data());
+                is_parsing_successful = parse_weight_names(buf);
             }
             break;
         case 'U':
-            is_parsing_successful = parse_units(evt, buf.data());
+            is_parsing_successful = parse_units(buf);
             break;
         case 'T':
             if ( event_context ) {
@@ -172,19 +244,19 @@ bool ReaderAscii::read_event(GenEvent &evt) {
                     evt.set_run_info(run_info());
                 }
                 run_info_context = true;
-                is_parsing_successful = parse_tool(buf.data());
+                is_parsing_successful = parse_tool(buf);
             }
             break;
         case 'A':
             if ( event_context ) {
-                is_parsing_successful = parse_attribute(evt, buf.data());
+                is_parsing_successful = parse_attribute(buf);
             } else {
                 if ( !run_info_context ) {
                     set_run_info(std::make_shared<GenRunInfo>());
                     evt.set_run_info(run_info());
                 }
                 run_info_context = true;
-                is_parsing_successful = parse_run_attribute(buf.data());
+                is_parsing_successful = parse_run_attribute(buf);
             }
             break;
         default:
@@ -196,7 +268,7 @@ bool ReaderAscii::read_event(GenEvent &evt) {
         if ( !is_parsing_successful ) break;
 
         // Check for next event or run info
-        m_isstream ? peek = m_stream->peek() : peek = m_file.peek();
+        peek = peek_char();
         //End of event. The next entry is event.
         if ( event_context &&  peek == 'E' ) break;
 
@@ -214,70 +286,122 @@ bool ReaderAscii::read_event(GenEvent &evt) {
 
 
     // Check if all particles and vertices were parsed
-    if ((int)evt.particles().size() > vertices_and_particles.second) {
+    if ((int)m_data.particles.size() > vertices_and_particles.second) {
         HEPMC3_ERROR("ReaderAscii: too many particles were parsed")
-        printf("%zu  vs  %i expected\n", evt.particles().size(), vertices_and_particles.second);
+        printf("%zu  vs  %i expected\n", m_data.particles.size(), vertices_and_particles.second);
         is_parsing_successful = false;
     }
-    if ((int)evt.particles().size() < vertices_and_particles.second) {
+    if ((int)m_data.particles.size() < vertices_and_particles.second) {
         HEPMC3_ERROR("ReaderAscii: too few  particles were parsed")
-        printf("%zu  vs  %i expected\n", evt.particles().size(), vertices_and_particles.second);
+        printf("%zu  vs  %i expected\n", m_data.particles.size(), vertices_and_particles.second);
         is_parsing_successful = false;
     }
 
-    if ((int)evt.vertices().size()  > vertices_and_particles.first) {
+    if ((int)m_data.vertices.size()  > vertices_and_particles.first) {
         HEPMC3_ERROR("ReaderAscii: too many vertices were parsed")
-        printf("%zu  vs  %i expected\n", evt.vertices().size(), vertices_and_particles.first);
+        printf("%zu  vs  %i expected\n", m_data.vertices.size(), vertices_and_particles.first);
         is_parsing_successful =  false;
     }
 
-    if ((int)evt.vertices().size()  < vertices_and_particles.first) {
+    if ((int)m_data.vertices.size()  < vertices_and_particles.first) {
         HEPMC3_ERROR("ReaderAscii: too few vertices were parsed")
-        printf("%zu  vs  %i expected\n", evt.vertices().size(), vertices_and_particles.first);
+        printf("%zu  vs  %i expected\n", m_data.vertices.size(), vertices_and_particles.first);
         is_parsing_successful =  false;
     }
     // Check if there were HEPMC3_ERRORs during parsing
     if ( !is_parsing_successful ) {
         HEPMC3_ERROR("ReaderAscii: event parsing failed. Returning empty event")
-        HEPMC3_DEBUG(1, "Parsing failed at line:" << std::endl << buf.data())
+        HEPMC3_DEBUG(1, "Parsing failed at line:" << std::endl << buf)
 
         evt.clear();
-        m_isstream ? m_stream->clear(std::ios::badbit) : m_file.clear(std::ios::badbit);
+        set_state(std::ios::badbit);
 
         return false;
     }
-    for (const auto& p : m_forward_daughters )
-    {
-        for (const auto& v: evt.vertices()) {
-            if (p.second == v->id()) {
-                v->add_particle_out(p.first);
-            }
+    build_event(evt);
+
+    return true;
+}
+
+
+void ReaderAscii::link_in(const int& particle, const int& vertex) {
+    m_data.links1.emplace_back(particle);
+    m_data.links2.emplace_back(-vertex - 1);
+    m_end_vertices[particle - 1] = vertex;
+}
+
+
+void ReaderAscii::build_event(GenEvent &evt) {
+    const int n_vertices = m_data.vertices.size();
+    const int n_particles = m_data.particles.size();
+    for (const auto& p: m_forward_daughters) {
+        auto it = m_vertex_index.find(p.second);
+        if ( it == m_vertex_index.end() ) continue;
+        m_data.links1.emplace_back(-it->second - 1);
+        m_data.links2.emplace_back(p.first);
+    }
+    for (const auto& v: m_forward_mothers) {
+        if ( v.second > n_particles ) {
+            HEPMC3_WARNING("ReaderAscii: vertex lists unknown incoming particle " << v.second)
+            continue;
         }
+        link_in(v.second, v.first);
     }
-    for ( const auto& v : m_forward_mothers )  for (const auto& idpm : v.second )  v.first->add_particle_in(evt.particles()[idpm-1]);
 
     /* restore ids of vertices using a bank of available ids*/
     std::vector<int> all_ids;
-    all_ids.reserve(evt.vertices().size());
+    all_ids.reserve(n_vertices);
     std::vector<int> filled_ids;
-    filled_ids.reserve(evt.vertices().size());
+    filled_ids.reserve(n_vertices);
     std::vector<int> diff;
-    diff.reserve(evt.vertices().size());
-    for (const auto& v: evt.vertices()) if (v->id() != 0) filled_ids.emplace_back(v->id());
-    for (int i = -((long)evt.vertices().size()); i < 0; i++) all_ids.emplace_back(i);
-    std::sort(all_ids.begin(), all_ids.end());
+    diff.reserve(n_vertices);
+    for (const int id: m_vertex_ids) if (id != 0) filled_ids.emplace_back(id);
+    for (int i = -n_vertices; i < 0; i++) all_ids.emplace_back(i);
     std::sort(filled_ids.begin(), filled_ids.end());
     //The bank of available ids is created as a difference between all range of ids and the set of used ids
     std::set_difference(all_ids.begin(), all_ids.end(), filled_ids.begin(), filled_ids.end(), std::inserter(diff, diff.begin()));
     auto it = diff.rbegin();
     //Set available ids to vertices sequentially.
-    for (const auto& v: evt.vertices()) if (v->id() == 0) { v->set_id(*it); it++;}
+    for (int& id: m_vertex_ids) if (id == 0) { id = *it; it++;}
+
+    // If the ids are -1...-N, order the vertices by id, so that the ids of
+    // the event are the ones in the file. Otherwise keep the order of the
+    // file and set the ids afterwards.
+    std::vector<int> position(n_vertices, -1);
+    bool standard_ids = true;
+    for (int i = 0; i < n_vertices && standard_ids; ++i) {
+        const int id = m_vertex_ids[i];
+        standard_ids = (id < 0 && id >= -n_vertices && position[-id - 1] < 0);
+        if ( standard_ids ) position[-id - 1] = i;
+    }
+    if ( standard_ids ) {
+        std::vector<GenVertexData> vertices(n_vertices);
+        for (int i = 0; i < n_vertices; ++i) vertices[-m_vertex_ids[i] - 1] = m_data.vertices[i];
+        m_data.vertices.swap(vertices);
+        for (size_t i = 0; i < m_data.links1.size(); ++i) {
+            int& vertex = (m_data.links1[i] < 0) ? m_data.links1[i] : m_data.links2[i];
+            vertex = m_vertex_ids[-vertex - 1];
+        }
+        evt.read_data(m_data);
+        return;
+    }
 
-    return true;
+    // The attributes refer to the ids in the file and are added once these are set
+    std::vector<int> attribute_id;
+    std::vector<std::string> attribute_name;
+    std::vector<std::string> attribute_string;
+    attribute_id.swap(m_data.attribute_id);
+    attribute_name.swap(m_data.attribute_name);
+    attribute_string.swap(m_data.attribute_string);
+    evt.read_data(m_data);
+    for (int i = 0; i < n_vertices; ++i) evt.vertices()[i]->set_id(m_vertex_ids[i]);
+    for (size_t i = 0; i < attribute_id.size(); ++i) {
+        evt.add_attribute(attribute_name[i], evt.make_string_attribute(attribute_string[i]), attribute_id[i]);
+    }
 }
 
 
-std::pair<int, int> ReaderAscii::parse_event_information(GenEvent &evt, const char *buf) {
+std::pair<int, int> ReaderAscii::parse_event_information(const char *buf) {
     static const std::pair<int, int>  err(-1, -1);
     std::pair<int, int>               ret(-1, -1);
     const char                 *cursor   = buf;
@@ -286,35 +410,35 @@ std::pair<int, int> ReaderAscii::parse_event_information(GenEvent &evt, const ch
 
     // event number
     if ( !(cursor = strchr(cursor+1, ' ')) ) return err;
-    event_no = atoi(cursor);
-    evt.set_event_number(event_no);
+    event_no = to_int(cursor);
+    m_data.event_number = event_no;
 
     // num_vertices
     if ( !(cursor = strchr(cursor+1, ' ')) ) return err;
-    ret.first = atoi(cursor);
+    ret.first = to_int(cursor);
 
     // num_particles
     if ( !(cursor = strchr(cursor+1, ' ')) ) return err;
-    ret.second = atoi(cursor);
+    ret.second = to_int(cursor);
 
     // check if there is position information
     if ( (cursor = strchr(cursor+1, '@')) ) {
         // x
         if ( !(cursor = strchr(cursor+1, ' ')) ) return err;
-        position.setX(atof(cursor));
+        position.setX(to_double(cursor));
 
         // y
         if ( !(cursor = strchr(cursor+1, ' ')) ) return err;
-        position.setY(atof(cursor));
+        position.setY(to_double(cursor));
 
         // z
         if ( !(cursor = strchr(cursor+1, ' ')) ) return err;
-        position.setZ(atof(cursor));
+        position.setZ(to_double(cursor));
 
         // t
         if ( !(cursor = strchr(cursor+1, ' ')) ) return err;
-        position.setT(atof(cursor));
-        evt.shift_position_to(position);
+        position.setT(to_double(cursor));
+        m_data.event_pos = position;
     }
 
     HEPMC3_DEBUG(10, "ReaderAscii: E: " << event_no << " (" <<ret.first << "V, " << ret.second << "P)")
@@ -323,9 +447,10 @@ std::pair<int, int> ReaderAscii::parse_event_information(GenEvent &evt, const ch
 }
 
 
-bool ReaderAscii::parse_weight_values(GenEvent &evt, const char *buf) {
+bool ReaderAscii::parse_weight_values(const char *buf) {
     std::istringstream iss(buf + 1);
-    std::vector<double> wts;
+    std::vector<double>& wts = m_data.weights;
+    wts.clear();
     double w = 0.0;
     while (iss >> w) wts.emplace_back(w);
     if ( run_info() && !run_info()->weight_names().empty()
@@ -334,13 +459,12 @@ bool ReaderAscii::parse_weight_values(GenEvent &evt, const char *buf) {
                                "The number of weights ("+std::to_string((long long int)(wts.size()))+") does not match "
                                "the  number weight names("+std::to_string((long long int)(run_info()->weight_names().size()))+") in the GenRunInfo object");
     }
-    evt.weights() = wts;
 
     return true;
 }
 
 
-bool ReaderAscii::parse_units(GenEvent &evt, const char *buf) {
+bool ReaderAscii::parse_units(const char *buf) {
     const char *cursor = buf;
 
     // momentum
@@ -353,29 +477,31 @@ bool ReaderAscii::parse_units(GenEvent &evt, const char *buf) {
     ++cursor;
     Units::LengthUnit length_unit = Units::length_unit(cursor);
 
-    evt.set_units(momentum_unit, length_unit);
+    m_data.momentum_unit = momentum_unit;
+    m_data.length_unit = length_unit;
 
-    HEPMC3_DEBUG(10, "ReaderAscii: U: " << Units::name(evt.momentum_unit()) << " " << Units::name(evt.length_unit()))
+    HEPMC3_DEBUG(10, "ReaderAscii: U: " << Units::name(momentum_unit) << " " << Units::name(length_unit))
 
     return true;
 }
 
 
-bool ReaderAscii::parse_vertex_information(GenEvent &evt, const char *buf) {
-    GenVertexPtr  data = std::make_shared<GenVertex>();
-    FourVector    position;
+bool ReaderAscii::parse_vertex_information(const char *buf) {
+    GenVertexData data = { 0, FourVector::ZERO_VECTOR() };
     const char   *cursor          = buf;
     const char   *cursor2         = nullptr;
     int           id              = 0;
-    int           highest_id      = evt.particles().size();
+    int           highest_id      = m_data.particles.size();
+    const int     index           = m_data.vertices.size();
+    int           n_in            = 0;
 
     // id
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    id = atoi(cursor);
+    id = to_int(cursor);
 
     // status
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    data->set_status(atoi(cursor));
+    data.status = to_int(cursor);
 
     // skip to the list of particles
     if ( !(cursor = strchr(cursor+1, '[')) ) return false;
@@ -383,17 +509,18 @@ bool ReaderAscii::parse_vertex_information(GenEvent &evt, const char *buf) {
     while (true) {
         ++cursor;             // skip the '[' or ',' character
         cursor2     = cursor; // save cursor position
-        int  particle_in = atoi(cursor);
+        int  particle_in = to_int(cursor);
 
         // add incoming particle to the vertex
         if (particle_in > 0) {
             //Particles are always ordered, so id==position in event.
             if (particle_in <= highest_id) {
-                data->add_particle_in(evt.particles()[particle_in-1]);
+                link_in(particle_in, index);
             } else {
                 //If the particle has not been red yet, we store its id to add the particle later.
-                m_forward_mothers[data].insert(particle_in);
+                m_forward_mothers.emplace_back(index, particle_in);
             }
+            ++n_in;
         }
 
         // check for next particle or end of particle list
@@ -407,42 +534,42 @@ bool ReaderAscii::parse_vertex_information(GenEvent &evt, const char *buf) {
     if ( (cursor = strchr(cursor+1, '@')) ) {
         // x
         if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-        position.setX(atof(cursor));
+        data.position.setX(to_double(cursor));
 
         // y
         if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-        position.setY(atof(cursor));
+        data.position.setY(to_double(cursor));
 
         // z
         if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-        position.setZ(atof(cursor));
+        data.position.setZ(to_double(cursor));
 
         // t
         if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-        position.setT(atof(cursor));
-        data->set_position(position);
+        data.position.setT(to_double(cursor));
     }
 
-    HEPMC3_DEBUG(10, "ReaderAscii: V: " << id << " with  "<< data->particles_in().size() << " particles)")
+    HEPMC3_DEBUG(10, "ReaderAscii: V: " << id << " with  "<< n_in << " particles)")
 
-    evt.add_vertex(data);
-    //Restore vertex id, as it is used to build connections inside event.
-    data->set_id(id);
+    m_data.vertices.emplace_back(data);
+    //Keep the vertex id, as it is used to build connections inside event.
+    m_vertex_ids.emplace_back(id);
+    m_vertex_index.emplace(id, index);
 
     return true;
 }
 
 
-bool ReaderAscii::parse_particle_information(GenEvent &evt, const char *buf) {
-    GenParticlePtr  data = std::make_shared<GenParticle>();
-    FourVector      momentum;
+bool ReaderAscii::parse_particle_information(const char *buf) {
+    GenParticleData data = { 0, 0, true, 0.0, FourVector::ZERO_VECTOR() };
     const char     *cursor  = buf;
     int             mother_id = 0;
+    const int       id      = m_data.particles.size() + 1;
 
     // verify id
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
 
-    if ( atoi(cursor) != (int)evt.particles().size() + 1 ) {
+    if ( to_int(cursor) != id ) {
         /// @todo Should be an exception
         HEPMC3_ERROR("ReaderAscii: particle ID mismatch")
         return false;
@@ -450,85 +577,93 @@ bool ReaderAscii::parse_particle_information(GenEvent &evt, const char *buf) {
 
     // mother id
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    mother_id = atoi(cursor);
+    mother_id = to_int(cursor);
 
     // Parent object is a particle. Particleas are always ordered id==position in event.
-    if ( mother_id > 0 && mother_id <= (int)evt.particles().size() ) {
-        GenParticlePtr mother = evt.particles()[ mother_id-1 ];
-        GenVertexPtr   vertex = mother->end_vertex();
+    if ( mother_id > 0 && mother_id < id ) {
+        int vertex = m_end_vertices[mother_id-1];
 
         // create new vertex if needed
-        if ( !vertex ) {
-            vertex = std::make_shared<GenVertex>();
-            vertex->add_particle_in(mother);
+        if ( vertex < 0 ) {
+            vertex = m_data.vertices.size();
+            m_data.vertices.push_back({ 0, FourVector::ZERO_VECTOR() });
+            m_vertex_ids.emplace_back(0);
+            link_in(mother_id, vertex);
         }
-
-        vertex->add_particle_out(data);
-        evt.add_vertex(vertex);
         //ID of this vertex is not explicitely set in the input. We set it to zero to prevent overlap with other ids. It will be restored later.
-        vertex->set_id(0);
+        else if ( m_vertex_ids[vertex] != 0 ) {
+            auto it = m_vertex_index.find(m_vertex_ids[vertex]);
+            if ( it != m_vertex_index.end() && it->second == vertex ) m_vertex_index.erase(it);
+            m_vertex_ids[vertex] = 0;
+        }
+
+        m_data.links1.emplace_back(-vertex - 1);
+        m_data.links2.emplace_back(id);
     }
     // Parent object is vertex
     else {
         if ( mother_id < 0 )
         {
             //Vertices are not always ordered, e.g. when one reads HepMC2 event, so we check their ids.
-            bool found = false;
-            for (auto v: evt.vertices()) if (v->id() == mother_id) {v->add_particle_out(data); found = true; break; }
-            if (!found)
+            auto it = m_vertex_index.find(mother_id);
+            if ( it != m_vertex_index.end() ) {
+                m_data.links1.emplace_back(-it->second - 1);
+                m_data.links2.emplace_back(id);
+            }
+            else
             {
                 //This should happen  in case of unordered event.
                 //      WARNING("ReaderAscii: Unordered event, id of mother vertex  is out of range of known ids:   " <<mother_id<<" evt.vertices().size()="<<evt.vertices().size() )
                 //Save the mother id to reconnect later.
-                m_forward_daughters[data] = mother_id;
+                m_forward_daughters.emplace_back(id, mother_id);
             }
         }
     }
     // pdg id
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    data->set_pid(atoi(cursor));
+    data.pid = to_int(cursor);
 
     // px
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    momentum.setPx(atof(cursor));
+    data.momentum.setPx(to_double(cursor));
 
     // py
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    momentum.setPy(atof(cursor));
+    data.momentum.setPy(to_double(cursor));
 
     // pz
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    momentum.setPz(atof(cursor));
+    data.momentum.setPz(to_double(cursor));
 
     // pe
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    momentum.setE(atof(cursor));
-    data->set_momentum(momentum);
+    data.momentum.setE(to_double(cursor));
 
     // m
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    data->set_generated_mass(atof(cursor));
+    data.mass = to_double(cursor);
 
     // status
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    data->set_status(atoi(cursor));
+    data.status = to_int(cursor);
 
-    evt.add_particle(data);
+    m_data.particles.emplace_back(data);
+    m_end_vertices.emplace_back(-1);
 
-    HEPMC3_DEBUG(10, "ReaderAscii: P: " << data->id() << " ( mother: " << mother_id << ", pid: " << data->pid() << ")")
+    HEPMC3_DEBUG(10, "ReaderAscii: P: " << id << " ( mother: " << mother_id << ", pid: " << data.pid << ")")
 
     return true;
 }
 
 
-bool ReaderAscii::parse_attribute(GenEvent &evt, const char *buf) {
+bool ReaderAscii::parse_attribute(const char *buf) {
     const char     *cursor  = buf;
     const char     *cursor2 = buf;
     std::array<char, 512> name;
     int             id = 0;
 
     if ( !(cursor = strchr(cursor+1, ' ')) ) return false;
-    id = atoi(cursor);
+    id = to_int(cursor);
 
     if ( !(cursor  = strchr(cursor+1, ' ')) ) return false;
     ++cursor;
@@ -538,10 +673,9 @@ bool ReaderAscii::parse_attribute(GenEvent &evt, const char *buf) {
 
     cursor = cursor2+1;
 
-    std::shared_ptr<Attribute> att =
-        std::make_shared<StringAttribute>(StringAttribute(unescape(cursor)));
-
-    evt.add_attribute(std::string(name.data()), att, id);
+    m_data.attribute_id.emplace_back(id);
+    m_data.attribute_name.emplace_back(name.data());
+    m_data.attribute_string.emplace_back(unescape(cursor));
 
     return true;
 }
@@ -622,7 +756,126 @@ std::string ReaderAscii::unescape(const std::string& s) {
     return ret;
 }
 
-bool ReaderAscii::failed() { return m_isstream ? (bool)m_stream->rdstate() :(bool)m_file.rdstate(); }
+const char* ReaderAscii::next_line() {
+    if ( !m_blocks ) {
+        m_stream->getline(m_buffer.data(), m_buffer.size());
+        return m_buffer.data();
+    }
+    size_t searched = m_begin;
+    while (true) {
+        char* eol = static_cast<char*>(memchr(m_buffer.data() + searched, '\n', m_end - searched));
+        if ( eol ) {
+            *eol = '\0';
+            const char* line = m_buffer.data() + m_begin;
+            m_begin = eol - m_buffer.data() + 1;
+            return line;
+        }
+        searched = m_end - m_begin;
+        if ( !fill_buffer() ) break;
+    }
+    // Last line without end of line character, or end of file as for std::getline
+    m_state |= std::ios::eofbit;
+    if ( m_begin == m_end ) m_state |= std::ios::failbit;
+    m_buffer[m_end] = '\0';
+    const char* line = m_buffer.data() + m_begin;
+    m_begin = m_end;
+    return line;
+}
+
+int ReaderAscii::peek_char() {
+    if ( !m_blocks ) return m_stream->peek();
+    if ( m_begin == m_end && !fill_buffer() ) {
+        m_state |= std::ios::eofbit;
+        return std::char_traits<char>::eof();
+    }
+    return m_buffer[m_begin];
+}
+
+bool ReaderAscii::fill_buffer() {
+    if ( !m_file.is_open() || m_file.eof() ) return false;
+    // Keep the unread data, growing the buffer for lines longer than a block
+    const size_t unread = m_end - m_begin;
+    if ( m_begin > 0 ) memmove(m_buffer.data(), m_buffer.data() + m_begin, unread);
+    m_offset += m_begin;
+    m_begin = 0;
+    m_end = unread;
+    if ( m_end + 1 == m_buffer.size() ) m_buffer.resize(2*m_buffer.size() - 1);
+    m_file.read(m_buffer.data() + m_end, m_buffer.size() - 1 - m_end);
+    m_end += m_file.gcount();
+    return m_end > unread;
+}
+
+bool ReaderAscii::load_index(const std::string& index_file) {
+    if ( !m_blocks || !m_file.is_open() ) {
+        HEPMC3_WARNING("ReaderAscii::load_index: an index can only be used for regular files")
+        return false;
+    }
+    EventIndex index;
+    if ( index.read(index_file.empty() ? EventIndex::sidecar_name(m_filename) : index_file) && set_index(index) ) return true;
+    return set_index(EventIndex::scan(m_filename));
+}
+
+bool ReaderAscii::set_index(const EventIndex& index) {
+    if ( !m_blocks || !m_file.is_open() ) return false;
+    // The size of the file is compared as a check that the index belongs to it
+    const std::streampos end = m_file.rdbuf()->pubseekoff(0, std::ios::end, std::ios::in);
+    if ( index.file_size() != (int64_t)end ) {
+        HEPMC3_WARNING("ReaderAscii::set_index: the index does not match the size of the file " << m_filename)
+        return false;
+    }
+    m_file.clear();
+    m_file.seekg(m_offset + m_end);
+    m_index = index;
+    m_indexed = true;
+    return true;
+}
+
+bool ReaderAscii::seek_event(const size_t& n) {
+    if ( !m_indexed || m_state & std::ios::badbit ) return false;
+    const int64_t position = m_offset + m_begin;
+    if ( n >= m_index.size() ) {
+        m_begin = m_end;
+        m_state |= std::ios::eofbit;
+        return false;
+    }
+    // Read the run information in effect for the event, unless it was the last one read
+    const int64_t run_info_offset = m_index.run_info_offset(n);
+    if ( run_info_offset != m_index.run_info_before(position) ) {
+        if ( run_info_offset < 0 ) {
+            set_run_info(std::make_shared<GenRunInfo>());
+        } else {
+            m_file.clear();
+            m_file.seekg(run_info_offset);
+            m_offset = run_info_offset;
+            m_begin = m_end = 0;
+            m_state = std::ios::goodbit;
+            bool run_info_context = false;
+            for (int peek = peek_char(); peek == 'W' || peek == 'A' || peek == 'T'; peek = peek_char()) {
+                const char* line = next_line();
+                if ( !run_info_context ) set_run_info(std::make_shared<GenRunInfo>());
+                run_info_context = true;
+                if ( peek == 'W' ) parse_weight_names(line);
+                if ( peek == 'T' ) parse_tool(line);
+                if ( peek == 'A' ) parse_run_attribute(line);
+            }
+        }
+    }
+    m_file.clear();
+    m_file.seekg(m_index.event_offset(n));
+    m_offset = m_index.event_offset(n);
+    m_begin = m_end = 0;
+    m_state = std::ios::goodbit;
+    return true;
+}
+
+long ReaderAscii::size() const { return m_indexed ? (long)m_index.size() : -1; }
+
+void ReaderAscii::set_state(std::ios::iostate state) {
+    if ( m_blocks ) m_state = state;
+    else m_stream->clear(state);
+}
+
+bool ReaderAscii::failed() { return m_blocks ? m_state != std::ios::goodbit : (bool)m_stream->rdstate(); }
 
 void ReaderAscii::close() {
     if ( !m_file.is_open()) return;
@@ -80,9 +80,6 @@ bool ReaderAsciiHepMC2::read_event(GenEvent &evt) {
     unsigned int  current_vertex_particles_count = 0;
     unsigned int  current_vertex_particles_parsed = 0;
 
-    evt.clear();
-    evt.set_run_info(run_info());
-
     // Empty cache
     m_vertex_cache.clear();
     m_vertex_barcodes.clear();
@@ -91,6 +88,9 @@ bool ReaderAsciiHepMC2::read_event(GenEvent &evt) {
     m_end_vertex_barcodes.clear();
     m_particle_cache_ghost.clear();
     m_vertex_cache_ghost.clear();
+
+    evt.clear();
+    evt.set_run_info(run_info());
     //
     // Parse event, vertex and particle information
     //
@@ -143,7 +143,7 @@ bool ReaderAsciiHepMC2::read_event(GenEvent &evt) {
             }
             current_vertex_particles_parsed = 0;
 
-            parsing_result = parse_vertex_information(buf.data());
+            parsing_result = parse_vertex_information(evt, buf.data());
 
             if (parsing_result < 0) {
                 is_parsing_successful = false;
@@ -156,7 +156,7 @@ bool ReaderAsciiHepMC2::read_event(GenEvent &evt) {
             break;
         case 'P':
 
-            parsing_result   = parse_particle_information(buf.data());
+            parsing_result   = parse_particle_information(evt, buf.data());
 
             if (parsing_result < 0) {
                 is_parsing_successful = false;
@@ -237,12 +237,12 @@ bool ReaderAsciiHepMC2::read_event(GenEvent &evt) {
 
     // Remove vertices with no incoming particles or no outgoing particles
     for (unsigned int i = 0; i < m_vertex_cache.size(); ++i) {
-        if ( m_vertex_cache[i]->particles_in().empty() ) {
+        if ( m_vertex_cache[i]->particles_in_span().empty() ) {
             HEPMC3_DEBUG(30, "ReaderAsciiHepMC2::read_event - found a vertex without incoming particles: " << m_vertex_cache[i]->id() );
             //Sometimes the root vertex has no incoming particles.  Here we try to save the event.
             std::vector<GenParticlePtr> beams;
             beams.reserve(2);
-            for (const auto& p: m_vertex_cache[i]->particles_out()) if (p->status() == 4 && !(p->end_vertex())) beams.emplace_back(p);
+            for (const auto& p: m_vertex_cache[i]->particles_out_span()) if (p->status() == 4 && !(p->end_vertex())) beams.emplace_back(p);
             for (auto& p: beams)
             {
                 m_vertex_cache[i]->add_particle_in(p);
@@ -254,7 +254,7 @@ bool ReaderAsciiHepMC2::read_event(GenEvent &evt) {
                 m_vertex_cache[i] = nullptr;
             }
         }
-        else if ( m_vertex_cache[i]->particles_out().empty() ) {
+        else if ( m_vertex_cache[i]->particles_out_span().empty() ) {
             m_vertex_cache[i] = nullptr;
             HEPMC3_DEBUG(30, "ReaderAsciiHepMC2::read_event - removed vertex without outgoing particles: " << m_vertex_cache[i]->id());
         }
@@ -337,6 +337,9 @@ bool ReaderAsciiHepMC2::read_event(GenEvent &evt) {
     m_particle_cache_ghost.clear();
     m_vertex_cache_ghost.clear();
     m_event_ghost->clear();
+    // Do not keep the objects of the event alive, so that clearing it can rewind its arena
+    m_vertex_cache.clear();
+    m_particle_cache.clear();
     return true;
 }
 
@@ -441,8 +444,8 @@ bool ReaderAsciiHepMC2::parse_units(GenEvent &evt, const char *buf) {
     return true;
 }
 
-int ReaderAsciiHepMC2::parse_vertex_information(const char *buf) {
-    GenVertexPtr  data = std::make_shared<GenVertex>();
+int ReaderAsciiHepMC2::parse_vertex_information(GenEvent &evt, const char *buf) {
+    GenVertexPtr  data = evt.make_vertex();
     GenVertexPtr  data_ghost = std::make_shared<GenVertex>();
     const char   *cursor            = buf;
     int           barcode           = 0;
@@ -480,6 +483,7 @@ int ReaderAsciiHepMC2::parse_vertex_information(const char *buf) {
     // num_particles_out
     if ( !(cursor = strchr(cursor+1, ' ')) ) return -1;
     num_particles_out = atoi(cursor);
+    if ( num_particles_out > 0 ) data->reserve(0, num_particles_out);
 
     //  weights
     if ( !(cursor = strchr(cursor+1, ' ')) ) return -1;
@@ -508,8 +512,8 @@ int ReaderAsciiHepMC2::parse_vertex_information(const char *buf) {
     return num_particles_out;
 }
 
-int ReaderAsciiHepMC2::parse_particle_information(const char *buf) {
-    GenParticlePtr  data = std::make_shared<GenParticle>();
+int ReaderAsciiHepMC2::parse_particle_information(GenEvent &evt, const char *buf) {
+    GenParticlePtr  data = evt.make_particle();
     GenParticlePtr  data_ghost = std::make_shared<GenParticle>();
     m_event_ghost->add_particle(data_ghost);
     const char     *cursor  = buf;
@@ -127,7 +127,7 @@ bool ReaderLHEF::read_event(GenEvent& ev)
 {
     if (!m_storage.empty())
     {
-        ev = m_storage.front();
+        ev = std::move(m_storage.front());
         m_storage.pop_front();
         return true;
     }
@@ -151,7 +151,7 @@ bool ReaderLHEF::read_event(GenEvent& ev)
     m_neve++;
     for (auto* ahepeup: input)
     {
-        GenEvent evt;
+        GenEvent evt(run_info());
         evt.set_event_number(first_group_event);
         evt.add_attribute("AlphaQCD", std::make_shared<DoubleAttribute>(ahepeup->AQCDUP));
         evt.add_attribute("AlphaEM", std::make_shared<DoubleAttribute>(ahepeup->AQEDUP));
@@ -190,7 +190,7 @@ bool ReaderLHEF::read_event(GenEvent& ev)
             }
         }
         for ( auto v: vertices ) {
-            if (!v.second->particles_out().empty() && !v.second->particles_in().empty()) {
+            if (!v.second->particles_out_span().empty() && !v.second->particles_in_span().empty()) {
                 evt.add_vertex(v.second);
             }
         }
@@ -237,9 +237,9 @@ bool ReaderLHEF::read_event(GenEvent& ev)
         pi->pdf_id[0] = m_hepr->heprup.PDFSUP.first;
         pi->pdf_id[1] = m_hepr->heprup.PDFSUP.second;
         evt.add_attribute("GenPdfInfo", pi);
-        m_storage.emplace_back(evt);
+        m_storage.emplace_back(std::move(evt));
     }
-    ev = m_storage.front();
+    ev = std::move(m_storage.front());
     m_storage.pop_front();
     return true;
 }
@@ -0,0 +1,68 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+/**
+ *  @file WeightHandle.cc
+ *  @brief Implementation of \b class WeightHandle and \b class WeightSet
+ *
+ */
+#include <algorithm> // max
+#include <regex>
+
+#include "HepMC3/WeightHandle.h"
+#include "HepMC3/Setup.h"
+
+namespace HepMC3 {
+
+WeightHandle::WeightHandle(const GenRunInfo& run, const std::string& name):
+    m_index(run.weight_index(name)),
+    m_run_id(run.weight_names_id()) {}
+
+WeightSet::WeightSet(const GenRunInfo& run, const std::vector<std::string>& names):
+    m_run_id(run.weight_names_id()),
+    m_max_index(-1) {
+    m_indices.reserve(names.size());
+    m_names.reserve(names.size());
+    for (const std::string& name: names) {
+        const int index = run.weight_index(name);
+        if ( index >= 0 ) add(run, index);
+    }
+}
+
+WeightSet WeightSet::matching(const GenRunInfo& run, const std::string& pattern) {
+    WeightSet result;
+    result.m_run_id = run.weight_names_id();
+    std::regex re;
+    try {
+        re.assign(pattern);
+    } catch (const std::regex_error&) {
+        HEPMC3_WARNING("WeightSet::matching: invalid regular expression " << pattern)
+        return result;
+    }
+    const std::vector<std::string>& names = run.weight_names();
+    for (size_t i = 0; i < names.size(); ++i) {
+        if ( std::regex_match(names[i], re) ) result.add(run, i);
+    }
+    return result;
+}
+
+void WeightSet::add(const GenRunInfo& run, const int& index) {
+    m_indices.push_back(index);
+    m_names.push_back(run.weight_names()[index]);
+    m_max_index = std::max(m_max_index, index);
+}
+
+void WeightSet::gather(const GenEvent& evt, double* out) const {
+    const double* weights = evt.weights().data();
+    const size_t n = m_indices.size();
+    for (size_t i = 0; i < n; ++i) out[i] = weights[m_indices[i]];
+}
+
+void WeightSet::gather(const GenEvent& evt, std::vector<double>& out) const {
+    out.resize(m_indices.size());
+    gather(evt, out.data());
+}
+
+} // namespace HepMC3
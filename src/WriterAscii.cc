@@ -10,6 +10,11 @@
 
 #include <algorithm>//min max for VS2017
 #include <cstring>
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
 
 
 #include "HepMC3/GenEvent.h"
@@ -21,6 +26,19 @@
 
 namespace HepMC3 {
 
+namespace {
+/// Write integer @a value at @a cursor, independent of the locale, @return end of the written characters
+char* format_int(char* cursor, const long long& value) {
+    char digits[20];
+    int n = 0;
+    unsigned long long u = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do { digits[n++] = '0' + u%10; u /= 10; } while ( u );
+    if ( value < 0 ) *cursor++ = '-';
+    while ( n ) *cursor++ = digits[--n];
+    return cursor;
+}
+}
+
 
 WriterAscii::WriterAscii(const std::string &filename, std::shared_ptr<GenRunInfo> run)
     : m_file(filename),
@@ -28,25 +46,18 @@ WriterAscii::WriterAscii(const std::string &filename, std::shared_ptr<GenRunInfo
       m_precision(16),
       m_buffer(nullptr),
       m_cursor(nullptr),
-      m_buffer_size(262144)
+      m_buffer_size(262144),
+      m_float_format('e'),
+      m_written(0)
 {
     set_run_info(run);
     if ( !m_file.is_open() ) {
         HEPMC3_ERROR("WriterAscii: could not open output file: " << filename)
     } else {
         const std::string header = "HepMC::Version " + version() + "\nHepMC::Asciiv3-START_EVENT_LISTING\n";
-        m_file.write(header.data(), header.length());
+        write_bytes(header.data(), header.length());
         if ( run_info() ) write_run_info();
     }
-    m_float_printf_specifier = " %." + std::to_string(m_precision) + "e";
-    m_particle_printf_specifier = "P %i %i %i"
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier + " %i\n";
-    m_vertex_short_printf_specifier = "V %i %i [%s]\n";
-    m_vertex_long_printf_specifier = "V %i %i [%s] @"+ m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + "\n";
 }
 
 
@@ -55,21 +66,14 @@ WriterAscii::WriterAscii(std::ostream &stream, std::shared_ptr<GenRunInfo> run)
       m_precision(16),
       m_buffer(nullptr),
       m_cursor(nullptr),
-      m_buffer_size(262144)
+      m_buffer_size(262144),
+      m_float_format('e'),
+      m_written(0)
 {
     set_run_info(run);
     const std::string header = "HepMC::Version " + version() + "\nHepMC::Asciiv3-START_EVENT_LISTING\n";
-    m_stream->write(header.data(), header.length());
+    write_bytes(header.data(), header.length());
     if ( run_info() ) write_run_info();
-    m_float_printf_specifier = " %." + std::to_string(m_precision) + "e";
-    m_particle_printf_specifier = "P %i %i %i"
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier + " %i\n";
-    m_vertex_short_printf_specifier = "V %i %i [%s]\n";
-    m_vertex_long_printf_specifier = "V %i %i [%s] @"+ m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + "\n";
 }
 
 WriterAscii::WriterAscii(std::shared_ptr<std::ostream> s_stream, std::shared_ptr<GenRunInfo> run)
@@ -78,21 +82,14 @@ WriterAscii::WriterAscii(std::shared_ptr<std::ostream> s_stream, std::shared_ptr
       m_precision(16),
       m_buffer(nullptr),
       m_cursor(nullptr),
-      m_buffer_size(262144)
+      m_buffer_size(262144),
+      m_float_format('e'),
+      m_written(0)
 {
     set_run_info(run);
     const std::string header = "HepMC::Version " + version() + "\nHepMC::Asciiv3-START_EVENT_LISTING\n";
-    m_stream->write(header.data(), header.length());
+    write_bytes(header.data(), header.length());
     if ( run_info() ) write_run_info();
-    m_float_printf_specifier = " %." + std::to_string(m_precision) + "e";
-    m_particle_printf_specifier = "P %i %i %i"
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier + " %i\n";
-    m_vertex_short_printf_specifier = "V %i %i [%s]\n";
-    m_vertex_long_printf_specifier = "V %i %i [%s] @"+ m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + "\n";
 }
 
 WriterAscii::~WriterAscii() {
@@ -104,21 +101,6 @@ WriterAscii::~WriterAscii() {
 void WriterAscii::write_event(const GenEvent &evt) {
     allocate_buffer();
     if ( !m_buffer ) return;
-    auto float_printf_specifier_option = m_options.find("float_printf_specifier");
-    std::string  letter=(float_printf_specifier_option != m_options.end())?float_printf_specifier_option->second.substr(0,2):"e";
-    if (letter != "e" && letter != "E" && letter != "G" && letter != "g" && letter != "f" && letter != "F" ) letter = "e";
-    m_float_printf_specifier = " %." + std::to_string(m_precision) + letter;
-
-
-    m_particle_printf_specifier = "P %i %i %i"
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier
-                                  + m_float_printf_specifier + " %i\n";
-    m_vertex_short_printf_specifier = "V %i %i [%s]\n";
-    m_vertex_long_printf_specifier = "V %i %i [%s] @"+ m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + "\n";
-
     // Make sure nothing was left from previous event
     flush();
 
@@ -135,17 +117,22 @@ void WriterAscii::write_event(const GenEvent &evt) {
 
     // Write event info
     flush();
-    std::string especifier =  "E " + std::to_string(evt.event_number()) + " "
-                              + std::to_string(evt.vertices().size()) + " "
-                              + std::to_string(evt.particles().size());
+    if ( !m_index_file.empty() ) m_index.add_event(offset());
+    *m_cursor++ = 'E';
+    write_int(evt.event_number());
+    write_int(evt.vertices().size());
+    write_int(evt.particles().size());
     // Write event position if not zero
     const FourVector &pos = evt.event_pos();
     if ( !pos.is_zero() ) {
-        especifier += ( " @"  + m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + m_float_printf_specifier + "\n" );
-        m_cursor += sprintf(m_cursor, especifier.c_str(), pos.x(), pos.y(), pos.z(), pos.t());
-    } else {
-        m_cursor += sprintf(m_cursor, "%s\n", especifier.c_str());
+        *m_cursor++ = ' ';
+        *m_cursor++ = '@';
+        write_float(pos.x(), m_float_format, m_precision);
+        write_float(pos.y(), m_float_format, m_precision);
+        write_float(pos.z(), m_float_format, m_precision);
+        write_float(pos.t(), m_float_format, m_precision);
     }
+    *m_cursor++ = '\n';
     flush();
 
     // Write units
@@ -154,13 +141,15 @@ void WriterAscii::write_event(const GenEvent &evt) {
 
     // Write weight values if present
     if ( !evt.weights().empty() ) {
-        m_cursor += sprintf(m_cursor, "W");
-        for (const auto& w: evt.weights())
-        {
-            m_cursor += sprintf(m_cursor, " %.*e", std::min(3*m_precision, 22), w);
-            flush();
+        const int precision = std::min(3*m_precision, 22);
+        *m_cursor++ = 'W';
+        const std::vector<double>& weights = evt.weights();
+        for (size_t i = 0; i < weights.size(); ++i) {
+            write_float(weights[i], 'e', precision);
+            // 16 weights fit in the space kept free by flush
+            if ( i%16 == 15 ) flush();
         }
-        m_cursor += sprintf(m_cursor, "\n");
+        *m_cursor++ = '\n';
         flush();
     }
 
@@ -196,12 +185,12 @@ void WriterAscii::write_event(const GenEvent &evt) {
         if (v) {
             // Check if we need this vertex at all
             // Yes, use vertex as parent object
-            if ( v->particles_in().size() > 1 || !v->data().is_zero() ) { parent_object = v->id(); }
+            if ( v->particles_in_span().size() > 1 || !v->data().is_zero() ) { parent_object = v->id(); }
             // No, use particle as parent object
             // Add check for attributes of this vertex
             else {
-                if ( v->particles_in().size() == 1 )                  { parent_object = v->particles_in().front()->id();}
-                else {if ( v->particles_in().empty() ) {HEPMC3_DEBUG(30, "WriterAscii::write_event - found a vertex without incoming particles: " << v->id());}}
+                if ( v->particles_in_span().size() == 1 )                  { parent_object = v->particles_in_span().front()->id();}
+                else {if ( v->particles_in_span().empty() ) {HEPMC3_DEBUG(30, "WriterAscii::write_event - found a vertex without incoming particles: " << v->id());}}
             }
             // Usage of map instead of simple counter helps to deal with events with random ids of vertices.
             if (alreadywritten.count(v->id()) == 0 && parent_object < 0)
@@ -257,20 +246,32 @@ std::string WriterAscii::escape(const std::string& s) const {
 
 void WriterAscii::write_vertex(const ConstGenVertexPtr& v) {
     flush();
-    std::string vlist;
     std::vector<int> pids;
-    pids.reserve(v->particles_in().size());
-    for (const ConstGenParticlePtr& p: v->particles_in()) pids.emplace_back(p->id());
+    pids.reserve(v->particles_in_span().size());
+    for (const ConstGenParticlePtr& p: v->particles_in_span()) pids.emplace_back(p->id());
     //We order pids to be able to compare ascii files
     std::sort(pids.begin(), pids.end());
-    for (const auto& p: pids) vlist.append( std::to_string(p).append(",") );
-    if ( !pids.empty() ) vlist.pop_back();
+    *m_cursor++ = 'V';
+    write_int(v->id());
+    write_int(v->status());
+    *m_cursor++ = ' ';
+    *m_cursor++ = '[';
+    for (size_t i = 0; i < pids.size(); ++i) {
+        if ( i > 0 ) *m_cursor++ = ',';
+        m_cursor = format_int(m_cursor, pids[i]);
+        flush();
+    }
+    *m_cursor++ = ']';
     const FourVector &pos = v->position();
     if ( !pos.is_zero() ) {
-        m_cursor += sprintf(m_cursor, m_vertex_long_printf_specifier.c_str(),  v->id(), v->status(), vlist.c_str(), pos.x(), pos.y(), pos.z(), pos.t() );
-    } else {
-        m_cursor += sprintf(m_cursor, m_vertex_short_printf_specifier.c_str(), v->id(), v->status(), vlist.c_str());
+        *m_cursor++ = ' ';
+        *m_cursor++ = '@';
+        write_float(pos.x(), m_float_format, m_precision);
+        write_float(pos.y(), m_float_format, m_precision);
+        write_float(pos.z(), m_float_format, m_precision);
+        write_float(pos.t(), m_float_format, m_precision);
     }
+    *m_cursor++ = '\n';
     flush();
 }
 
@@ -281,7 +282,7 @@ inline void WriterAscii::flush() {
     // we will not allow precision larger than 24 anyway
     if ( m_buffer + m_buffer_size < m_cursor + 512 ) {
         std::ptrdiff_t length = m_cursor - m_buffer;
-        m_stream->write(m_buffer, length);
+        write_bytes(m_buffer, length);
         m_cursor = m_buffer;
     }
 }
@@ -289,17 +290,28 @@ inline void WriterAscii::flush() {
 
 inline void WriterAscii::forced_flush() {
     std::ptrdiff_t length = m_cursor - m_buffer;
-    m_stream->write(m_buffer, length);
+    write_bytes(m_buffer, length);
     m_cursor = m_buffer;
 }
 
 
+inline void WriterAscii::write_bytes(const char* data, const std::ptrdiff_t& length) {
+    m_stream->write(data, length);
+    m_written += length;
+}
+
+
 void WriterAscii::write_run_info() {
     allocate_buffer();
 
     // If no run info object set, create a dummy one.
     if ( !run_info() ) set_run_info(std::make_shared<GenRunInfo>());
 
+    if ( !run_info()->weight_names().empty() || !run_info()->tools().empty() || !run_info()->attributes().empty() ) {
+        // Recorded in any case, the constructors write the run info before an index file can be set
+        m_index.add_run_info(offset());
+    }
+
     const std::vector<std::string> names = run_info()->weight_names();
 
     if ( !names.empty() ) {
@@ -339,11 +351,82 @@ void WriterAscii::write_run_info() {
 
 void WriterAscii::write_particle(const ConstGenParticlePtr& p, int second_field) {
     flush();
-    m_cursor += sprintf(m_cursor, m_particle_printf_specifier.c_str(), p->id(), second_field, p->pid(), p->momentum().px(), p->momentum().py(), p->momentum().pz(), p->momentum().e(), p->generated_mass(), p->status());
+    const FourVector& momentum = p->momentum();
+    *m_cursor++ = 'P';
+    write_int(p->id());
+    write_int(second_field);
+    write_int(p->pid());
+    write_float(momentum.px(), m_float_format, m_precision);
+    write_float(momentum.py(), m_float_format, m_precision);
+    write_float(momentum.pz(), m_float_format, m_precision);
+    write_float(momentum.e(), m_float_format, m_precision);
+    write_float(p->generated_mass(), m_float_format, m_precision);
+    write_int(p->status());
+    *m_cursor++ = '\n';
     flush();
 }
 
 
+inline void WriterAscii::write_int(const long long& value) {
+    *m_cursor++ = ' ';
+    m_cursor = format_int(m_cursor, value);
+}
+
+
+inline void WriterAscii::write_float(const double& value, const char& format, const int& precision) {
+    *m_cursor++ = ' ';
+#ifdef __cpp_lib_to_chars
+    // Same output as printf, see below
+    char* const end = m_buffer + m_buffer_size;
+    std::to_chars_result result{nullptr, std::errc::not_supported};
+    switch ( format ) {
+    case 'e':
+        result = std::to_chars(m_cursor, end, value, std::chars_format::scientific, precision);
+        break;
+    case 'f':
+        result = std::to_chars(m_cursor, end, value, std::chars_format::fixed, precision);
+        break;
+    case 'g':
+        result = std::to_chars(m_cursor, end, value, std::chars_format::general, precision);
+        break;
+    case 's':
+        result = std::to_chars(m_cursor, end, value);
+        break;
+    default:
+        break;
+    }
+    if ( result.ec == std::errc() ) {
+        m_cursor = result.ptr;
+        return;
+    }
+#endif
+    switch ( format ) {
+    case 'E':
+        m_cursor += sprintf(m_cursor, "%.*E", precision, value);
+        break;
+    case 'f':
+        m_cursor += sprintf(m_cursor, "%.*f", precision, value);
+        break;
+    case 'F':
+        m_cursor += sprintf(m_cursor, "%.*F", precision, value);
+        break;
+    case 'g':
+        m_cursor += sprintf(m_cursor, "%.*g", precision, value);
+        break;
+    case 'G':
+        m_cursor += sprintf(m_cursor, "%.*G", precision, value);
+        break;
+    case 's':
+        // 17 significant digits are enough to read back the same double
+        m_cursor += sprintf(m_cursor, "%.17g", value);
+        break;
+    default:
+        m_cursor += sprintf(m_cursor, "%.*e", precision, value);
+        break;
+    }
+}
+
+
 inline void WriterAscii::write_string(const std::string &str) {
     // First let's check if string will fit into the buffer
     if ( m_buffer + m_buffer_size > m_cursor + str.length() ) {
@@ -354,7 +437,7 @@ inline void WriterAscii::write_string(const std::string &str) {
     // If not, flush the buffer and write the string directly
     else {
         forced_flush();
-        m_stream->write(str.data(), str.length());
+        write_bytes(str.data(), str.length());
     }
 }
 
@@ -364,11 +447,25 @@ void WriterAscii::close() {
     if (ofs && !ofs->is_open()) return;
     forced_flush();
     const std::string footer("HepMC::Asciiv3-END_EVENT_LISTING\n\n");
-    if (m_stream) m_stream->write(footer.data(),footer.length());
+    if (m_stream) write_bytes(footer.data(),footer.length());
     if (ofs) ofs->close();
+    if ( !m_index_file.empty() ) {
+        m_index.set_file_size(m_written);
+        m_index.write(m_index_file);
+        m_index_file.clear();
+    }
 }
 bool WriterAscii::failed() { return (bool)m_file.rdstate(); }
 
+void WriterAscii::set_options(const std::map<std::string, std::string>& options) {
+    Writer::set_options(options);
+    m_float_format = 'e';
+    auto option = m_options.find("float_printf_specifier");
+    if ( option == m_options.end() ) return;
+    if ( option->second == "shortest" ) m_float_format = 's';
+    else if ( option->second.length() == 1 && strchr("eEfFgG", option->second[0]) ) m_float_format = option->second[0];
+}
+
 void WriterAscii::set_precision(const int& prec ) {
     if (prec < 2 || prec > 24) return;
     m_precision = prec;
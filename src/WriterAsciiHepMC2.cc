@@ -135,12 +135,12 @@ void WriterAsciiHepMC2::write_event(const GenEvent &evt)
     int idbeam = 0;
     for (const ConstGenVertexPtr& v: evt.vertices())
     {
-        for (const ConstGenParticlePtr& p: v->particles_in())
+        for (const ConstGenParticlePtr& p: v->particles_in_span())
         {
             if (!p->production_vertex())                { if (p->status() == 4) beams.emplace_back(idbeam); idbeam++; }
             else {if (p->production_vertex()->id() == 0) { if (p->status() == 4) beams.emplace_back(idbeam); idbeam++; }}
         }
-        for (const ConstGenParticlePtr& p: v->particles_out()) { if (p->status() == 4) beams.push_back(idbeam); idbeam++; }
+        for (const ConstGenParticlePtr& p: v->particles_out_span()) { if (p->status() == 4) beams.push_back(idbeam); idbeam++; }
     }
     //
     int idbeam1 = 10000;
@@ -242,7 +242,7 @@ void WriterAsciiHepMC2::write_event(const GenEvent &evt)
         int production_vertex = 0;
         production_vertex = v->id();
         write_vertex(v);
-        for (const ConstGenParticlePtr& p: v->particles_in())
+        for (const ConstGenParticlePtr& p: v->particles_in_span())
         {
             if (!p->production_vertex()) { write_particle( p, production_vertex ); }
             else
@@ -250,7 +250,7 @@ void WriterAsciiHepMC2::write_event(const GenEvent &evt)
                 if (p->production_vertex()->id() == 0) write_particle( p, production_vertex );
             }
         }
-        for (const ConstGenParticlePtr& p: v->particles_out()) {
+        for (const ConstGenParticlePtr& p: v->particles_out_span()) {
             write_particle(p, production_vertex);
         }
     }
@@ -322,7 +322,7 @@ void WriterAsciiHepMC2::write_vertex(const ConstGenVertexPtr& v)
     flush();
     m_cursor += sprintf(m_cursor, "V %i %i", v->id(), v->status());
     int orph = 0;
-    for (const ConstGenParticlePtr& p: v->particles_in())
+    for (const ConstGenParticlePtr& p: v->particles_in_span())
     {
         if (!p->production_vertex()) { orph++;}
         else
@@ -342,7 +342,7 @@ void WriterAsciiHepMC2::write_vertex(const ConstGenVertexPtr& v)
         m_cursor += sprintf(m_cursor, m_float_printf_specifier.c_str(), pos.z());
         m_cursor += sprintf(m_cursor, m_float_printf_specifier.c_str(), pos.t());
     }
-    m_cursor += sprintf(m_cursor, " %i %zu %zu", orph, v->particles_out().size(), weights.size());
+    m_cursor += sprintf(m_cursor, " %i %zu %zu", orph, v->particles_out_span().size(), weights.size());
     flush();
     for (size_t i = 0; i < weights.size(); i++) { m_cursor += sprintf(m_cursor, m_float_printf_specifier.c_str(), weights[i]); flush(); }
     m_cursor += sprintf(m_cursor, "\n");
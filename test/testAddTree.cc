@@ -0,0 +1,65 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#include <algorithm>
+#undef NDEBUG
+#include <cassert>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+using namespace HepMC3;
+static GenParticlePtr connect(const GenVertexPtr& from, const GenVertexPtr& to, std::vector<GenParticlePtr>& parts)
+{
+    GenParticlePtr p = std::make_shared<GenParticle>(FourVector(0.0, 0.0, 1.0, 1.0), 21, 2);
+    if (from) from->add_particle_out(p);
+    if (to) to->add_particle_in(p);
+    parts.push_back(p);
+    return p;
+}
+/* Every vertex comes after the production vertices of its incoming particles */
+static bool sorted(const GenEvent& evt)
+{
+    for (ConstGenVertexPtr v: evt.vertices()) {
+        for (ConstGenParticlePtr p: v->particles_in()) {
+            ConstGenVertexPtr pv = p->production_vertex();
+            if (pv && pv->id() != 0 && pv->id() <= v->id()) return false;
+        }
+    }
+    return true;
+}
+int main()
+{
+    /* Large shower given in reverse order, with merging branches */
+    std::vector<GenParticlePtr> parts;
+    std::vector<GenVertexPtr> vertices(20000);
+    for (GenVertexPtr& v: vertices) v = std::make_shared<GenVertex>();
+    connect(nullptr, vertices[0], parts);
+    for (size_t i = 1; i < vertices.size(); ++i) {
+        connect(vertices[(i - 1)/2], vertices[i], parts);
+        if (i % 7 == 0) connect(vertices[i/3], vertices[i], parts);
+    }
+    std::reverse(parts.begin(), parts.end());
+    GenEvent evt;
+    evt.add_tree(parts);
+    assert(evt.vertices().size() == vertices.size());
+    assert(evt.particles().size() == parts.size());
+    assert(sorted(evt));
+    /* Merging branches are not cycles */
+    assert(!evt.attribute<IntAttribute>("cycles"));
+
+    /* A closed loop is flagged */
+    std::vector<GenParticlePtr> loop;
+    GenVertexPtr a = std::make_shared<GenVertex>(), b = std::make_shared<GenVertex>(), c = std::make_shared<GenVertex>();
+    connect(nullptr, a, loop);
+    connect(a, b, loop);
+    connect(b, c, loop);
+    connect(c, b, loop);
+    connect(c, nullptr, loop);
+    GenEvent evt2;
+    evt2.add_tree(loop);
+    assert(evt2.vertices().size() == 3);
+    assert(evt2.attribute<IntAttribute>("cycles") && evt2.attribute<IntAttribute>("cycles")->value() == 1);
+    return 0;
+}
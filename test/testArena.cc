@@ -0,0 +1,76 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/EventArena.h"
+#include "HepMC3/ReaderAsciiHepMC2.h"
+#include "HepMC3/WriterAscii.h"
+#include "HepMC3TestUtils.h"
+using namespace HepMC3;
+int main()
+{
+    ReaderAsciiHepMC2 inputA("inputArena.hepmc");
+    if(inputA.failed()) return 1;
+    WriterAscii outputA("frominputArena_default.hepmc");
+    if(outputA.failed()) return 2;
+    GenEvent evtA(Units::GEV,Units::MM);
+    while( !inputA.failed() )
+    {
+        inputA.read_event(evtA);
+        if( inputA.failed() ) break;
+        outputA.write_event(evtA);
+        evtA.clear();
+    }
+    inputA.close();
+    outputA.close();
+
+    ReaderAsciiHepMC2 inputB("inputArena.hepmc");
+    if(inputB.failed()) return 3;
+    WriterAscii outputB("frominputArena_arena.hepmc");
+    if(outputB.failed()) return 4;
+    std::shared_ptr<EventArena> arena = std::make_shared<EventArena>();
+    GenEvent evtB(Units::GEV,Units::MM);
+    evtB.set_arena(arena);
+    size_t capacity = 0;
+    int nevents = 0;
+    while( !inputB.failed() )
+    {
+        inputB.read_event(evtB);
+        if( inputB.failed() ) break;
+        outputB.write_event(evtB);
+        assert(evtB.arena() == arena);
+        assert(arena->used() > 0);
+        /* After the first events the blocks should be reused. */
+        if (nevents > 2) assert(arena->capacity() <= capacity);
+        capacity = std::max(capacity, arena->capacity());
+        evtB.clear();
+        nevents++;
+    }
+    inputB.close();
+    outputB.close();
+    assert(nevents > 0);
+
+    /* A particle kept after clear() stays valid, the event switches to a new arena. */
+    GenEvent evtC(Units::GEV,Units::MM);
+    evtC.set_arena(std::make_shared<EventArena>(4096));
+    GenVertexPtr v = evtC.make_vertex(FourVector(1.0, 2.0, 3.0, 4.0));
+    GenParticlePtr p = evtC.make_particle(FourVector(0.0, 0.0, 10.0, 10.0), 11, 1);
+    v->add_particle_out(p);
+    evtC.add_vertex(v);
+    std::shared_ptr<EventArena> old_arena = evtC.arena();
+    evtC.clear();
+    assert(evtC.arena() != old_arena);
+    assert(p->pid() == 11);
+    assert(p->momentum().e() == 10.0);
+    for (int i = 0; i < 1000; ++i) evtC.add_particle(evtC.make_particle(FourVector(0.0, 0.0, i, i), 22, 1));
+    assert(evtC.particles().size() == 1000);
+    assert(p->pid() == 11);
+
+    return COMPARE_ASCII_FILES("frominputArena_default.hepmc","frominputArena_arena.hepmc");
+}
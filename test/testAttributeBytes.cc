@@ -0,0 +1,136 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <cmath>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenCrossSection.h"
+#include "HepMC3/GenHeavyIon.h"
+#include "HepMC3/GenPdfInfo.h"
+#include "HepMC3/Data/GenEventData.h"
+using namespace HepMC3;
+/* Binary round trip of a single attribute */
+template <class T>
+static std::shared_ptr<T> round_trip(const T& a)
+{
+    std::string bytes;
+    assert(a.to_bytes(bytes));
+    std::shared_ptr<Attribute> b = BinaryAttribute::make(a.type_tag());
+    assert(b && typeid(*b) == typeid(T));
+    assert(b->from_bytes(bytes));
+    /* Truncated content is rejected */
+    if (!bytes.empty() && a.type_tag() != "StringAttribute") assert(!b->from_bytes(bytes.substr(0, bytes.size() - 1)));
+    b->from_bytes(bytes);
+    return std::static_pointer_cast<T>(b);
+}
+/* A derived attribute with its own text representation */
+class ScaledAttribute: public DoubleAttribute {
+public:
+    ScaledAttribute(): DoubleAttribute() {}
+    explicit ScaledAttribute(double val): DoubleAttribute(val) {}
+    bool from_string(const std::string &att) override { DoubleAttribute::from_string(att); set_value(value()/2); return true; }
+    bool to_string(std::string &att) const override { return DoubleAttribute(2*value()).to_string(att); }
+};
+int main()
+{
+    const double third = 1.0/3.0;
+    const long double lthird = 1.0L/3.0L;
+    assert(round_trip(IntAttribute(-123456789))->value() == -123456789);
+    assert(round_trip(LongAttribute(-1234567890123L))->value() == -1234567890123L);
+    assert(round_trip(LongLongAttribute(-1234567890123LL))->value() == -1234567890123LL);
+    assert(round_trip(UIntAttribute(4000000000U))->value() == 4000000000U);
+    assert(round_trip(ULongAttribute(18000000000000000000UL))->value() == 18000000000000000000UL);
+    assert(round_trip(ULongLongAttribute(18000000000000000000ULL))->value() == 18000000000000000000ULL);
+    assert(round_trip(DoubleAttribute(third))->value() == third);
+    assert(round_trip(FloatAttribute(float(third)))->value() == float(third));
+    assert(round_trip(LongDoubleAttribute(lthird))->value() == lthird);
+    assert(round_trip(CharAttribute('x'))->value() == 'x');
+    assert(round_trip(BoolAttribute(true))->value());
+    assert(round_trip(StringAttribute("two words"))->value() == "two words");
+    assert(round_trip(VectorDoubleAttribute({third, -third, 1e300}))->value() == std::vector<double>({third, -third, 1e300}));
+    assert(round_trip(VectorFloatAttribute({1.5f, float(third)}))->value() == std::vector<float>({1.5f, float(third)}));
+    assert(round_trip(VectorLongDoubleAttribute({lthird}))->value() == std::vector<long double>({lthird}));
+    assert(round_trip(VectorIntAttribute({1, -2, 3}))->value() == std::vector<int>({1, -2, 3}));
+    assert(round_trip(VectorLongIntAttribute({-5L}))->value() == std::vector<long>({-5L}));
+    assert(round_trip(VectorLongLongAttribute({-5LL, 6LL}))->value() == std::vector<long long>({-5LL, 6LL}));
+    assert(round_trip(VectorUIntAttribute({7U}))->value() == std::vector<unsigned int>({7U}));
+    assert(round_trip(VectorULongAttribute({8UL}))->value() == std::vector<unsigned long>({8UL}));
+    assert(round_trip(VectorULongLongAttribute({9ULL}))->value() == std::vector<unsigned long long>({9ULL}));
+    assert(round_trip(VectorCharAttribute({'a', 'b'}))->value() == std::vector<char>({'a', 'b'}));
+    /* Strings with spaces survive, unlike in the text representation */
+    assert(round_trip(VectorStringAttribute({"a b", "", "c"}))->value() == std::vector<std::string>({"a b", "", "c"}));
+    assert(!BinaryAttribute::make("NoSuchAttribute"));
+
+    GenEvent evt(Units::GEV, Units::MM);
+    evt.weights() = std::vector<double>(3, 1.0);
+    GenVertexPtr v = std::make_shared<GenVertex>();
+    evt.add_vertex(v);
+    for (int i = 0; i < 10; ++i) {
+        v->add_particle_out(std::make_shared<GenParticle>(FourVector(0.0, 0.0, i, i), 22, 1));
+        evt.particles().back()->add_attribute("theta", std::make_shared<DoubleAttribute>(third*i));
+    }
+    std::shared_ptr<GenCrossSection> xs = std::make_shared<GenCrossSection>();
+    evt.set_cross_section(xs);
+    xs->set_cross_section(std::vector<double>({third, 2*third, 3*third}), std::vector<double>({0.1, 0.2, 0.3}), 100, 200);
+    std::shared_ptr<GenHeavyIon> hi = std::make_shared<GenHeavyIon>();
+    hi->impact_parameter = third;
+    hi->participant_plane_angles[2] = third;
+    hi->eccentricities[3] = -third;
+    evt.set_heavy_ion(hi);
+    std::shared_ptr<GenPdfInfo> pdf = std::make_shared<GenPdfInfo>();
+    pdf->set(1, 2, third, 0.5, 91.1876, 0.1, 0.2, 10800, 10800);
+    evt.set_pdf_info(pdf);
+    evt.add_attribute("text", std::make_shared<StringAttribute>("text"));
+
+    /* Text and binary sections */
+    GenEventData text, binary;
+    evt.write_data(text);
+    evt.write_data(binary, true);
+    assert(binary.attribute_id.empty());
+    assert(binary.attribute_binary_id.size() == text.attribute_id.size());
+    assert(binary.attribute_binary_type.size() == binary.attribute_binary_bytes.size());
+
+    GenEvent evt2;
+    evt2.read_data(binary);
+    for (int i = 0; i < 10; ++i) {
+        assert(!evt2.particles()[i]->attribute_as_string("theta").empty());
+        assert(evt2.particles()[i]->attribute<DoubleAttribute>("theta")->value() == third*i);
+    }
+    assert(evt2.cross_section()->xsec(1) == 2*third);
+    assert(evt2.cross_section()->get_accepted_events() == 100);
+    assert(evt2.heavy_ion()->impact_parameter == third);
+    assert(evt2.heavy_ion()->eccentricities[3] == -third);
+    assert(evt2.pdf_info()->x[0] == third);
+    assert(evt2.pdf_info()->pdf_id[1] == 10800);
+    assert(evt2.attribute<StringAttribute>("text")->value() == "text");
+
+    /* Other types are converted through the string representation */
+    GenEvent evt3;
+    evt3.read_data(binary);
+    assert(evt3.particles()[3]->attribute<StringAttribute>("theta")->value() == evt.particles()[3]->attribute_as_string("theta"));
+    /* As for text attributes, the text of GenPdfInfo starts with the integer parton_id[0] */
+    assert(evt3.attribute<IntAttribute>("GenPdfInfo")->value() == 1);
+
+    /* Derived classes are stored as strings, not with the tag of their base */
+    assert(ScaledAttribute(third).type_tag().empty() && DoubleAttribute(third).type_tag() == "DoubleAttribute");
+    GenEvent evt4;
+    evt4.add_attribute("scaled", std::make_shared<ScaledAttribute>(0.25));
+    GenEventData binary4;
+    evt4.write_data(binary4, true);
+    assert(binary4.attribute_binary_id.empty() && binary4.attribute_string.size() == 1 && std::stod(binary4.attribute_string[0]) == 0.5);
+    evt4.read_data(binary4);
+    assert(evt4.attribute<ScaledAttribute>("scaled")->value() == 0.25);
+
+    /* Unparsed binary attributes are written back unchanged */
+    GenEventData binary2;
+    evt2.read_data(binary);
+    evt2.write_data(binary2, true);
+    assert(binary2.attribute_binary_bytes == binary.attribute_binary_bytes);
+    assert(binary2.attribute_binary_type == binary.attribute_binary_type);
+    return 0;
+}
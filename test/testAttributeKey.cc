@@ -0,0 +1,82 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/AttributeKey.h"
+#include "HepMC3/Data/GenEventData.h"
+using namespace HepMC3;
+int main()
+{
+    static const AttributeKey<DoubleAttribute> theta("theta");
+    static const AttributeKey<IntAttribute> barcode("barcode");
+    assert(AttributeKey<DoubleAttribute>("theta").key() == theta.key());
+    assert(theta.key() != barcode.key());
+    assert(theta.name() == "theta");
+    assert(AttributeRegistry::name(barcode.key()) == "barcode");
+
+    GenEvent evt;
+    GenVertexPtr v = std::make_shared<GenVertex>();
+    evt.add_vertex(v);
+    for (int i = 0; i < 100; ++i) {
+        GenParticlePtr p = std::make_shared<GenParticle>(FourVector(0.0, 0.0, i, i), 22, 1);
+        v->add_particle_out(p);
+    }
+    /* Attributes added out of id order */
+    for (int i = 99; i >= 0; i -= 2) evt.particles()[i]->add_attribute("theta", std::make_shared<DoubleAttribute>(0.01*i));
+    for (int i = 0; i < 100; i += 3) evt.particles()[i]->add_attribute("barcode", std::make_shared<IntAttribute>(10000 + i));
+    v->add_attribute("barcode", std::make_shared<IntAttribute>(-1));
+
+    for (int i = 0; i < 100; ++i) {
+        ConstGenParticlePtr p = evt.particles()[i];
+        std::shared_ptr<DoubleAttribute> a = p->attribute(theta);
+        assert(a == p->attribute<DoubleAttribute>("theta"));
+        assert(bool(a) == (i%2 == 1));
+        if (a) assert(a->value() == 0.01*i);
+        std::shared_ptr<IntAttribute> b = p->attribute(barcode);
+        assert(bool(b) == (i%3 == 0));
+        if (b) assert(b->value() == 10000 + i);
+    }
+    assert(v->attribute(barcode)->value() == -1);
+    /* Wrong type gives an empty pointer */
+    assert(!evt.attribute<DoubleAttribute>("barcode", -1));
+
+    /* Map view is sorted by name and id */
+    std::map< std::string, std::map<int, std::shared_ptr<Attribute> > > atts = evt.attributes();
+    assert(atts.size() == 2);
+    assert(atts.begin()->first == "barcode");
+    assert(atts["theta"].size() == 50);
+    assert(atts["theta"].begin()->first == 2);
+
+    /* Lazy parsing through the key */
+    GenEventData data;
+    evt.write_data(data);
+    GenEvent evt2;
+    evt2.read_data(data);
+    assert(!evt2.attribute<StringAttribute>("theta", 2)->value().empty());
+    GenEvent evt3;
+    evt3.read_data(data);
+    assert(evt3.particles()[1]->attribute(theta)->value() == 0.01);
+    assert(evt3.particles()[1]->attribute(theta)->is_parsed());
+
+    /* Removal and renumbering */
+    evt3.remove_particle(evt3.particles()[0]);
+    assert(evt3.particles()[0]->attribute(theta)->value() == 0.01);
+    assert(evt3.particles()[2]->attribute(barcode)->value() == 10003);
+    evt3.particles()[0]->remove_attribute("theta");
+    assert(!evt3.particles()[0]->attribute(theta));
+    assert(evt3.attribute_names(1).empty());
+    assert(evt3.attribute_names(3).size() == 2);
+
+    /* Event attributes fall back to the run info */
+    std::shared_ptr<GenRunInfo> run = std::make_shared<GenRunInfo>();
+    run->add_attribute("barcode", std::make_shared<IntAttribute>(7));
+    GenEvent evt4(run);
+    assert(evt4.attribute(barcode)->value() == 7);
+    return 0;
+}
@@ -0,0 +1,63 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+using namespace HepMC3;
+static std::vector<GenParticlePtr> make_particles(const size_t n)
+{
+    std::vector<GenParticlePtr> result;
+    for (size_t i = 0; i < n; ++i) result.push_back(std::make_shared<GenParticle>(FourVector(0.0, 0.0, i, i), 211, 1));
+    return result;
+}
+int main()
+{
+    GenEvent evt(Units::GEV, Units::MM);
+    /* Many beam remnants without production vertex */
+    std::vector<GenParticlePtr> remnants = make_particles(20000);
+    GenVertexPtr hadronization = evt.add_vertex(remnants, make_particles(30000), FourVector(0.0, 0.0, 0.0, 1.0));
+    assert(evt.vertices().size() == 1 && evt.particles().size() == 50000);
+    assert(evt.beams().size() == remnants.size());
+    assert(hadronization->particles_in().size() == 20000 && hadronization->particles_out().size() == 30000);
+    for (size_t i = 0; i < remnants.size(); ++i) {
+        assert(remnants[i]->end_vertex() == hadronization);
+        assert(remnants[i]->production_vertex() == evt.beams()[i]->production_vertex());
+    }
+
+    /* Particles already attached are skipped, others are moved */
+    std::vector<GenParticlePtr> outgoing = hadronization->particles_out();
+    GenVertexPtr decay = std::make_shared<GenVertex>();
+    decay->add_particle_in(outgoing[0]);
+    evt.add_vertex(decay);
+    std::vector<GenParticlePtr> products(outgoing.begin(), outgoing.begin() + 100);
+    products.push_back(products.back());
+    decay->add_particles_out(products);
+    assert(decay->particles_out().size() == 100);
+    assert(hadronization->particles_out().size() == 29900);
+    assert(outgoing[0]->production_vertex() == decay && outgoing[0]->end_vertex() == decay);
+    decay->add_particles_out(products);
+    assert(decay->particles_out().size() == 100);
+
+    /* Same result as adding the particles one by one */
+    GenVertexPtr single = std::make_shared<GenVertex>(), bulk = std::make_shared<GenVertex>();
+    std::vector<GenParticlePtr> a = make_particles(50), b = make_particles(50);
+    for (const GenParticlePtr& p: a) single->add_particle_out(p);
+    bulk->add_particles_out(b);
+    GenEvent e1, e2;
+    e1.add_vertex(single);
+    e2.add_vertex(bulk);
+    assert(e1.particles().size() == e2.particles().size());
+    for (size_t i = 0; i < a.size(); ++i) assert(a[i]->id() == b[i]->id());
+
+    /* The full check finds particles of removed vertices, whose links are reset */
+    e2.remove_vertex(bulk);
+    assert(!b[0]->production_vertex());
+    bulk->add_particles_out(std::vector<GenParticlePtr>(1, b[0]), true);
+    assert(bulk->particles_out().size() == 50);
+    return 0;
+}
@@ -0,0 +1,100 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <utility>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/GenCrossSection.h"
+#include "HepMC3/Setup.h"
+#include "HepMC3/ReaderAsciiHepMC2.h"
+#include "HepMC3/WriterAscii.h"
+#include "HepMC3TestUtils.h"
+using namespace HepMC3;
+int main()
+{
+    ReaderAsciiHepMC2 inputA("inputClone.hepmc");
+    if(inputA.failed()) return 1;
+    WriterAscii outputA("frominputClone_original.hepmc");
+    if(outputA.failed()) return 2;
+    WriterAscii outputB("frominputClone_clone.hepmc");
+    if(outputB.failed()) return 3;
+    std::vector<GenEvent> moved;
+    while( !inputA.failed() )
+    {
+        GenEvent evt(Units::GEV,Units::MM);
+        inputA.read_event(evt);
+        if( inputA.failed() )  {
+            printf("End of file reached. Exit.\n");
+            break;
+        }
+        evt.add_attribute("unparsed", std::make_shared<StringAttribute>("1 2 3"), 1);
+        evt.add_attribute("index", std::make_shared<IntAttribute>(42), -1);
+        outputA.write_event(evt);
+
+        GenEvent copy = evt.clone();
+        assert(copy.particles().size() == evt.particles().size());
+        assert(copy.vertices().size() == evt.vertices().size());
+        assert(copy.particles()[0] != evt.particles()[0]);
+        assert(copy.particles()[0]->parent_event() == &copy);
+        /* Typed attributes are copied, not shared */
+        assert(copy.cross_section() != evt.cross_section());
+        assert(copy.cross_section()->xsec() == evt.cross_section()->xsec());
+        assert(copy.cross_section()->event() == &copy);
+        assert(copy.attribute<IntAttribute>("index", -1)->vertex() == copy.vertices()[0]);
+        /* Unparsed attributes stay unparsed */
+        assert(!copy.attributes()["unparsed"][1]->is_parsed());
+
+        /* Changes in the copy do not affect the original */
+        const int pid = evt.particles()[0]->pid();
+        copy.particles()[0]->set_pid(pid + 1);
+        assert(evt.particles()[0]->pid() == pid);
+        copy.particles()[0]->set_pid(pid);
+
+        /* Move construction re-points the back-pointers */
+        GenEvent target(std::move(copy));
+        assert(copy.particles().empty());
+        assert(copy.vertices().empty());
+        /* The moved-from event is still usable */
+        assert(copy.beams().empty() && copy.event_pos().is_zero());
+        for (ConstGenParticlePtr p: target.particles()) assert(p->parent_event() == &target);
+        for (ConstGenVertexPtr v: target.vertices()) assert(v->parent_event() == &target);
+        assert(target.cross_section()->event() == &target);
+
+        /* Move assignment releases the old content */
+        GenEvent assigned(Units::MEV,Units::CM);
+        assigned.add_particle(std::make_shared<GenParticle>());
+        ConstGenParticlePtr old = assigned.particles()[0];
+        assigned = std::move(target);
+        assert(old->parent_event() == nullptr);
+        assert(assigned.momentum_unit() == Units::GEV);
+        for (ConstGenParticlePtr p: assigned.particles()) assert(p->parent_event() == &assigned);
+
+        /* The frozen state moves with the content, a frozen target is not assigned to */
+        assigned.freeze();
+        GenEvent frozen(std::move(assigned));
+        assert(frozen.is_frozen() && !assigned.is_frozen());
+        Setup::set_print_errors(false);
+        frozen = std::move(copy);
+        Setup::set_print_errors(true);
+        assert(frozen.is_frozen() && frozen.particles().size() == evt.particles().size());
+        frozen.thaw();
+        GenEvent reused(std::move(assigned));
+        reused.add_particle(std::make_shared<GenParticle>());
+        assert(reused.beams().size() == 1 && reused.particles()[0]->production_vertex());
+
+        moved.push_back(std::move(frozen));
+    }
+    inputA.close();
+    for (const GenEvent& evt: moved) {
+        for (ConstGenParticlePtr p: evt.particles()) assert(p->parent_event() == &evt);
+        outputB.write_event(evt);
+    }
+    outputA.close();
+    outputB.close();
+    return COMPARE_ASCII_FILES("frominputClone_original.hepmc","frominputClone_clone.hepmc");
+}
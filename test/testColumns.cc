@@ -0,0 +1,71 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/GenEventColumns.h"
+#include "HepMC3/Data/GenEventData.h"
+using namespace HepMC3;
+int main()
+{
+    GenEvent evt(Units::GEV,Units::MM);
+    GenParticlePtr b1 = std::make_shared<GenParticle>(FourVector(0.0, 0.0, 7000.0, 7000.0), 2212, 4);
+    GenParticlePtr b2 = std::make_shared<GenParticle>(FourVector(0.0, 0.0, -7000.0, 7000.0), 2212, 4);
+    GenVertexPtr v1 = std::make_shared<GenVertex>();
+    v1->add_particle_in(b1);
+    v1->add_particle_in(b2);
+    evt.add_vertex(v1);
+    GenVertexPtr v2 = std::make_shared<GenVertex>(FourVector(0.1, 0.2, 0.3, 0.4));
+    for (int i = 0; i < 10; ++i) {
+        GenParticlePtr p = std::make_shared<GenParticle>(FourVector(i, -i, 2*i, 10.0*(i + 1)), 211, 2);
+        if (i%3 == 0) p->set_generated_mass(0.13957);
+        v1->add_particle_out(p);
+        if (i%2 == 0) v2->add_particle_in(p);
+    }
+    evt.add_vertex(v2);
+    v2->add_particle_out(std::make_shared<GenParticle>(FourVector(1.0, 1.0, 1.0, 5.0), 22, 1));
+
+    GenEventColumns fromevent(evt);
+    GenEventData data;
+    evt.write_data(data);
+    GenEventColumns fromdata(data);
+
+    assert(fromevent.size() == evt.particles().size());
+    assert(fromdata.size() == evt.particles().size());
+    for (size_t i = 0; i < evt.particles().size(); ++i) {
+        ConstGenParticlePtr p = evt.particles()[i];
+        assert(fromevent.pid[i] == p->pid());
+        assert(fromevent.status[i] == p->status());
+        assert(fromevent.px[i] == p->momentum().px());
+        assert(fromevent.py[i] == p->momentum().py());
+        assert(fromevent.pz[i] == p->momentum().pz());
+        assert(fromevent.e[i] == p->momentum().e());
+        assert(fromevent.mass[i] == p->generated_mass());
+        int prod = fromevent.production_vertex_index[i];
+        int end = fromevent.end_vertex_index[i];
+        if (prod >= 0) assert(evt.vertices()[prod] == p->production_vertex());
+        else assert(!p->production_vertex() || p->production_vertex()->id() == 0);
+        if (end >= 0) assert(evt.vertices()[end] == p->end_vertex());
+        else assert(!p->end_vertex());
+
+        assert(fromdata.pid[i] == fromevent.pid[i]);
+        assert(fromdata.status[i] == fromevent.status[i]);
+        assert(fromdata.px[i] == fromevent.px[i]);
+        assert(fromdata.py[i] == fromevent.py[i]);
+        assert(fromdata.pz[i] == fromevent.pz[i]);
+        assert(fromdata.e[i] == fromevent.e[i]);
+        assert(fromdata.mass[i] == fromevent.mass[i]);
+        assert(fromdata.production_vertex_index[i] == fromevent.production_vertex_index[i]);
+        assert(fromdata.end_vertex_index[i] == fromevent.end_vertex_index[i]);
+    }
+
+    evt.clear();
+    fromevent.fill(evt);
+    assert(fromevent.empty());
+    return 0;
+}
@@ -0,0 +1,90 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <algorithm>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/Data/CompactEventData.h"
+#include "HepMC3/Data/GenEventData.h"
+using namespace HepMC3;
+int main()
+{
+    GenEvent evt(Units::GEV, Units::CM);
+    evt.set_event_number(12);
+    std::vector<GenParticlePtr> beams, out;
+    beams.push_back(evt.make_particle(FourVector(0.0, 0.0, 6500.0, 6500.0), 2212, 4));
+    beams.push_back(evt.make_particle(FourVector(0.0, 0.0, -6500.0, 6500.0), 2212, 4));
+    for (int i = 0; i < 20; ++i) out.push_back(evt.make_particle(FourVector(0.3*i, -0.1*i, 1.0/(i + 1), 2.0 + i), 211, 1));
+    out[3]->set_generated_mass(0.13957);
+    evt.add_vertex(beams, out, FourVector(0.0, 0.0, 0.01, 0.0));
+    for (int i = 0; i < 20; i += 4) {
+        std::vector<GenParticlePtr> daughters;
+        daughters.push_back(evt.make_particle(FourVector(0.1, 0.0, 0.0, 0.1), 22, 1));
+        daughters.push_back(evt.make_particle(FourVector(-0.1, 0.0, 0.0, 0.1), 22, 1));
+        evt.add_vertex(std::vector<GenParticlePtr>(1, out[i]), daughters, FourVector(0.001*i, 0.0, 0.0, 0.0));
+    }
+    evt.shift_position_by(FourVector(0.0, 0.0, 1.5, 0.0));
+    evt.weights() = std::vector<double>({1.0, 0.123456789012345});
+    evt.add_attribute("tag", std::make_shared<IntAttribute>(3), out[5]->id());
+
+    assert(sizeof(CompactParticleData) < sizeof(GenParticleData) && sizeof(CompactVertexData) < sizeof(GenVertexData));
+    CompactEventData data;
+    evt.write_data(data);
+    assert(data.particles.size() == evt.particles().size() && data.vertices.size() == evt.vertices().size());
+    assert(data.particles[3].production_vertex == 0 && data.particles[2].end_vertex == 1);
+    assert(data.particles[5].is_mass_set() && !data.particles[6].is_mass_set());
+
+    GenEvent back;
+    back.read_data(data);
+    assert(back.event_number() == 12 && back.length_unit() == Units::CM);
+    assert(back.weights() == evt.weights());
+    assert(back.particles()[5]->generated_mass() == float(0.13957));
+    assert(!back.particles()[6]->is_generated_mass_set());
+    assert(back.attribute<IntAttribute>("tag", 8)->value() == 3);
+    assert(back.beams().size() == 2);
+    /* The particle lists of the vertices are allocated with their final size, short lists not at all */
+    GenEventData full;
+    evt.write_data(full);
+    GenEvent copy, compact;
+    copy.read_data(full);
+    compact.read_data(data);
+    for (const GenEvent* e: {&compact, &copy}) {
+        size_t links = e->beams().size() > 4 ? e->beams().size() : 0;
+        for (ConstGenVertexPtr v: e->vertices()) {
+            if (v->particles_in_span().size() > 2) links += v->particles_in_span().size();
+            if (v->particles_out_span().size() > 4) links += v->particles_out_span().size();
+        }
+        assert(e->memory_usage().links == links*sizeof(GenParticlePtr));
+    }
+    /* Single precision */
+    assert(!equivalent(evt, back) && equivalent(evt, back, 1e-6, true));
+
+    /* Vertex ids set explicitly, as done by the readers */
+    for (size_t i = 0; i < evt.vertices().size(); ++i) evt.vertices()[i]->set_id(-100 - (int)i);
+    CompactEventData renumbered;
+    evt.write_data(renumbered);
+    for (size_t i = 0; i < data.particles.size(); ++i) {
+        assert(renumbered.particles[i].production_vertex == data.particles[i].production_vertex);
+        assert(renumbered.particles[i].end_vertex == data.particles[i].end_vertex);
+    }
+
+    /* Spans see the lists without copying them, the vectors are kept up to date */
+    GenEvent lists;
+    GenVertexPtr v = lists.add_vertex(std::vector<GenParticlePtr>(1, lists.make_particle(FourVector(), 23, 2)), std::vector<GenParticlePtr>());
+    const std::vector<GenParticlePtr>& list = v->particles_out();
+    for (int i = 0; i < 10; ++i) {
+        v->add_particle_out(lists.make_particle(FourVector(0.0, 0.0, i, i), 211, 1));
+        assert(list.size() == v->particles_out_span().size() && list.back() == v->particles_out_span().back());
+    }
+    v->remove_particle_out(list[3]);
+    assert(list.size() == 9 && std::equal(list.begin(), list.end(), v->particles_out_span().begin()));
+    ConstGenVertexPtr cv = v;
+    assert(cv->particles_in_span().size() == 1 && cv->particles_in_span().front()->pid() == 23);
+    assert(cv->particles_in().size() == 1 && cv->particles_in()[0] == cv->particles_in_span()[0]);
+    return 0;
+}
@@ -0,0 +1,90 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#include <algorithm>
+#undef NDEBUG
+#include <cassert>
+#include <set>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/GenEventGraph.h"
+#include "HepMC3/Data/GenEventData.h"
+using namespace HepMC3;
+/* Descendants found through the shared pointers */
+static void descendants(const ConstGenParticlePtr& p, std::set<int>& result)
+{
+    if (!p->end_vertex()) return;
+    for (ConstGenParticlePtr c: p->end_vertex()->particles_out()) if (result.insert(c->id() - 1).second) descendants(c, result);
+}
+static std::vector<int> sorted(const GenEventGraph::Range& r)
+{
+    std::vector<int> result(r.begin(), r.end());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+int main()
+{
+    GenEvent evt;
+    std::vector<GenParticlePtr> beams;
+    beams.push_back(std::make_shared<GenParticle>(FourVector(0.0, 0.0, 7000.0, 7000.0), 2212, 4));
+    beams.push_back(std::make_shared<GenParticle>(FourVector(0.0, 0.0, -7000.0, 7000.0), 2212, 4));
+    std::vector<GenParticlePtr> products;
+    for (int i = 0; i < 10; ++i) products.push_back(std::make_shared<GenParticle>(FourVector(0.0, 0.0, i, i + 1.0), 211, 2));
+    evt.add_vertex(beams, products);
+    /* Merging decay chains */
+    for (int i = 0; i < 10; i += 2) {
+        std::vector<GenParticlePtr> in, out;
+        in.reserve(2);
+        in.push_back(products[i]);
+        if (i > 0) in.push_back(products[i - 1]);
+        for (int j = 0; j < 3; ++j) out.push_back(std::make_shared<GenParticle>(FourVector(0.0, 0.0, j, j + 1.0), 22, 1));
+        evt.add_vertex(in, out);
+    }
+
+    GenEventGraph graph(evt);
+    GenEventData data;
+    evt.write_data(data);
+    GenEventGraph fromdata(data);
+    assert(graph.particles_size() == evt.particles().size() && graph.vertices_size() == evt.vertices().size());
+    assert(!graph.has_cycles());
+    for (size_t i = 0; i < evt.particles().size(); ++i) {
+        ConstGenParticlePtr p = evt.particles()[i];
+        std::vector<int> parents, children;
+        for (ConstGenParticlePtr q: p->parents()) parents.push_back(q->id() - 1);
+        for (ConstGenParticlePtr q: p->children()) children.push_back(q->id() - 1);
+        std::sort(parents.begin(), parents.end());
+        std::sort(children.begin(), children.end());
+        assert(sorted(graph.parents(i)) == parents);
+        assert(sorted(graph.children(i)) == children);
+        assert(sorted(fromdata.parents(i)) == parents);
+        assert(sorted(fromdata.children(i)) == children);
+        assert(graph.production_vertex(i) == fromdata.production_vertex(i));
+        assert(graph.end_vertex(i) == fromdata.end_vertex(i));
+
+        std::set<int> expected;
+        descendants(p, expected);
+        std::vector<int> found = graph.descendants(i);
+        assert(std::set<int>(found.begin(), found.end()) == expected && found.size() == expected.size());
+    }
+    assert(graph.production_vertex(0) == -1 && graph.parents(0).empty());
+    assert(graph.ancestors(evt.particles().size() - 1).size() == 4);
+
+    /* Vertex ids set explicitly, as done by the readers */
+    for (size_t i = 0; i < evt.vertices().size(); ++i) evt.vertices()[i]->set_id(-100 - (int)i);
+    GenEventGraph renumbered(evt);
+    for (size_t i = 0; i < evt.particles().size(); ++i) assert(renumbered.end_vertex(i) == graph.end_vertex(i));
+
+    /* Cycles are found */
+    GenEventData loop = data;
+    loop.links1.push_back(-6);
+    loop.links2.push_back(1);
+    loop.links1.push_back(1);
+    loop.links2.push_back(-1);
+    assert(GenEventGraph(loop).has_cycles());
+    graph.clear();
+    assert(graph.particles_size() == 0 && graph.vertices_size() == 0);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <sstream>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/ReaderAscii.h"
+#include "HepMC3/WriterAscii.h"
+#include "HepMC3/Data/GenEventData.h"
+using namespace HepMC3;
+static void fill(GenEvent& evt, const bool reversed)
+{
+    std::vector<GenParticlePtr> beams, out;
+    beams.push_back(evt.make_particle(FourVector(0.0, 0.0, 7000.0, 7000.0), 2212, 4));
+    beams.push_back(evt.make_particle(FourVector(0.0, 0.0, -7000.0, 7000.0), 2212, 4));
+    for (int i = 0; i < 5; ++i) out.push_back(evt.make_particle(FourVector(0.1*i, -0.2*i, 10.0/(i + 1), 20.0), 211, 1));
+    out[2]->set_generated_mass(0.13957);
+    evt.add_vertex(beams, out, FourVector(0.0, 0.0, 0.0, 0.0));
+    /* Same particles, attached in another order */
+    GenVertexPtr v = evt.make_vertex(FourVector(1.0, 2.0, 3.0, 4.0));
+    GenParticlePtr a = evt.make_particle(FourVector(1.0, 0.0, 0.0, 1.0), 22, 1);
+    GenParticlePtr b = evt.make_particle(FourVector(-1.0, 0.0, 0.0, 1.0), 22, 1);
+    v->add_particle_in(out[4]);
+    evt.add_vertex(v);
+    if (reversed) { v->add_particle_out(b); v->add_particle_out(a); }
+    else { v->add_particle_out(a); v->add_particle_out(b); }
+    evt.weights() = std::vector<double>({1.0, 0.5, -0.25});
+    evt.add_attribute("signal_process_id", std::make_shared<IntAttribute>(20));
+}
+int main()
+{
+    GenEvent evt1, evt2;
+    fill(evt1, false);
+    fill(evt2, false);
+    assert(evt1.hash() == evt2.hash() && evt1.hash(true) == evt2.hash(true));
+    assert(equivalent(evt1, evt2, 0.0, true));
+
+    /* The event number does not matter */
+    evt2.set_event_number(7);
+    assert(evt1.hash() == evt2.hash());
+
+    /* Copies and serialized events agree */
+    GenEvent copy(evt1);
+    assert(copy.hash(true) == evt1.hash(true));
+    GenEventData data;
+    evt1.write_data(data);
+    GenEvent fromdata;
+    fromdata.read_data(data);
+    assert(fromdata.hash(true) == evt1.hash(true) && equivalent(fromdata, evt1, 0.0, true));
+
+    /* Ascii round trip */
+    std::stringstream stream;
+    WriterAscii writer(stream);
+    writer.write_event(evt1);
+    writer.close();
+    ReaderAscii reader(stream);
+    GenEvent fromtext;
+    reader.read_event(fromtext);
+    assert(!reader.failed());
+    assert(equivalent(fromtext, evt1, 1e-12, true));
+
+    /* The order of the particles inside a vertex does not matter, the order in the event does */
+    GenEvent reordered;
+    fill(reordered, true);
+    assert(reordered.hash() != evt1.hash());
+
+    /* Small changes are within tolerance, but not exactly equal */
+    GenParticlePtr p = evt2.particles()[3];
+    p->set_momentum(p->momentum() + FourVector(0.0, 0.0, 1e-9, 0.0));
+    assert(evt2.hash() != evt1.hash());
+    assert(!equivalent(evt1, evt2) && equivalent(evt1, evt2, 1e-8));
+    evt2.weights()[1] = 0.6;
+    assert(!equivalent(evt1, evt2, 1e-8));
+
+    /* Attributes are optional */
+    evt1.add_attribute("comment", std::make_shared<StringAttribute>("text"));
+    assert(evt1.hash() == copy.hash() && evt1.hash(true) != copy.hash(true));
+    assert(equivalent(evt1, copy) && !equivalent(evt1, copy, 0.0, true));
+    return 0;
+}
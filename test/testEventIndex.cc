@@ -0,0 +1,119 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include "HepMC3/EventIndex.h"
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/ReaderAscii.h"
+#include "HepMC3/WriterAscii.h"
+using namespace HepMC3;
+static void write_run(const std::string& filename, const std::vector<std::string>& weights, const int first)
+{
+    std::shared_ptr<GenRunInfo> run = std::make_shared<GenRunInfo>();
+    run->set_weight_names(weights);
+    run->add_attribute("first", std::make_shared<IntAttribute>(first));
+    WriterAscii output(filename, run);
+    output.set_index_file(EventIndex::sidecar_name(filename));
+    for (int i = first; i < first + 50; ++i) {
+        GenEvent evt(run);
+        evt.set_event_number(i);
+        std::vector<GenParticlePtr> out;
+        for (int j = 0; j < 1 + i%5; ++j) out.push_back(evt.make_particle(FourVector(0.0, 0.0, j, j + 1.0), 211, 1));
+        evt.add_vertex(std::vector<GenParticlePtr>(1, evt.make_particle(FourVector(0.0, 0.0, 0.0, 10.0), 23, 2)), out);
+        evt.add_attribute("tag", std::make_shared<IntAttribute>(i));
+        evt.weights() = std::vector<double>(weights.size(), i);
+        output.write_event(evt);
+    }
+    output.close();
+}
+int main()
+{
+    write_run("inputEventIndex1.hepmc", std::vector<std::string>(1, "a"), 0);
+    write_run("inputEventIndex2.hepmc", std::vector<std::string>({"b", "c"}), 50);
+
+    /* The index written on the fly is the one found by scanning */
+    EventIndex written;
+    assert(written.read(EventIndex::sidecar_name("inputEventIndex1.hepmc")));
+    EventIndex scanned = EventIndex::scan("inputEventIndex1.hepmc");
+    assert(written.size() == 50 && scanned.size() == 50 && written.file_size() == scanned.file_size());
+    for (size_t i = 0; i < written.size(); ++i) {
+        assert(written.event_offset(i) == scanned.event_offset(i));
+        assert(written.run_info_offset(i) == scanned.run_info_offset(i) && written.run_info_offset(i) > 0);
+    }
+
+    /* Two runs in one file */
+    {
+        std::ofstream both("inputEventIndex3.hepmc", std::ios::binary);
+        both << std::ifstream("inputEventIndex1.hepmc", std::ios::binary).rdbuf() << std::ifstream("inputEventIndex2.hepmc", std::ios::binary).rdbuf();
+    }
+    EventIndex index = EventIndex::scan("inputEventIndex3.hepmc");
+    assert(index.size() == 100 && index.run_info_offset(49) != index.run_info_offset(50));
+    assert(index.write(EventIndex::sidecar_name("inputEventIndex3.hepmc")));
+
+    ReaderAscii input("inputEventIndex3.hepmc");
+    assert(input.size() == -1);
+    assert(input.load_index());
+    assert(input.size() == 100);
+    GenEvent evt;
+    assert(input.seek_event(73));
+    input.read_event(evt);
+    assert(!input.failed() && evt.event_number() == 73);
+    assert(evt.run_info()->weight_names().size() == 2 && evt.weight("c") == 73);
+    assert(input.seek_event(10));
+    input.read_event(evt);
+    assert(evt.event_number() == 10 && evt.run_info()->weight_names().size() == 1 && evt.weight("a") == 10);
+    assert(evt.run_info()->attribute<IntAttribute>("first")->value() == 0);
+    input.skip(45);
+    input.read_event(evt);
+    assert(evt.event_number() == 56 && evt.run_info()->weight_names().size() == 2);
+    assert(evt.run_info()->attribute<IntAttribute>("first")->value() == 50);
+    /* Sequential reading continues after a seek */
+    for (int i = 57; i < 100; ++i) {
+        input.read_event(evt);
+        assert(!input.failed() && evt.event_number() == i && evt.attribute<IntAttribute>("tag")->value() == i);
+    }
+    input.read_event(evt);
+    assert(input.failed());
+    assert(input.seek_event(0));
+    input.read_event(evt);
+    assert(!input.failed() && evt.event_number() == 0);
+    assert(!input.seek_event(100));
+    input.close();
+
+    /* Skipping with and without index gives the same events */
+    ReaderAscii plain("inputEventIndex3.hepmc");
+    ReaderAscii indexed("inputEventIndex3.hepmc");
+    assert(indexed.set_index(index));
+    GenEvent evtA, evtB;
+    for (int n: {0, 3, 40, 1, 2}) {
+        plain.skip(n);
+        indexed.skip(n);
+        plain.read_event(evtA);
+        indexed.read_event(evtB);
+        assert(evtA.event_number() == evtB.event_number());
+        assert(evtA.run_info()->weight_names() == evtB.run_info()->weight_names());
+    }
+
+    /* An index of another file is not used */
+    ReaderAscii other("inputEventIndex1.hepmc");
+    assert(!other.set_index(index));
+    assert(other.load_index(EventIndex::sidecar_name("inputEventIndex3.hepmc")) && other.size() == 50);
+    std::istringstream stream("");
+    ReaderAscii from_stream(stream);
+    assert(!from_stream.load_index());
+
+    /* Without an index file no event offsets are recorded */
+    WriterAscii unindexed("inputEventIndex4.hepmc");
+    GenEvent empty;
+    for (int i = 0; i < 10; ++i) unindexed.write_event(empty);
+    assert(unindexed.index().size() == 0);
+    unindexed.close();
+    return 0;
+}
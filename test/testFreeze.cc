@@ -0,0 +1,75 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#include <atomic>
+#undef NDEBUG
+#include <cassert>
+#include <thread>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/Setup.h"
+using namespace HepMC3;
+std::atomic<int> failures(0);
+void read_attributes(const GenEvent& evt)
+{
+    for (int i = 0; i < 1000; ++i) {
+        std::shared_ptr<GenCrossSection> xs = evt.attribute<GenCrossSection>("GenCrossSection");
+        std::shared_ptr<IntAttribute> tag = evt.attribute<IntAttribute>("tag", 1);
+        if (!xs || xs->xsec() != 1.5 || !tag || tag->value() != 42) failures++;
+        if (evt.attribute_as_string("tag", 1) != "42") failures++;
+        if (evt.attribute_names(1).size() != 1 || evt.attributes().size() != 2) failures++;
+        if (evt.vertices().front()->position().z() != 3.0) failures++;
+    }
+}
+int main()
+{
+    GenEvent evt;
+    GenParticlePtr p = evt.make_particle(FourVector(0.0, 0.0, 10.0, 10.0), 11, 1);
+    evt.add_vertex(std::vector<GenParticlePtr>(), std::vector<GenParticlePtr>(1, p), FourVector(0.0, 0.0, 3.0, 0.0));
+    /* Attributes as read from a file */
+    evt.add_attribute("GenCrossSection", std::make_shared<StringAttribute>("1.5 0.1 -1 -1"));
+    evt.add_attribute("tag", std::make_shared<StringAttribute>("42"), 1);
+
+    evt.freeze();
+    assert(evt.is_frozen());
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) threads.emplace_back(read_attributes, std::cref(evt));
+    for (auto& th: threads) th.join();
+    assert(failures == 0);
+    /* The standard attributes were parsed, the others are left as they are */
+    std::map<std::string, std::map<int, std::shared_ptr<Attribute> > > atts = evt.attributes();
+    assert(atts["GenCrossSection"][0]->is_parsed());
+    assert(!atts["tag"][1]->is_parsed());
+
+    /* Changes are refused */
+    Setup::set_print_errors(false);
+    evt.add_attribute("other", std::make_shared<IntAttribute>(1));
+    evt.add_particle(evt.make_particle(FourVector(), 22, 1));
+    evt.remove_particle(p);
+    assert(!evt.boost(FourVector(0.0, 0.0, 0.1, 0.0)));
+    assert(!evt.attribute<IntAttribute>("other") && evt.particles().size() == 1);
+    /* Also through the particles and vertices */
+    p->set_momentum(FourVector());
+    p->set_pid(22);
+    evt.vertices().front()->set_position(FourVector());
+    evt.vertices().front()->add_particle_out(evt.make_particle(FourVector(), 22, 1));
+    evt.vertices().front()->remove_particle_out(p);
+    assert(p->momentum().e() == 10.0 && p->pid() == 11 && p->production_vertex() == evt.vertices().front());
+    assert(evt.vertices().front()->position().z() == 3.0 && evt.vertices().front()->particles_out().size() == 1);
+    /* and when clearing */
+    evt.clear();
+    assert(evt.is_frozen() && evt.particles().size() == 1);
+    Setup::set_print_errors(true);
+
+    evt.thaw();
+    evt.add_attribute("other", std::make_shared<IntAttribute>(1));
+    assert(evt.attribute<IntAttribute>("other"));
+    evt.freeze();
+    evt.thaw();
+    evt.clear();
+    assert(!evt.is_frozen() && evt.particles().empty());
+    return 0;
+}
@@ -0,0 +1,107 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/LorentzTransform.h"
+using namespace HepMC3;
+static bool same(const FourVector& a, const FourVector& b, const double eps = 1e-9)
+{
+    return std::abs(a.x() - b.x()) < eps && std::abs(a.y() - b.y()) < eps && std::abs(a.z() - b.z()) < eps && std::abs(a.t() - b.t()) < eps;
+}
+/* Reference rotation, applied axis by axis */
+static FourVector rotated(const FourVector& v, const FourVector& delta)
+{
+    double x = v.x(), y = v.y(), z = v.z();
+    double t = std::cos(delta.x())*y + std::sin(delta.x())*z;
+    z = -std::sin(delta.x())*y + std::cos(delta.x())*z;
+    y = t;
+    t = std::cos(delta.y())*x - std::sin(delta.y())*z;
+    z = std::sin(delta.y())*x + std::cos(delta.y())*z;
+    x = t;
+    t = std::cos(delta.z())*x + std::sin(delta.z())*y;
+    y = -std::sin(delta.z())*x + std::cos(delta.z())*y;
+    x = t;
+    return FourVector(x, y, z, v.t());
+}
+int main()
+{
+    srand(1);
+    GenEvent evt(Units::GEV, Units::MM);
+    GenVertexPtr v1 = std::make_shared<GenVertex>(FourVector(0.1, 0.2, 0.3, 0.4));
+    GenVertexPtr v2 = std::make_shared<GenVertex>();
+    evt.add_vertex(v1);
+    evt.add_vertex(v2);
+    GenParticlePtr beam = std::make_shared<GenParticle>(FourVector(0.0, 0.0, 7000.0, 7000.0), 2212, 4);
+    v1->add_particle_in(beam);
+    GenParticlePtr link = std::make_shared<GenParticle>(FourVector(1.0, 2.0, 3.0, 10.0), 23, 2);
+    v1->add_particle_out(link);
+    v2->add_particle_in(link);
+    for (int i = 0; i < 1000; ++i) {
+        const double px = rand()/double(RAND_MAX) - 0.5, py = rand()/double(RAND_MAX) - 0.5, pz = 10*rand()/double(RAND_MAX) - 5.0;
+        v2->add_particle_out(std::make_shared<GenParticle>(FourVector(px, py, pz, std::sqrt(px*px + py*py + pz*pz + 0.0195)), 211, 1));
+    }
+    std::vector<FourVector> original;
+    for (ConstGenParticlePtr p: evt.particles()) original.push_back(p->momentum());
+
+    /* Rotation agrees with the step by step calculation */
+    const FourVector angles(0.3, -1.1, 2.0, 0.0);
+    LorentzTransform rotation;
+    assert(rotation.rotate(angles));
+    for (const FourVector& p: original) assert(same(rotation(p), rotated(p, angles)));
+
+    /* Composition equals sequential application */
+    const FourVector beta(0.1, -0.3, 0.5, 0.0);
+    LorentzTransform boost;
+    assert(boost.boost(beta));
+    LorentzTransform combined;
+    combined.boost(beta);
+    combined.rotate(angles);
+    combined.reflect(1);
+    LorentzTransform reflection;
+    reflection.reflect(1);
+    const LorentzTransform product = reflection*rotation*boost;
+    for (int i = 0; i < 4; ++i) for (int j = 0; j < 4; ++j) assert(std::abs(product(i, j) - combined(i, j)) < 1e-12);
+    for (const FourVector& p: original) {
+        FourVector q = combined(p);
+        assert(same(q, reflection(rotation(boost(p))), 1e-9*p.e()));
+        assert(std::abs(q.m2() - p.m2()) < 1e-9*p.e()*p.e());
+    }
+
+    /* Both precisions agree, and the inverse restores the event */
+    GenEvent copy(evt);
+    LorentzTransformLD extended;
+    extended.boost(beta);
+    extended.rotate(angles);
+    extended.reflect(1);
+    extended.apply(copy);
+    combined.apply(evt);
+    for (size_t i = 0; i < original.size(); ++i) assert(same(evt.particles()[i]->momentum(), copy.particles()[i]->momentum(), 1e-9*original[i].e()));
+    assert(!v2->has_set_position());
+    assert(same(v2->position(), combined(FourVector(0.1, 0.2, 0.3, 0.4))));
+
+    LorentzTransformLD unrotate;
+    unrotate.reflect(1);
+    unrotate.rotate(FourVector(0.0, 0.0, -angles.z(), 0.0));
+    unrotate.rotate(FourVector(0.0, -angles.y(), 0.0, 0.0));
+    unrotate.rotate(FourVector(-angles.x(), 0.0, 0.0, 0.0));
+    LorentzTransformLD unboost;
+    unboost.boost(FourVector(-beta.x(), -beta.y(), -beta.z(), 0.0));
+    (unboost*unrotate).apply(copy);
+    for (size_t i = 0; i < original.size(); ++i) assert(same(copy.particles()[i]->momentum(), original[i], 1e-9*original[i].e()));
+    assert(same(copy.vertices()[0]->position(), FourVector(0.1, 0.2, 0.3, 0.4)));
+
+    /* Invalid input leaves the transformation unchanged */
+    LorentzTransform identity;
+    assert(!identity.boost(FourVector(0.0, 0.0, 1.1, 0.0)));
+    assert(!identity.reflect(4));
+    for (int i = 0; i < 4; ++i) for (int j = 0; j < 4; ++j) assert(identity(i, j) == (i == j ? 1.0 : 0.0));
+    return 0;
+}
@@ -0,0 +1,71 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <sstream>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/MemoryUsage.h"
+using namespace HepMC3;
+static void fill(GenEvent& evt, const int n)
+{
+    std::vector<GenParticlePtr> out;
+    for (int i = 0; i < n; ++i) out.push_back(evt.make_particle(FourVector(0.0, 0.0, i, i), 211, 1));
+    evt.add_vertex(std::vector<GenParticlePtr>(1, evt.make_particle(FourVector(0.0, 0.0, 0.0, 100.0), 23, 2)), out);
+}
+int main()
+{
+    GenEvent evt;
+    const MemoryUsage empty = evt.memory_usage();
+    assert(empty.particles == 0 && empty.links == 0 && empty.arena == 0);
+
+    fill(evt, 100);
+    MemoryUsage usage = evt.memory_usage();
+    assert(usage.particles >= 101*sizeof(GenParticle));
+    assert(usage.vertices >= sizeof(GenVertex));
+    /* The incoming particle is stored in the vertex itself */
+    assert(usage.links >= 100*sizeof(GenParticlePtr));
+    assert(usage.total() == usage.particles + usage.vertices + usage.links + usage.attributes + usage.strings + usage.weights);
+
+    /* Unparsed text is counted as strings */
+    evt.weights() = std::vector<double>(10, 1.0);
+    evt.add_attribute("text", std::make_shared<StringAttribute>(std::string(1000, 'x')));
+    MemoryUsage with_text = evt.memory_usage();
+    assert(with_text.weights >= 10*sizeof(double));
+    assert(with_text.strings - usage.strings >= 1000 && with_text.strings - usage.strings < 2000);
+    assert(with_text.attributes > usage.attributes);
+
+    /* Events in an arena report the arena instead of the objects */
+    GenEvent pooled;
+    pooled.set_arena(std::make_shared<EventArena>());
+    fill(pooled, 100);
+    MemoryUsage arena = pooled.memory_usage();
+    assert(arena.arena >= 101*sizeof(GenParticle));
+    assert(arena.particles < usage.particles);
+
+    std::shared_ptr<GenRunInfo> run = std::make_shared<GenRunInfo>();
+    run->set_weight_names(std::vector<std::string>({"nominal", "a rather long name of a systematic variation"}));
+    run->add_attribute("description", std::make_shared<StringAttribute>(std::string(500, 'y')));
+    MemoryUsage run_usage = run->memory_usage();
+    assert(run_usage.weights > 2*sizeof(std::string) && run_usage.strings >= 500);
+
+    /* Statistics over a stream */
+    MemoryUsageStatistics stats;
+    stats.add(empty);
+    stats.add(usage);
+    stats.add(with_text);
+    assert(stats.count() == 3);
+    assert(stats.min().particles == 0 && stats.max().strings == with_text.strings);
+    assert(stats.min_total() == empty.total() && stats.max_total() == with_text.total());
+    assert(stats.mean().links == (usage.links + with_text.links)/3);
+    std::ostringstream os;
+    stats.print(os);
+    assert(os.str().find("attributes") != std::string::npos);
+    stats.clear();
+    assert(stats.count() == 0);
+    return 0;
+}
@@ -0,0 +1,82 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <cmath>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+using namespace HepMC3;
+static void fill(GenEvent& evt, const int pid, const double scale)
+{
+    std::vector<GenParticlePtr> beams, out;
+    beams.push_back(evt.make_particle(FourVector(0.0, 0.0, 6500.0*scale, 6500.0*scale), 2212, 4));
+    beams.push_back(evt.make_particle(FourVector(0.0, 0.0, -6500.0*scale, 6500.0*scale), 2212, 4));
+    for (int i = 0; i < 4; ++i) out.push_back(evt.make_particle(FourVector(i*scale, 0.0, 0.0, 10.0*scale), pid, 1));
+    evt.add_vertex(beams, out);
+    std::vector<GenParticlePtr> decay(2, nullptr);
+    for (auto& p: decay) p = evt.make_particle(FourVector(0.0, 0.0, scale, 2.0*scale), 22, 1);
+    GenVertexPtr v = evt.add_vertex(std::vector<GenParticlePtr>(1, out[0]), decay, FourVector(0.0, 0.0, 1.0, 0.0));
+    evt.add_attribute("tag", std::make_shared<IntAttribute>(pid), out[1]->id());
+    evt.add_attribute("vtag", std::make_shared<IntAttribute>(pid), v->id());
+    evt.add_attribute("signal_process_id", std::make_shared<IntAttribute>(pid));
+}
+int main()
+{
+    GenEvent signal;
+    fill(signal, 11, 1.0);
+    signal.weights() = std::vector<double>(1, 2.0);
+
+    std::vector<GenEvent> pileup(3);
+    for (size_t i = 0; i < pileup.size(); ++i) fill(pileup[i], 211 + i, 1.0);
+    pileup[1].shift_position_to(FourVector(0.0, 0.0, 10.0, 0.0));
+    /* Different units are converted */
+    pileup[2].set_units(Units::MEV, Units::CM);
+
+    std::vector<const GenEvent*> others;
+    std::vector<FourVector> shifts;
+    for (size_t i = 0; i < pileup.size(); ++i) {
+        others.push_back(&pileup[i]);
+        shifts.push_back(FourVector(0.0, 0.0, 0.5*i, 0.1*i));
+    }
+    GenEvent merged = signal.clone();
+    merged.merge(others, shifts);
+
+    const size_t np = signal.particles().size(), nv = signal.vertices().size();
+    assert(merged.particles().size() == 4*np && merged.vertices().size() == 4*nv);
+    assert(merged.beams().size() == 8);
+    assert(merged.weights() == signal.weights());
+    assert(merged.attribute<IntAttribute>("signal_process_id")->value() == 11);
+    for (size_t i = 0; i < merged.particles().size(); ++i) assert(merged.particles()[i]->id() == (int)i + 1);
+    for (size_t k = 0; k < 4; ++k) {
+        const GenEvent& source = k ? pileup[k - 1] : signal;
+        /* Particles keep their data and topology, with offset ids */
+        for (size_t i = 0; i < np; ++i) {
+            ConstGenParticlePtr p = merged.particles()[k*np + i];
+            ConstGenParticlePtr q = source.particles()[i];
+            assert(p->pid() == q->pid());
+            assert(std::abs(p->momentum().e() - q->momentum().e()*(k == 3 ? 0.001 : 1.0)) < 1e-9);
+            assert(p->end_vertex() ? q->end_vertex() && p->end_vertex()->id() == q->end_vertex()->id() - (int)(k*nv) : !q->end_vertex());
+            assert(p->parents().size() == q->parents().size());
+        }
+        /* Attributes follow their objects */
+        assert(merged.attribute<IntAttribute>("tag", k*np + 4)->value() == (k ? 210 + (int)k : 11));
+        assert(merged.attribute<IntAttribute>("vtag", -(int)(k*nv) - 2)->value() == (k ? 210 + (int)k : 11));
+        assert(merged.attribute<IntAttribute>("tag", k*np + 4)->particle() == merged.particles()[k*np + 3]);
+    }
+    /* Positions include the source event position and the shift */
+    assert(merged.vertices()[nv + 1]->position().z() == 1.0);
+    assert(merged.vertices()[2*nv]->position().z() == 10.5);
+    assert(merged.vertices()[2*nv + 1]->position().z() == 11.5);
+    assert(std::abs(merged.vertices()[3*nv + 1]->position().z() - 2.0) < 1e-9);
+    assert(std::abs(merged.vertices()[3*nv + 1]->position().t() - 0.2) < 1e-9);
+
+    /* Merging one by one gives the same event */
+    GenEvent stepwise = signal.clone();
+    for (size_t i = 0; i < pileup.size(); ++i) stepwise.merge(pileup[i], shifts[i]);
+    assert(equivalent(stepwise, merged, 0.0, true));
+    return 0;
+}
@@ -0,0 +1,149 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <algorithm>
+#include <set>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+using namespace HepMC3;
+/* Surviving ancestors of a particle, found by walking the original event */
+static void surviving_ancestors(const ConstGenParticlePtr& p, std::set<int>& result)
+{
+    if (!p->production_vertex()) return;
+    for (ConstGenParticlePtr q: p->production_vertex()->particles_in()) {
+        if (q->status() != 2) result.insert(q->pid());
+        else surviving_ancestors(q, result);
+    }
+}
+int main()
+{
+    GenEvent evt;
+    std::vector<GenParticlePtr> beams;
+    beams.push_back(evt.make_particle(FourVector(0.0, 0.0, 6500.0, 6500.0), 2212, 4));
+    beams.push_back(evt.make_particle(FourVector(0.0, 0.0, -6500.0, 6500.0), 2212, 4));
+    /* Hard process, status 3 */
+    std::vector<GenParticlePtr> hard;
+    hard.push_back(evt.make_particle(FourVector(0.0, 0.0, 0.0, 91.0), 23, 3));
+    hard.push_back(evt.make_particle(FourVector(5.0, 0.0, 0.0, 5.0), 21, 3));
+    evt.add_vertex(beams, hard, FourVector(0.0, 0.0, 1.0, 0.0));
+    /* Shower chains of status 2 particles ending in hadrons, status 1 */
+    int pid = 100;
+    std::vector<GenParticlePtr> final_state;
+    for (GenParticlePtr mother: hard) {
+        GenParticlePtr current = mother;
+        for (int step = 0; step < 3; ++step) {
+            std::vector<GenParticlePtr> out(1, evt.make_particle(FourVector(1.0, 0.0, 0.0, 1.0), 21, 2));
+            out.push_back(evt.make_particle(FourVector(0.0, 1.0, 0.0, 1.0), pid++, 1));
+            final_state.push_back(out.back());
+            evt.add_vertex(std::vector<GenParticlePtr>(1, current), out);
+            current = out.front();
+        }
+        std::vector<GenParticlePtr> hadrons;
+        for (int i = 0; i < 2; ++i) hadrons.push_back(evt.make_particle(FourVector(0.5, 0.5, 0.0, 1.0), pid++, 1));
+        final_state.insert(final_state.end(), hadrons.begin(), hadrons.end());
+        evt.add_vertex(std::vector<GenParticlePtr>(1, current), hadrons);
+    }
+    /* The two showers merge into a cluster */
+    std::vector<GenParticlePtr> cluster_in;
+    cluster_in.push_back(evt.make_particle(FourVector(1.0, 0.0, 0.0, 1.0), 91, 2));
+    evt.vertices()[1]->add_particle_out(cluster_in.back());
+    cluster_in.push_back(evt.make_particle(FourVector(1.0, 0.0, 0.0, 1.0), 91, 2));
+    evt.vertices()[5]->add_particle_out(cluster_in.back());
+    GenVertexPtr cluster = evt.add_vertex(cluster_in, std::vector<GenParticlePtr>(1, evt.make_particle(FourVector(1.0, 0.0, 0.0, 1.0), 211, 1)));
+    final_state.push_back(cluster->particles_out().front());
+    for (GenParticlePtr p: final_state) evt.add_attribute("tag", std::make_shared<IntAttribute>(p->pid()), p->id());
+    evt.add_attribute("vtag", std::make_shared<IntAttribute>(1), cluster->id());
+    evt.add_attribute("signal_process_id", std::make_shared<IntAttribute>(1));
+
+    std::map<int, std::set<int> > expected;
+    for (ConstGenParticlePtr p: evt.particles()) if (p->status() != 2) surviving_ancestors(p, expected[p->pid()]);
+    const size_t n_kept = evt.particles().size() - 8;
+
+    GenEvent::IdMap ids = evt.prune([](ConstGenParticlePtr p) { return p->status() != 2; });
+    assert(evt.particles().size() == n_kept);
+    for (size_t i = 0; i < evt.particles().size(); ++i) assert(evt.particles()[i]->id() == (int)i + 1 && evt.particles()[i]->status() != 2);
+    for (size_t i = 0; i < evt.vertices().size(); ++i) assert(evt.vertices()[i]->id() == -(int)i - 1);
+    /* Every particle hangs below its nearest surviving ancestors, and the
+       ancestors of the vertices collapsed with its production vertex */
+    for (ConstGenParticlePtr p: evt.particles()) {
+        std::set<int> parents;
+        for (ConstGenParticlePtr q: p->parents()) parents.insert(q->pid());
+        assert(std::includes(parents.begin(), parents.end(), expected[p->pid()].begin(), expected[p->pid()].end()));
+        if (p->status() != 4) assert(p->production_vertex()->parent_event() == &evt);
+    }
+    /* The shower of each hard particle and the cluster collapse into one vertex */
+    assert(evt.vertices().size() == 2 && evt.beams().size() == 2);
+    assert(hard[0]->end_vertex() == hard[1]->end_vertex() && hard[0]->end_vertex()->particles_out().size() == 11);
+    for (GenParticlePtr p: final_state) {
+        assert(p->parent_event() == &evt);
+        assert(evt.attribute<IntAttribute>("tag", p->id())->value() == p->pid());
+        assert(evt.attribute<IntAttribute>("tag", p->id())->particle() == p);
+    }
+    assert(ids(cluster->id()) == 0 || cluster->parent_event() == nullptr);
+    assert(!evt.attribute<IntAttribute>("vtag", -2));
+    assert(evt.attribute<IntAttribute>("signal_process_id"));
+
+    /* Removing the beams keeps the hard vertex, without incoming particles */
+    evt.prune([](ConstGenParticlePtr p) { return p->status() != 4; });
+    assert(evt.beams().empty() && evt.vertices().size() == 2);
+    assert(hard[0]->production_vertex()->parent_event() == &evt && hard[0]->production_vertex()->particles_in().empty());
+
+    /* A removed particle next to a kept one between the same vertices: no self-loop */
+    GenEvent parallel;
+    GenParticlePtr beam = parallel.make_particle(FourVector(0.0, 0.0, 10.0, 10.0), 2212, 4);
+    GenParticlePtr q = parallel.make_particle(FourVector(), 1, 2);
+    GenParticlePtr g = parallel.make_particle(FourVector(), 21, 1);
+    GenParticlePtr h = parallel.make_particle(FourVector(), 211, 1);
+    GenVertexPtr w1 = parallel.add_vertex(std::vector<GenParticlePtr>(1, beam), std::vector<GenParticlePtr>({q, g}));
+    GenVertexPtr w2 = parallel.add_vertex(std::vector<GenParticlePtr>({q, g}), std::vector<GenParticlePtr>(1, h));
+    parallel.prune([](ConstGenParticlePtr p) { return p->pid() != 1; });
+    assert(parallel.vertices().size() == 2 && g->production_vertex() == w1 && g->end_vertex() == w2);
+    assert(w2->particles_in().size() == 1 && h->production_vertex() == w2);
+
+    /* A removed particle bypassing a chain of kept ones: no loop */
+    GenEvent bypass;
+    GenParticlePtr b0 = bypass.make_particle(FourVector(), 2212, 4);
+    GenParticlePtr x = bypass.make_particle(FourVector(), 1, 2);
+    GenParticlePtr k1 = bypass.make_particle(FourVector(), 21, 2);
+    GenParticlePtr k2 = bypass.make_particle(FourVector(), 21, 2);
+    GenParticlePtr k3 = bypass.make_particle(FourVector(), 211, 1);
+    GenVertexPtr u1 = bypass.add_vertex(std::vector<GenParticlePtr>(1, b0), std::vector<GenParticlePtr>({x, k1}));
+    GenVertexPtr u2 = bypass.add_vertex(std::vector<GenParticlePtr>(1, k1), std::vector<GenParticlePtr>(1, k2));
+    GenVertexPtr u3 = bypass.add_vertex(std::vector<GenParticlePtr>({x, k2}), std::vector<GenParticlePtr>(1, k3));
+    bypass.prune([](ConstGenParticlePtr p) { return p->pid() != 1; });
+    assert(bypass.vertices().size() == 3 && k1->production_vertex() == u1 && k2->production_vertex() == u2);
+    assert(k2->end_vertex() == u3 && u3->particles_in().size() == 1 && k3->production_vertex() == u3);
+
+    /* Removing one beam keeps the hard vertex with the other beam */
+    GenEvent one_beam;
+    GenParticlePtr beam1 = one_beam.make_particle(FourVector(0.0, 0.0, 10.0, 10.0), 2212, 4);
+    GenParticlePtr beam2 = one_beam.make_particle(FourVector(0.0, 0.0, -10.0, 10.0), 11, 4);
+    GenParticlePtr z = one_beam.make_particle(FourVector(), 23, 1);
+    GenVertexPtr hard_vertex = one_beam.add_vertex(std::vector<GenParticlePtr>({beam1, beam2}), std::vector<GenParticlePtr>(1, z));
+    one_beam.prune([](ConstGenParticlePtr p) { return p->pid() != 2212; });
+    assert(one_beam.particles().size() == 2 && one_beam.vertices().size() == 1 && hard_vertex->parent_event() == &one_beam);
+    assert(beam2->end_vertex() == hard_vertex && hard_vertex->particles_in().size() == 1 && z->production_vertex() == hard_vertex);
+    assert(one_beam.beams().size() == 1 && one_beam.beams()[0] == beam2);
+    for (ConstGenParticlePtr p: one_beam.particles()) assert(p->end_vertex() != p->production_vertex());
+
+    /* Vertex ids set explicitly, as done by the readers */
+    GenEvent renumbered;
+    GenParticlePtr a = renumbered.make_particle(FourVector(), 1, 2);
+    GenParticlePtr b = renumbered.make_particle(FourVector(), 2, 1);
+    GenParticlePtr c = renumbered.make_particle(FourVector(), 3, 1);
+    GenVertexPtr v1 = renumbered.add_vertex(std::vector<GenParticlePtr>(), std::vector<GenParticlePtr>(1, a));
+    GenVertexPtr v2 = renumbered.add_vertex(std::vector<GenParticlePtr>(1, a), std::vector<GenParticlePtr>(1, b));
+    v1->add_particle_in(c);
+    v1->set_id(-5);
+    v2->set_id(-3);
+    renumbered.add_attribute("vtag", std::make_shared<IntAttribute>(2), -3);
+    renumbered.prune([](ConstGenParticlePtr p) { return p->pid() != 1; });
+    assert(renumbered.particles().size() == 2 && b->production_vertex() == v1 && v1->id() == -1);
+    assert(!renumbered.attribute<IntAttribute>("vtag", -2) && !renumbered.attribute<IntAttribute>("vtag", -3));
+    return 0;
+}
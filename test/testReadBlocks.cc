@@ -0,0 +1,84 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <fstream>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/ReaderAscii.h"
+#include "HepMC3/WriterAscii.h"
+using namespace HepMC3;
+static void fill(GenEvent& evt, const int n)
+{
+    std::vector<GenParticlePtr> out;
+    for (int i = 0; i < n; ++i) out.push_back(evt.make_particle(FourVector(0.1*i, -1.0/(i + 3), 1e-7*i, i + 1.0), 211, 1));
+    GenVertexPtr v = evt.add_vertex(std::vector<GenParticlePtr>(1, evt.make_particle(FourVector(0.0, 0.0, 0.0, 100.0), 23, 2)), out, FourVector(0.0, 0.0, n, 0.0));
+    evt.add_attribute("tag", std::make_shared<IntAttribute>(-n), out.front()->id());
+    evt.add_attribute("text", std::make_shared<StringAttribute>("event " + std::to_string(n)), v->id());
+}
+int main()
+{
+    /* More than one block of events, so that lines cross the block boundaries */
+    WriterAscii output("inputReadBlocks.hepmc");
+    if(output.failed()) return 1;
+    GenEvent source(Units::GEV,Units::MM);
+    for (int i = 0; i < 300; ++i) {
+        source.set_event_number(i);
+        fill(source, 50 + i%7);
+        output.write_event(source);
+        source.clear();
+    }
+    /* An attribute longer than a block */
+    source.set_event_number(300);
+    fill(source, 3);
+    source.add_attribute("long", std::make_shared<StringAttribute>(std::string(3 << 20, 'x')));
+    output.write_event(source);
+    source.clear();
+    output.close();
+
+    /* The file is read in blocks, the stream line by line */
+    ReaderAscii inputA("inputReadBlocks.hepmc");
+    std::ifstream stream("inputReadBlocks.hepmc");
+    ReaderAscii inputB(stream);
+    GenEvent evtA, evtB;
+    int nevents = 0;
+    while (nevents < 300) {
+        inputA.read_event(evtA);
+        inputB.read_event(evtB);
+        assert(!inputA.failed() && !inputB.failed());
+        assert(evtA.event_number() == nevents && evtA.particles().size() == 51u + nevents%7);
+        assert(evtA.attribute<IntAttribute>("tag", 2)->value() == -50 - nevents%7);
+        assert(equivalent(evtA, evtB, 0.0, true));
+        nevents++;
+    }
+    inputA.read_event(evtA);
+    assert(!inputA.failed() && evtA.event_number() == 300);
+    assert(evtA.attribute<StringAttribute>("long")->value() == std::string(3 << 20, 'x'));
+    inputA.read_event(evtA);
+    assert(inputA.failed());
+    inputA.close();
+
+    /* Skipping events */
+    ReaderAscii inputC("inputReadBlocks.hepmc");
+    inputC.skip(100);
+    inputC.read_event(evtA);
+    assert(!inputC.failed() && evtA.event_number() == 100);
+    inputC.close();
+
+    /* The last line does not need an end of line character */
+    {
+        std::ofstream truncated("inputReadBlocks2.hepmc");
+        truncated << "HepMC::Version 3.02.06\nHepMC::Asciiv3-START_EVENT_LISTING\n";
+        truncated << "E 7 1 2\nU GEV MM\nP 1 0 2212 0 0 1 1 0.938 4\nV -1 0 [1]\nP 2 -1 211 0 0 1 1 0.139 1";
+    }
+    ReaderAscii inputD("inputReadBlocks2.hepmc");
+    inputD.read_event(evtA);
+    assert(evtA.event_number() == 7 && evtA.particles().size() == 2 && evtA.particles()[1]->status() == 1);
+    assert(inputD.failed());
+    inputD.close();
+    return 0;
+}
@@ -0,0 +1,129 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <streambuf>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/ReaderAscii.h"
+#include "HepMC3/ReaderAsciiMT.h"
+#include "HepMC3/WriterAscii.h"
+using namespace HepMC3;
+static void write_run(const std::string& filename, const std::vector<std::string>& weights, const int first)
+{
+    std::shared_ptr<GenRunInfo> run = std::make_shared<GenRunInfo>();
+    run->set_weight_names(weights);
+    run->add_attribute("first", std::make_shared<IntAttribute>(first));
+    WriterAscii output(filename, run);
+    for (int i = first; i < first + 400; ++i) {
+        GenEvent evt(run);
+        evt.set_event_number(i);
+        std::vector<GenParticlePtr> out;
+        for (int j = 0; j < 40 + i%9; ++j) out.push_back(evt.make_particle(FourVector(0.1*j, -1.0/(j + 3), 1e-7*i, j + 1.0), 211, 1));
+        GenVertexPtr v = evt.add_vertex(std::vector<GenParticlePtr>(1, evt.make_particle(FourVector(0.0, 0.0, 0.0, 100.0), 23, 2)), out);
+        evt.add_attribute("tag", std::make_shared<IntAttribute>(i), out.back()->id());
+        evt.add_attribute("text", std::make_shared<StringAttribute>("event " + std::to_string(i)), v->id());
+        evt.weights() = std::vector<double>(weights.size(), i);
+        output.write_event(evt);
+    }
+    output.close();
+}
+/* Gives the text, then fails like a broken device */
+class FailingBuffer: public std::streambuf
+{
+public:
+    explicit FailingBuffer(std::string& text) { setg(&text[0], &text[0], &text[0] + text.size()); }
+    int_type underflow() override { throw std::runtime_error("device failure"); }
+};
+int main()
+{
+    /* Two runs in one file, each in several chunks */
+    write_run("inputReadParallel1.hepmc", std::vector<std::string>(1, "a"), 0);
+    write_run("inputReadParallel2.hepmc", std::vector<std::string>({"b", "c"}), 400);
+    {
+        std::ofstream both("inputReadParallel3.hepmc", std::ios::binary);
+        both << std::ifstream("inputReadParallel1.hepmc", std::ios::binary).rdbuf() << std::ifstream("inputReadParallel2.hepmc", std::ios::binary).rdbuf();
+    }
+
+    /* The events are the ones of ReaderAscii, in the same order */
+    ReaderAscii inputA("inputReadParallel3.hepmc");
+    ReaderAsciiMT inputB("inputReadParallel3.hepmc", 3);
+    GenEvent evtA, evtB;
+    std::shared_ptr<GenRunInfo> run;
+    int nevents = 0;
+    while (true) {
+        inputA.read_event(evtA);
+        inputB.read_event(evtB);
+        if ( inputA.failed() ) break;
+        assert(!inputB.failed());
+        assert(evtB.event_number() == nevents && equivalent(evtA, evtB, 0.0, true));
+        assert(evtB.attribute<IntAttribute>("tag", 41 + nevents%9)->value() == nevents);
+        assert(evtB.run_info() == inputB.run_info());
+        assert(evtB.run_info()->weight_names() == evtA.run_info()->weight_names());
+        assert(evtB.run_info()->attribute<IntAttribute>("first")->value() == (nevents < 400 ? 0 : 400));
+        assert(evtB.weights().back() == nevents);
+        /* The events of a run share their run information */
+        if (nevents == 0 || nevents == 400) run = evtB.run_info();
+        assert(evtB.run_info() == run);
+        nevents++;
+    }
+    assert(nevents == 800 && inputB.failed());
+    inputA.close();
+    inputB.close();
+
+    /* Skipping events, reading from a stream, and closing early */
+    std::ifstream stream("inputReadParallel3.hepmc");
+    ReaderAsciiMT inputC(stream, 2);
+    assert(inputC.skip(450));
+    inputC.read_event(evtB);
+    assert(!inputC.failed() && evtB.event_number() == 450 && evtB.weight("c") == 450);
+    inputC.close();
+
+    /* A broken event ends the reading after the events before it */
+    {
+        std::ifstream good("inputReadParallel1.hepmc");
+        std::ofstream broken("inputReadParallel4.hepmc");
+        std::string line;
+        int n = 0;
+        while (std::getline(good, line)) {
+            if (line[0] == 'E' && n++ == 10) line = "E 10 2 3";
+            broken << line << "\n";
+        }
+    }
+    ReaderAsciiMT inputD("inputReadParallel4.hepmc");
+    nevents = 0;
+    while (inputD.read_event(evtB)) assert(evtB.event_number() == nevents++);
+    assert(nevents == 10 && inputD.failed());
+
+    ReaderAsciiMT inputE("nonexistingReadParallel.hepmc");
+    assert(inputE.failed() && !inputE.read_event(evtB));
+
+    /* An exception while splitting the input is thrown after the events split before */
+    std::string text;
+    {
+        std::ifstream whole("inputReadParallel1.hepmc", std::ios::binary);
+        text.assign(std::istreambuf_iterator<char>(whole), std::istreambuf_iterator<char>());
+    }
+    text.resize(2*text.size()/3);
+    FailingBuffer buffer(text);
+    std::istream failing(&buffer);
+    failing.exceptions(std::ios::badbit);
+    ReaderAsciiMT inputF(failing, 2);
+    nevents = 0;
+    bool thrown = false;
+    try {
+        while (inputF.read_event(evtB)) assert(evtB.event_number() == nevents++);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown && nevents > 0 && inputF.failed() && !inputF.read_event(evtB));
+    inputF.close();
+    return 0;
+}
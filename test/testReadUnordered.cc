@@ -0,0 +1,77 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <sstream>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/ReaderAscii.h"
+#include "HepMC3/WriterAscii.h"
+using namespace HepMC3;
+static const char* header = "HepMC::Version 3.02.06\nHepMC::Asciiv3-START_EVENT_LISTING\n";
+int main()
+{
+    /* Vertices listed out of the order of their ids, particles listed before
+       their production vertex and incoming particles listed before they are parsed */
+    std::stringstream unordered;
+    unordered << header
+              << "E 1 3 6\nU GEV MM\n"
+              << "A -3 tag 3\nA -1 tag 1\n"
+              << "P 1 0 2212 0 0 10 10 0.938 4\n"
+              << "V -3 0 [1,2] @ 0 0 1 0\n"
+              << "P 2 0 2212 0 0 -10 10 0.938 4\n"
+              << "P 3 -3 23 0 0 0 20 0 2\n"
+              << "P 4 -1 11 1 0 0 1 0 1\n"
+              << "P 5 3 13 0 1 0 1 0 1\n"
+              << "P 6 3 13 0 -1 0 1 0 1\n"
+              << "V -1 0 [3,5,6] @ 0 0 2 0\n";
+    ReaderAscii input(unordered);
+    GenEvent evt;
+    input.read_event(evt);
+    assert(evt.particles().size() == 6 && evt.vertices().size() == 3);
+    for (size_t i = 0; i < evt.vertices().size(); ++i) assert(evt.vertices()[i]->id() == -(int)i - 1);
+    ConstGenVertexPtr hard = evt.vertices()[2];
+    assert(hard->particles_in().size() == 2 && hard->particles_in()[1]->id() == 2);
+    assert(hard->position().z() == 1.0 && evt.attribute<IntAttribute>("tag", -3)->value() == 3);
+    ConstGenVertexPtr decay = evt.vertices()[0];
+    assert(decay->particles_in().size() == 3 && decay->particles_out().size() == 1);
+    assert(evt.particles()[3]->production_vertex() == decay && evt.attribute<IntAttribute>("tag", -1)->value() == 1);
+    /* The vertex implied by particle 3 takes the free id */
+    assert(evt.particles()[4]->production_vertex()->id() == -2 && evt.particles()[2]->end_vertex() == decay);
+
+    /* Ids that are not -1...-N are kept */
+    std::stringstream sparse;
+    sparse << header
+           << "E 2 2 3\nU GEV MM\n"
+           << "A -7 tag 7\n"
+           << "P 1 0 2212 0 0 10 10 0.938 4\n"
+           << "V -7 2 [1]\n"
+           << "P 2 -7 22 0 0 5 5 0 1\n"
+           << "V -4 0 [2] @ 0 0 3 0\n"
+           << "P 3 -4 22 0 0 5 5 0 1\n";
+    ReaderAscii input2(sparse);
+    input2.read_event(evt);
+    assert(evt.vertices().size() == 2 && evt.vertices()[0]->id() == -7 && evt.vertices()[1]->id() == -4);
+    assert(evt.vertices()[0]->status() == 2 && evt.particles()[2]->production_vertex()->position().z() == 3.0);
+    assert(evt.attribute<IntAttribute>("tag", -7)->value() == 7);
+
+    /* Writing the events back gives the same text */
+    std::stringstream written;
+    WriterAscii output(written);
+    output.write_event(evt);
+    output.close();
+    std::stringstream again_in(written.str());
+    ReaderAscii input3(again_in);
+    GenEvent again;
+    input3.read_event(again);
+    std::stringstream rewritten;
+    WriterAscii output2(rewritten);
+    output2.write_event(again);
+    output2.close();
+    assert(rewritten.str() == written.str());
+    return 0;
+}
@@ -0,0 +1,102 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <set>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/ReaderAscii.h"
+#include "HepMC3/WriterAscii.h"
+#include "HepMC3TestUtils.h"
+using namespace HepMC3;
+static void fill(GenEvent& evt, const int n)
+{
+    std::vector<GenParticlePtr> out;
+    for (int i = 0; i < n; ++i) out.push_back(evt.make_particle(FourVector(0.0, 0.0, i, i + 1.0), 211, 1));
+    GenVertexPtr v = evt.add_vertex(std::vector<GenParticlePtr>(1, evt.make_particle(FourVector(0.0, 0.0, 0.0, 100.0), 23, 2)), out, FourVector(0.0, 0.0, n, 0.0));
+    evt.add_attribute("tag", std::make_shared<IntAttribute>(n), out.front()->id());
+    evt.add_attribute("text", std::make_shared<StringAttribute>("event " + std::to_string(n)), v->id());
+}
+static std::set<const void*> objects(const GenEvent& evt)
+{
+    std::set<const void*> result;
+    for (ConstGenParticlePtr p: evt.particles()) result.insert(p.get());
+    for (ConstGenVertexPtr v: evt.vertices()) result.insert(v.get());
+    return result;
+}
+int main()
+{
+    WriterAscii output("inputRecycling.hepmc");
+    if(output.failed()) return 1;
+    GenEvent source(Units::GEV,Units::MM);
+    for (int i = 0; i < 10; ++i) {
+        source.set_event_number(i);
+        fill(source, 10 + i%2);
+        output.write_event(source);
+        source.clear();
+    }
+    output.close();
+
+    /* Read the events once without and once with recycling */
+    ReaderAscii inputA("inputRecycling.hepmc");
+    ReaderAscii inputB("inputRecycling.hepmc");
+    WriterAscii outputA("frominputRecycling_default.hepmc");
+    WriterAscii outputB("frominputRecycling_recycled.hepmc");
+    GenEvent evtA(Units::GEV,Units::MM);
+    GenEvent evtB(Units::GEV,Units::MM);
+    evtB.set_recycling(true);
+    std::set<const void*> seen;
+    int nevents = 0;
+    while( !inputA.failed() && !inputB.failed() )
+    {
+        inputA.read_event(evtA);
+        inputB.read_event(evtB);
+        if( inputA.failed() || inputB.failed() ) break;
+        outputA.write_event(evtA);
+        outputB.write_event(evtB);
+        assert(evtB.particles().size() == evtA.particles().size());
+        assert(evtB.attribute<StringAttribute>("text", -1)->value() == evtA.attribute<StringAttribute>("text", -1)->value());
+        /* From the third event on every object has been allocated before */
+        std::set<const void*> current = objects(evtB);
+        if (nevents > 1) for (const void* o: current) assert(seen.count(o));
+        seen.insert(current.begin(), current.end());
+        evtA.clear();
+        evtB.clear();
+        nevents++;
+    }
+    inputA.close();
+    inputB.close();
+    outputA.close();
+    outputB.close();
+    assert(nevents == 10);
+
+    /* Objects kept by the user are not recycled */
+    GenEvent evtC;
+    evtC.set_recycling(true);
+    fill(evtC, 5);
+    GenParticlePtr kept = evtC.particles().back();
+    evtC.clear();
+    fill(evtC, 5);
+    for (ConstGenParticlePtr p: evtC.particles()) assert(p != kept);
+    assert(kept->pid() == 211 && kept->momentum().e() == 5.0);
+    assert(!kept->production_vertex());
+    evtC.set_recycling(false);
+    assert(!evtC.recycling());
+
+    /* Event attributes fall back to the run information again after a recycling clear */
+    std::shared_ptr<GenRunInfo> run = std::make_shared<GenRunInfo>();
+    run->add_attribute("tag", std::make_shared<IntAttribute>(-1));
+    GenEvent evtD(run);
+    evtD.set_recycling(true);
+    evtD.add_attribute("tag", std::make_shared<IntAttribute>(7));
+    assert(evtD.attribute<IntAttribute>("tag")->value() == 7);
+    evtD.clear();
+    assert(evtD.attribute<IntAttribute>("tag")->value() == -1 && evtD.attribute_as_string("tag") == "-1");
+    assert(evtD.attribute_names().empty());
+
+    return COMPARE_ASCII_FILES("frominputRecycling_default.hepmc","frominputRecycling_recycled.hepmc");
+}
@@ -0,0 +1,112 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <cstdlib>
+#include <algorithm>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/WriterAscii.h"
+#include "HepMC3TestUtils.h"
+using namespace HepMC3;
+/* Random decay tree with particle and vertex attributes */
+static void fill_event(GenEvent& evt, const int nvertices)
+{
+    std::vector<GenParticlePtr> open;
+    for (int i = 0; i < 2; ++i) {
+        GenParticlePtr beam = std::make_shared<GenParticle>(FourVector(0.0, 0.0, (i ? -1.0 : 1.0)*7000.0, 7000.0), 2212, 4);
+        evt.add_particle(beam);
+        open.push_back(beam);
+    }
+    for (int i = 0; i < nvertices && !open.empty(); ++i) {
+        GenVertexPtr v = std::make_shared<GenVertex>(FourVector(i, i, i, i));
+        const int nin = 1 + rand()%std::min<int>(2, open.size());
+        for (int j = 0; j < nin; ++j) {
+            const size_t k = rand()%open.size();
+            v->add_particle_in(open[k]);
+            open.erase(open.begin() + k);
+        }
+        const int nout = 1 + rand()%4;
+        for (int j = 0; j < nout; ++j) {
+            GenParticlePtr p = std::make_shared<GenParticle>(FourVector(j, -j, i, i + j + 1.0), 211, 2);
+            v->add_particle_out(p);
+            open.push_back(p);
+        }
+        evt.add_vertex(v);
+    }
+    for (ConstGenParticlePtr p: evt.particles()) {
+        if (rand()%3 == 0) evt.add_attribute("tag", std::make_shared<IntAttribute>(p->id()), p->id());
+    }
+    for (ConstGenVertexPtr v: evt.vertices()) {
+        if (rand()%3 == 0) evt.add_attribute("tag", std::make_shared<IntAttribute>(v->id()), v->id());
+    }
+    evt.add_attribute("event_tag", std::make_shared<IntAttribute>(1));
+}
+int main()
+{
+    srand(12345);
+    WriterAscii outputA("fromRemove_bulk.hepmc");
+    if(outputA.failed()) return 1;
+    WriterAscii outputB("fromRemove_sequential.hepmc");
+    if(outputB.failed()) return 2;
+    for (int ievent = 0; ievent < 50; ++ievent)
+    {
+        GenEvent bulk(Units::GEV,Units::MM);
+        bulk.set_event_number(ievent);
+        fill_event(bulk, 20 + rand()%100);
+        GenEvent sequential(bulk);
+
+        /* Remove between 0 and 90% of particles, and sometimes a vertex */
+        const int fraction = ievent%10;
+        std::vector<GenParticlePtr> to_remove_bulk;
+        std::vector<GenParticlePtr> to_remove_sequential;
+        for (size_t i = 0; i < bulk.particles().size(); ++i) {
+            if (rand()%10 < fraction) {
+                to_remove_bulk.push_back(bulk.particles()[i]);
+                to_remove_sequential.push_back(sequential.particles()[i]);
+            }
+        }
+        std::vector<GenVertexPtr> vertices_bulk;
+        if (ievent%3 == 0) {
+            const size_t k = rand()%bulk.vertices().size();
+            vertices_bulk.push_back(bulk.vertices()[k]);
+            sequential.remove_vertex(sequential.vertices()[k]);
+        }
+        /* Alien particles are ignored */
+        GenEvent alien(Units::GEV,Units::MM);
+        fill_event(alien, 5);
+        to_remove_bulk.push_back(alien.particles().back());
+
+        std::vector<GenParticlePtr> old_particles = bulk.particles();
+        std::vector<GenVertexPtr> old_vertices = bulk.vertices();
+        GenEvent::IdMap ids = bulk.remove_bulk(to_remove_bulk, vertices_bulk);
+
+        std::sort(to_remove_sequential.begin(), to_remove_sequential.end(), [](const GenParticlePtr& p1, const GenParticlePtr& p2) { return p1->id() > p2->id();});
+        for (GenParticlePtr p: to_remove_sequential) sequential.remove_particle(p);
+
+        assert(bulk.particles().size() == sequential.particles().size());
+        assert(bulk.vertices().size() == sequential.vertices().size());
+        assert(alien.particles().back()->parent_event() == &alien);
+        for (size_t i = 0; i < old_particles.size(); ++i) {
+            assert(ids.particles[i] == old_particles[i]->id());
+            assert((ids.particles[i] == 0) == (old_particles[i]->parent_event() == nullptr));
+            assert(ids(i + 1) == ids.particles[i]);
+        }
+        for (size_t i = 0; i < old_vertices.size(); ++i) {
+            assert(ids.vertices[i] == old_vertices[i]->id());
+        }
+        for (ConstGenParticlePtr p: bulk.particles()) {
+            std::shared_ptr<IntAttribute> tag = p->attribute<IntAttribute>("tag");
+            if (tag) assert(ids(tag->value()) == p->id());
+        }
+        outputA.write_event(bulk);
+        outputB.write_event(sequential);
+    }
+    outputA.close();
+    outputB.close();
+    return COMPARE_ASCII_FILES("fromRemove_bulk.hepmc","fromRemove_sequential.hepmc");
+}
@@ -0,0 +1,104 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+using namespace HepMC3;
+/* Position search as done before the positions were cached */
+static FourVector reference_position(const ConstGenVertexPtr& v)
+{
+    if (v->has_set_position()) return v->position();
+    for (ConstGenParticlePtr p: v->particles_in()) {
+        ConstGenVertexPtr pv = p->production_vertex();
+        if (pv) return pv->parent_event() ? reference_position(pv) : pv->data().position;
+    }
+    return v->parent_event()->event_pos();
+}
+int main()
+{
+    GenEvent evt(Units::GEV, Units::MM);
+    evt.shift_position_to(FourVector(0.0, 0.0, 0.0, 1.0));
+    GenVertexPtr primary = std::make_shared<GenVertex>(FourVector(1.0, 2.0, 3.0, 4.0));
+    primary->add_particle_in(std::make_shared<GenParticle>(FourVector(0.0, 0.0, 1.0, 1.0), 2212, 4));
+    evt.add_vertex(primary);
+    /* Long decay chain without positions, with a displaced vertex in the middle */
+    GenVertexPtr last = primary;
+    std::vector<GenVertexPtr> chain;
+    for (int i = 0; i < 2000; ++i) {
+        GenParticlePtr p = std::make_shared<GenParticle>(FourVector(0.0, 0.0, 1.0, 1.0), 511, 2);
+        last->add_particle_out(p);
+        GenVertexPtr v = std::make_shared<GenVertex>(i == 1000 ? FourVector(5.0, 6.0, 7.0, 8.0) : FourVector());
+        v->add_particle_in(p);
+        evt.add_vertex(v);
+        chain.push_back(v);
+        last = v;
+    }
+    /* Vertex fed by a beam particle only */
+    GenVertexPtr orphan = std::make_shared<GenVertex>();
+    orphan->add_particle_in(std::make_shared<GenParticle>(FourVector(0.0, 0.0, -1.0, 1.0), 2212, 4));
+    evt.add_vertex(orphan);
+
+    evt.resolve_positions();
+    for (ConstGenVertexPtr v: evt.vertices()) assert(v->position() == reference_position(v));
+    assert(chain[999]->position() == FourVector(1.0, 2.0, 3.0, 4.0));
+    assert(chain[1500]->position() == FourVector(5.0, 6.0, 7.0, 8.0));
+    assert(orphan->position() == evt.event_pos());
+
+    /* Moving an explicit position and changing the event position are followed */
+    primary->set_position(FourVector(-1.0, -2.0, -3.0, -4.0));
+    assert(chain[10]->position() == FourVector(-1.0, -2.0, -3.0, -4.0));
+    evt.shift_position_to(FourVector(0.0, 0.0, 0.0, 2.0));
+    assert(orphan->position() == FourVector(0.0, 0.0, 0.0, 2.0));
+
+    /* Graph changes invalidate the cache */
+    chain[1000]->set_position(FourVector());
+    assert(chain[1500]->position() == primary->position());
+    GenParticlePtr cut = std::const_pointer_cast<GenParticle>(chain[500]->particles_in()[0]);
+    chain[499]->remove_particle_out(cut);
+    assert(chain[500]->position() == evt.event_pos());
+    evt.remove_vertex(chain[200]);
+    for (ConstGenVertexPtr v: evt.vertices()) assert(v->position() == reference_position(v));
+
+    /* Events flagged with cycles do not search the ancestors */
+    evt.add_attribute("cycles", std::make_shared<IntAttribute>(1));
+    assert(chain[10]->position() == evt.event_pos());
+    evt.remove_attribute("cycles");
+    assert(chain[10]->position() == primary->position());
+
+    /* Ids set explicitly, as done by the readers, do not break the lookup */
+    for (size_t i = 0; i < evt.vertices().size(); ++i) evt.vertices()[i]->set_id(-(int)(evt.vertices().size() - i));
+    for (ConstGenVertexPtr v: evt.vertices()) assert(v->position() == reference_position(v));
+    for (size_t i = 0; i < evt.vertices().size(); ++i) evt.vertices()[i]->set_id(-(int)i - 1);
+
+    /* Copies resolve their own positions */
+    GenEvent copy(evt);
+    for (size_t i = 0; i < evt.vertices().size(); ++i) assert(copy.vertices()[i]->position() == evt.vertices()[i]->position());
+    GenEvent moved(std::move(copy));
+    for (size_t i = 0; i < evt.vertices().size(); ++i) assert(moved.vertices()[i]->position() == evt.vertices()[i]->position());
+
+    /* Vertices held after clear still find their ancestors, also once the event is filled again */
+    chain[1000]->set_position(FourVector(5.0, 6.0, 7.0, 8.0));
+    evt.clear();
+    assert(chain[1500]->position() == FourVector(5.0, 6.0, 7.0, 8.0));
+    assert(chain[600]->position() == evt.event_pos());
+    for (int i = 0; i < 5; ++i) evt.add_vertex(std::make_shared<GenVertex>(FourVector(9.0, 9.0, 9.0, i)));
+    assert(chain[1]->position() == primary->position());
+    assert(chain[1500]->position() == FourVector(5.0, 6.0, 7.0, 8.0));
+
+    /* The same after a recycling clear, where the held vertex is skipped */
+    GenEvent recycled;
+    recycled.set_recycling(true);
+    GenVertexPtr kept = std::make_shared<GenVertex>();
+    kept->add_particle_in(std::make_shared<GenParticle>(FourVector(0.0, 0.0, 1.0, 1.0), 11, 4));
+    recycled.add_vertex(std::make_shared<GenVertex>(FourVector(1.0, 1.0, 1.0, 1.0)));
+    recycled.add_vertex(kept);
+    recycled.clear();
+    for (int i = 0; i < 5; ++i) recycled.add_vertex(std::make_shared<GenVertex>(FourVector(2.0, 2.0, 2.0, i)));
+    assert(kept->parent_event() == &recycled && kept->position() == recycled.event_pos());
+    return 0;
+}
@@ -0,0 +1,55 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <string>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenRunInfo.h"
+#include "HepMC3/WeightHandle.h"
+using namespace HepMC3;
+int main()
+{
+    std::shared_ptr<GenRunInfo> run = std::make_shared<GenRunInfo>();
+    std::vector<std::string> names;
+    for (int i = 0; i < 1000; ++i) names.push_back("PDF" + std::to_string(i));
+    names.push_back("MUR2_MUF1");
+    run->set_weight_names(names);
+    GenEvent evt(run);
+    for (size_t i = 0; i < evt.weights().size(); ++i) evt.weights()[i] = 0.5*i;
+
+    WeightHandle mur(*run, "MUR2_MUF1");
+    assert(mur.valid() && mur.valid_for(evt));
+    assert(mur(evt) == evt.weight("MUR2_MUF1"));
+    mur(evt) = 3.0;
+    assert(evt.weight("MUR2_MUF1") == 3.0);
+    assert(!WeightHandle(*run, "missing").valid());
+    assert(!WeightHandle().valid_for(evt));
+
+    WeightSet some(*run, std::vector<std::string>({"PDF7", "missing", "PDF3"}));
+    assert(some.size() == 2 && some.names()[1] == "PDF3" && some.valid_for(evt));
+    std::vector<double> out;
+    some.gather(evt, out);
+    assert(out.size() == 2 && out[0] == evt.weight("PDF7") && out[1] == evt.weight("PDF3"));
+    assert(some(evt, 1) == out[1]);
+
+    WeightSet pdfs = WeightSet::matching(*run, "PDF[0-9]+");
+    assert(pdfs.size() == 1000);
+    double buffer[1000];
+    pdfs.gather(evt, buffer);
+    for (size_t i = 0; i < 1000; ++i) assert(buffer[i] == evt.weights()[i]);
+    assert(WeightSet::matching(*run, "(").empty());
+
+    /* Cached handles are rejected once the weight names change or for another run */
+    std::shared_ptr<GenRunInfo> other = std::make_shared<GenRunInfo>(*run);
+    assert(!mur.valid_for(*other));
+    run->set_weight_names(std::vector<std::string>({"MUR2_MUF1"}));
+    assert(!mur.valid_for(evt) && !pdfs.valid_for(evt));
+    GenEvent short_event(other);
+    short_event.weights().resize(10);
+    assert(!WeightHandle(*other, "MUR2_MUF1").valid_for(short_event));
+    assert(!pdfs.valid_for(short_event));
+    return 0;
+}
@@ -0,0 +1,106 @@
+// -*- C++ -*-
+//
+// This file is part of HepMC
+// Copyright (C) 2014-2023 The HepMC collaboration (see AUTHORS for details)
+//
+#undef NDEBUG
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenParticle.h"
+#include "HepMC3/GenVertex.h"
+#include "HepMC3/ReaderAscii.h"
+#include "HepMC3/WriterAscii.h"
+#include "HepMC3TestUtils.h"
+#include "Timer.h"
+using namespace HepMC3;
+static void fill(GenEvent& evt, const int n)
+{
+    std::vector<GenParticlePtr> in, out;
+    in.push_back(evt.make_particle(FourVector(0.0, 0.0, 6500.0, 6500.0), 2212, 4));
+    in.push_back(evt.make_particle(FourVector(-0.0, 0.0, -6500.0, 6500.0), 2212, 4));
+    for (int i = 0; i < 60; ++i) {
+        const double x = std::sin(1.0 + n + 0.37*i)*std::pow(10.0, i%9 - 4);
+        out.push_back(evt.make_particle(FourVector(x, -x/3.0, 1.0/(i + n + 1.0), std::fabs(x) + 1e-3*i), 211 - 2*(i%2)*211, 1));
+        out.back()->set_generated_mass(i%3 ? 0.13957039 : 0.0);
+    }
+    evt.add_vertex(in, out, FourVector(1e-12*n, -0.5, 1.0/3.0, 0.0));
+    evt.set_event_number(n);
+    evt.weights() = std::vector<double>({1.0, 1.0/(n + 3.0), -2.5e-30});
+}
+/* The output of WriterAscii before the numbers were formatted in the writer, for the events of fill */
+static void write_reference(const std::string& filename, const std::vector<GenEvent>& events, const int precision, const std::string& letter)
+{
+    const std::string f = " %." + std::to_string(precision) + letter;
+    const std::string particle = "P %i %i %i" + f + f + f + f + f + " %i\n";
+    const std::string vertex = "V %i %i [%s] @" + f + f + f + f + "\n";
+    FILE* file = fopen(filename.c_str(), "w");
+    fprintf(file, "HepMC::Asciiv3-START_EVENT_LISTING\nW a\\|b\\|c\n");
+    for (const GenEvent& evt: events) {
+        fprintf(file, "E %i %zu %zu\nU GEV MM\nW", evt.event_number(), evt.vertices().size(), evt.particles().size());
+        for (const double w: evt.weights()) fprintf(file, " %.*e", std::min(3*precision, 22), w);
+        fprintf(file, "\n");
+        for (ConstGenParticlePtr p: evt.particles()) {
+            /* The beams come from the root vertex, with id 0 */
+            ConstGenVertexPtr v = p->production_vertex();
+            if (v && v->id() < 0 && p == v->particles_out().front()) {
+                const FourVector& pos = v->position();
+                fprintf(file, vertex.c_str(), v->id(), v->status(), "1,2", pos.x(), pos.y(), pos.z(), pos.t());
+            }
+            const FourVector& m = p->momentum();
+            fprintf(file, particle.c_str(), p->id(), v ? v->id() : 0, p->pid(), m.px(), m.py(), m.pz(), m.e(), p->generated_mass(), p->status());
+        }
+    }
+    fprintf(file, "HepMC::Asciiv3-END_EVENT_LISTING\n\n");
+    fclose(file);
+}
+int main()
+{
+    std::shared_ptr<GenRunInfo> run = std::make_shared<GenRunInfo>();
+    run->set_weight_names(std::vector<std::string>({"a", "b", "c"}));
+    std::vector<GenEvent> events;
+    for (int i = 0; i < 400; ++i) {
+        events.push_back(GenEvent(run));
+        fill(events.back(), i);
+    }
+
+    /* Same output as printf for all formats */
+    Timer writer("WriterAscii");
+    Timer reference("fprintf");
+    for (const std::string letter: {"e", "E", "f", "F", "g", "G"}) {
+        for (const int precision: {2, 8, 16, 24}) {
+            const std::string name = "testWriteFormat_" + letter + std::to_string(precision);
+            writer.start();
+            WriterAscii output(name + ".hepmc", run);
+            output.set_options({{"float_printf_specifier", letter}});
+            output.set_precision(precision);
+            for (const GenEvent& evt: events) output.write_event(evt);
+            output.close();
+            writer.stop();
+            reference.start();
+            write_reference(name + "_reference.hepmc", events, precision, letter);
+            reference.stop();
+            if (COMPARE_ASCII_FILES(name + ".hepmc", name + "_reference.hepmc") != 0) return 1;
+        }
+    }
+    writer.print();
+    reference.print();
+
+    /* The shortest representation reads back to the same numbers */
+    WriterAscii output("testWriteFormat_shortest.hepmc", run);
+    output.set_options({{"float_printf_specifier", "shortest"}});
+    for (const GenEvent& evt: events) output.write_event(evt);
+    output.close();
+    ReaderAscii input("testWriteFormat_shortest.hepmc");
+    GenEvent evt;
+    for (const GenEvent& source: events) {
+        input.read_event(evt);
+        assert(!input.failed() && equivalent(evt, source));
+        assert(evt.particles()[5]->momentum().px() == source.particles()[5]->momentum().px());
+        assert(evt.vertices()[0]->position().z() == 1.0/3.0);
+    }
+    input.close();
+    return 0;
+}